@@ -15,6 +15,8 @@
 #pragma once
 #include <cascade/Cascade.hpp>
 #include "smem/MemTypes.hpp"
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace smem {
@@ -27,18 +29,37 @@ public:
   FifoInput (MemReq,  s_req);  // s_req input port
   FifoOutput(MemResp, s_resp); // s_resp output port
   void set_latency(int v); // Set DRAM latency in cycles. Applies to next accepted req (in-flight unaffected).
+  void set_size(uint64_t bytes); // Resize the DRAM window (rounded up to a page); drops all contents. Default 256MB.
+
+  // Backing store is sparse: 4KB pages are allocated on first write (or write direct_ptr), untouched pages read zero.
+  static constexpr uint64_t kPageBytes = 4096;
+  static constexpr uint64_t kDefaultSize = 256ull * 1024 * 1024;
 
   // HAL/test helpers
   uint64_t get_base() const { return base_addr_; }
-  uint64_t get_size() const { return mem_.size(); }
+  uint64_t get_size() const { return size_; }
+  uint64_t resident_pages() const { return resident_pages_; } // pages actually backed by host memory
+  const uint8_t* page_data(uint64_t page_idx) const {        // nullptr if the page was never written
+    return page_idx < pages_.size() ? pages_[page_idx].get() : nullptr;
+  }
+  uint8_t* page_for_write(uint64_t page_idx);                 // allocate (zeroed) on first touch; idx < get_size()/kPageBytes
   // methods for HAL to call
   void* alloc(uint64_t bytes);
   void  write(uint64_t addr, const void* src, uint64_t bytes);
   void  read(uint64_t addr, void* dst, uint64_t bytes);
+  // Direct host pointer to backing storage at addr (nullptr if outside); *avail = bytes to the end of
+  // addr's page.  write: the page gets allocated; otherwise an untouched page gives nullptr (it reads
+  // zero) and stays unallocated.  Bypasses tracing; for untimed users via DramMemoryPort::get_direct().
+  uint8_t* direct_ptr(uint64_t addr, uint64_t* avail, bool write);
 
 private:
-  std::vector<char> mem_;  // storage for simulated DRAM, C++ vector of characters (bytes)
-  static constexpr uint64_t base_addr_ = 0x80000000ull; // base address mapped to mem_[0]
+  std::vector<std::unique_ptr<uint8_t[]>> pages_; // sparse storage for simulated DRAM, one slot per 4KB page
+  uint64_t size_ = 0;                             // DRAM window size in bytes (multiple of kPageBytes)
+  uint64_t resident_pages_ = 0;
+  static constexpr uint64_t base_addr_ = 0x80000000ull; // base address mapped to offset 0
+
+  void copy_in(uint64_t off, const void* src, uint64_t bytes); // caller has bounds-checked off/bytes
+  void copy_out(uint64_t off, void* dst, uint64_t bytes) const;
   u64 next_addr_ = 0;      // counter to keep track of next available memory address
   int latency_ = 0;
 
@@ -29,11 +29,23 @@ public:
   bool resp_valid() const override;
   uint32_t resp_data() const override;
   void resp_consume() override;
+  bool supports_line_reads() const override { return true; }
+  void request_read_line(uint32_t addr, uint32_t bytes) override;
+  const uint32_t* resp_line() const override { return line_; }
+  bool supports_tags() const override { return true; }
+  void request_read32_tagged(uint32_t addr, uint32_t tag) override;
+  void request_write32_tagged(uint32_t addr, uint32_t value, uint32_t tag) override;
+  uint32_t resp_tag() const override { return resp_tag_; }
+  bool supports_byte_writes() const override { return true; }
+  void request_write_bytes_tagged(uint32_t addr, uint32_t value, uint32_t bytes, uint32_t tag) override;
+  bool get_direct(uint32_t addr, DirectRegion* out, bool write = false) override; // one DRAM page at a time; reads never commit one
 
 private:
   Dram& dram_;
   bool resp_valid_ = false;
   uint32_t resp_data_ = 0;
+  uint32_t resp_tag_ = 0;
+  uint32_t line_[MemoryPort::kMaxLineBytes / 4] = {};
 };
 
 } // namespace smem
@@ -0,0 +1,104 @@
+// **********************************************************************
+// smem/include/smem/DramTiming.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Bank/row-buffer DRAM timing model.  Not a component: the controller in front
+of the storage (MemCtrl, MemCtrlTimedPort) asks it when each access it sends
+would finish, and holds the response until then.  Dram stays zero-latency
+storage.
+
+- Geometry: channels x ranks x banks, each bank with one row buffer of
+  page_bytes.  An address splits into row/rank/bank/channel/column fields in
+  the order given by Config::map (most significant first); column holds the
+  byte offset within the page.
+- Per access (controller cycles):
+    hit      (open page, row already open):  CAS
+    miss     (bank precharged):              ACT, tRCD, CAS
+    conflict (another row open):             PRE (>= ACT + tRAS, >= write + tWR), tRP, ACT, tRCD, CAS
+  then tCAS to the first data beat and tBURST per burst_bytes of data on the
+  channel's data bus, which serves one access at a time in the order they were
+  scheduled.  A bank takes its next column command once the data has left it.
+- Closed page: every access precharges its bank afterwards (auto-precharge),
+  so accesses are all misses but never conflicts.
+- Stats: row hits/misses/conflicts, data bus busy cycles, and per requester
+  (MemReq::src) accesses, bytes, latency and achieved bandwidth over the span
+  from its first request to its last data.
+*/
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace smem {
+
+class DramTiming {
+public:
+  enum class Field : uint8_t { Row, Rank, Bank, Channel, Col };
+  enum class Outcome : uint8_t { Hit, Miss, Conflict };
+  static constexpr uint32_t kMaxRequesters = 4; // MemReq::src values (see MemTypes.hpp)
+
+  struct Config {
+    uint32_t channels    = 1;
+    uint32_t ranks       = 1;
+    uint32_t banks       = 8;
+    uint32_t row_bits    = 16;
+    uint32_t page_bytes  = 2048;  // row buffer per bank
+    uint32_t burst_bytes = 64;    // data moved per tBURST
+    bool     open_page   = true;
+    uint32_t tRCD = 14, tCAS = 14, tRP = 14, tRAS = 34, tWR = 15, tBURST = 4;
+    std::array<Field, 5> map{{Field::Row, Field::Rank, Field::Bank, Field::Channel, Field::Col}}; // MSB..LSB
+  };
+  // "key=value,..." over the defaults: ch, rank, bank, row_bits, page, burst, policy=open|closed,
+  // map=row:bank:col (fields MSB first; rank/ch left out go just above col, ch lowest),
+  // trcd, tcas, trp, tras, twr, tburst.  "on" or "default" = the defaults.
+  static bool parse_config(const std::string& spec, Config* out, std::string* err);
+
+  struct RequesterStats {
+    uint64_t reads = 0, writes = 0, bytes = 0;
+    uint64_t lat_sum = 0;             // schedule -> last data, summed
+    uint64_t first = 0, last = 0;     // first schedule cycle, last data cycle
+    double bytes_per_cycle() const { return last > first ? static_cast<double>(bytes) / static_cast<double>(last - first) : 0.0; }
+  };
+
+  explicit DramTiming(const Config& cfg);
+
+  // Schedule an access at cycle `now`; returns the cycle its last data beat is done.
+  uint64_t access(uint64_t addr, uint32_t bytes, bool write, uint64_t now, uint32_t src);
+  Outcome  classify(uint64_t addr) const;             // what access() would see at this bank right now
+  uint64_t bank_ready(uint64_t addr) const;           // earliest cycle its bank takes a new command
+  void     reset();                                   // all banks precharged, stats cleared
+  void     print_stats(uint64_t cycles) const;        // [DRAMT] lines; cycles = run length for bus utilisation
+
+  const Config& config() const { return cfg_; }
+  uint32_t num_banks() const { return static_cast<uint32_t>(banks_.size()); } // channels * ranks * banks
+  uint64_t row_hits()      const { return hits_; }
+  uint64_t row_misses()    const { return misses_; }
+  uint64_t row_conflicts() const { return conflicts_; }
+  uint64_t bus_busy()      const { return bus_busy_; }  // data bus cycles, all channels
+  const RequesterStats& requester(uint32_t src) const { return req_[src < kMaxRequesters ? src : kMaxRequesters - 1]; }
+
+private:
+  struct Bank {
+    bool     open = false;
+    uint64_t row = 0;
+    uint64_t ready = 0;   // next column/precharge command
+    uint64_t act = 0;     // last ACT (tRAS)
+    uint64_t wr_end = 0;  // end of the last write data (tWR)
+  };
+  struct Loc { uint32_t bank; uint32_t channel; uint64_t row; };
+  Loc decode(uint64_t addr) const;
+
+  Config cfg_;
+  std::array<uint32_t, 5> shift_{};  // by Field
+  std::array<uint64_t, 5> mask_{};
+  std::vector<Bank>     banks_;
+  std::vector<uint64_t> bus_free_;   // per channel
+  uint64_t hits_ = 0, misses_ = 0, conflicts_ = 0, bus_busy_ = 0;
+  std::array<RequesterStats, kMaxRequesters> req_{};
+};
+
+} // namespace smem
@@ -5,11 +5,50 @@
 /*
   --> in_core_req   -> update_issue()  ->  s_req -->
   <-- out_core_resp <- update_retire() <- s_resp <--
+
+With set_dram_timing() each queued request is held for latency_ (controller
+front end) plus whatever DramTiming says its bank and data bus need, instead
+of latency_ alone.
+
+set_scheduler() picks how queued requests go to DRAM:
+- Fifo (default): strict arrival order, one new request per cycle, no bound.
+- FrFcfs: a bounded transaction queue (depth) taking up to `accept` requests
+  per cycle.  Once a request's front-end latency is up it may be picked; among
+  those, reads go first unless the queued writes reach wr_hi (then writes drain
+  until wr_lo), and within that, among requests whose bank can take a command,
+  row hits go first, then the oldest.  A request never passes an older one to an overlapping
+  address if either is a write.  Switching the bus between reads and writes
+  costs `turnaround` cycles, and picks start in pick order, so nothing picked
+  later starts before that either.  DRAM access time is booked when a request is
+  picked, and it goes to Dram once its data is done, so responses come back out
+  of order; requesters match them by MemReq::id.  Without DRAM timing there
+  are no rows or banks and picks fall back to the oldest eligible request.
+
+Stores may be any size and alignment up to kMaxBurstBytes, with byte enables
+(MemReq::be).  Pending stores are tracked per 8-byte beat as a byte mask plus
+the merged data (youngest wins), so a load whose every byte some pending store
+wrote is answered at once, whatever its alignment; a load that only partly
+overlaps them queues behind them instead.
+
+set_write_combining() (posted writes only) folds a new store into the youngest
+queued, not yet issued store when both fall in one kMaxBurstBytes-aligned
+block and no request queued after that store touches the new bytes: its range
+grows to cover both, the bytes neither wrote stay disabled, and DRAM sees one
+write instead of two.  Only the last kCombineWindow queued requests are
+searched.  Fifo has already booked DRAM time for the store at its old size;
+FrFcfs books the merged size when it picks it.
 */
 
 #pragma once
 #include <cascade/Cascade.hpp>
 #include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "smem/DramTiming.hpp"
 #include "smem/MemTypes.hpp"
 
 namespace smem {
@@ -35,16 +74,81 @@ public:
   // Fence helper: returns true when no pending stores remain in the pipeline
   bool writes_empty() const;
   void set_posted_writes(bool en) { posted_writes_ = en; }
+  void set_write_combining(bool en) { wc_ = en; }  // merge posted stores into a queued one (see above)
+  bool write_combining() const { return wc_; }
+  void print_store_stats() const;  // [MCSTORE] line: stores taken, combined, written to DRAM, loads forwarded
+  uint64_t combined_stores() const { return combined_; }
+  uint64_t loads_forwarded() const { return load_fwd_; }
 
   void set_latency(int v) { if (v < 0) v = 0; latency_ = v; trace("mem: latency=%d", latency_); }
+  void set_dram_timing(const DramTiming::Config& cfg);                // bank/row-buffer timing on top of latency_
+  const DramTiming* dram_timing() const { return timing_.get(); }     // nullptr = fixed latency only
+  uint64_t cycles() const { return now_; }
+
+  enum class Sched : uint8_t { Fifo, FrFcfs };
+  struct SchedConfig {
+    Sched    policy     = Sched::Fifo;
+    uint32_t depth      = 16;  // FrFcfs: transaction queue entries (posted stores included)
+    uint32_t accept     = 1;   // FrFcfs: new requests taken per cycle
+    uint32_t wr_hi      = 12;  // FrFcfs: start draining writes at this many queued
+    uint32_t wr_lo      = 4;   // FrFcfs: stop draining at this many
+    uint32_t turnaround = 0;   // FrFcfs: cycles to switch the data bus read <-> write
+  };
+  // "fifo", or "frfcfs[,depth=N][,accept=N][,wr_hi=N][,wr_lo=N][,turnaround=N]"
+  static bool parse_sched(const std::string& spec, SchedConfig* out, std::string* err);
+  void set_scheduler(const SchedConfig& cfg);
+  const SchedConfig& scheduler() const { return sched_; }
+  void print_sched_stats() const;  // [MCSCHED] line (FrFcfs)
+  uint64_t sched_picks() const { return picks_; }
+  uint64_t sched_reorders() const { return reorders_; }  // picks that went ahead of an older request
 
 private:
-  struct Q { MemReq r; int cnt; };
-  std::deque<Q> pipe_; // pipeline stages to model latency
+  struct Q {
+    MemReq   r;
+    uint64_t ready;          // Fifo: cycle it may go to DRAM; FrFcfs: front-end latency up, may be picked
+    uint64_t seq;            // arrival order
+  };
+  struct Inflight {          // FrFcfs: picked, DRAM access booked
+    uint64_t done;           // cycle its data is done (then it goes to Dram)
+    uint64_t seq;
+    MemReq   r;
+    bool operator>(const Inflight& o) const { return done != o.done ? done > o.done : seq > o.seq; }
+  };
+  struct StoreLine {         // pending STOREs touching one 8-byte beat
+    uint32_t count = 0;
+    uint8_t  mask = 0;       // bytes they write ...
+    uint64_t data = 0;       // ... and what DRAM ends up with there (youngest wins)
+  };
+  static constexpr size_t kCombineWindow = 8; // queued requests searched for a store to combine with
+  std::deque<Q> pipe_; // queued requests in arrival order (FrFcfs: not yet picked)
+  std::priority_queue<Inflight, std::vector<Inflight>, std::greater<Inflight>> inflight_; // min-heap by done
+  std::unordered_map<uint64_t, StoreLine> store_lines_; // addr >> 3 -> pending STOREs there
+  uint32_t pending_writes_ = 0;
+  uint64_t seq_ = 0;
   int latency_ = 0;
+  std::unique_ptr<DramTiming> timing_;
+  uint64_t now_ = 0;   // update_issue() ticks
+  int hold_cycles(const MemReq& r);       // queue countdown for a new request (schedules its DRAM access)
+  bool accept_core_req();                 // step 3 of update_issue(); false if nothing was taken
+  void enqueue(const MemReq& r);
+  void add_store(const MemReq& r);  // store_lines_ upkeep
+  void drop_store(const MemReq& r);
+  void merge_store_bytes(const MemReq& r);
+  bool combine_store(const MemReq& r);    // write combining; false = queue it as its own request
+  void issue_frfcfs();                    // FrFcfs steps 1-2: release done requests, pick the next one
+  int  pick_frfcfs() const;               // pipe_ index to book next, -1 = none
+  bool blocked_by_older(size_t i) const;  // an older unpicked request to the same bytes must go first
+  SchedConfig sched_;
+  bool     draining_ = false;
+  bool     last_write_ = false;           // data bus direction of the last pick
+  uint64_t bus_free_ = 0;                // cycle the last pick started (after any turnaround): picks start in order
+  uint32_t queued_writes_ = 0;            // unpicked writes in pipe_
+  uint64_t picks_ = 0, reorders_ = 0, hit_picks_ = 0, drains_ = 0, turnarounds_ = 0, full_stalls_ = 0;
   // helpers
-  bool find_pending_store(u64 addr, u16 size, u64 &val) const;
+  bool find_pending_store(const MemReq& r, MemResp& out, bool& fwd) const;
   bool posted_writes_ = true; // if false, ack store when it drains to DRAM
+  bool wc_ = false;           // write combining
+  uint64_t stores_ = 0, combined_ = 0, drained_ = 0, load_fwd_ = 0, load_partial_ = 0;
 };
 
 } // namespace smem
@@ -5,12 +5,23 @@
 /*
 Tiny fake memory controller that sits in front of existing MemoryPort.
 Forces each read/write to take fixed number of cycles before a response appears.
+Line reads take the same fixed latency as a word (the whole line arrives at once).
+Up to max_outstanding requests (default 1) may be in flight; each still takes
+the fixed latency, so responses come back in request order, tags attached.
+With set_dram_timing() a request instead waits latency (front end) plus the
+bank/row-buffer and data bus time DramTiming schedules for it; responses still
+leave in request order.
+Byte writes (SB/SH) are one timed request; the port merges them into the
+backing word when they land.
 Also supports immediate read32/write32 passthrough for loader/debugger/accel use
 (i.e., if you call read32/write32 directly, it just forwards to the backing port with no delay). 
 */
 
 #pragma once
 
+#include <memory>
+
+#include "smem/DramTiming.hpp"
 #include "smem/MemoryPort.hpp"
 
 namespace smem {
@@ -20,10 +31,15 @@ public:
   MemCtrlTimedPort(MemoryPort* backing, int latency_cycles); // constructor takes pointer to backing port and fixed latency in cycles
 
   void set_latency(int v);
+  void set_max_outstanding(uint32_t n); // 1..kMaxOutstanding, counts queued responses too
+  void set_dram_timing(const DramTiming::Config& cfg);            // bank/row-buffer timing on top of the latency
+  const DramTiming* dram_timing() const { return timing_.get(); } // nullptr = fixed latency only
+  uint64_t cycles() const { return now_; }
 
   // Immediate compatibility path (loader/debugger/accels).
   uint32_t read32(uint32_t addr) override;
   void write32(uint32_t addr, uint32_t value) override;
+  bool get_direct(uint32_t addr, DirectRegion* out, bool write = false) override; // same untimed passthrough as read32/write32
 
   // Timed request/response path.
   void cycle() override;
@@ -33,17 +49,47 @@ public:
   bool resp_valid() const override;
   uint32_t resp_data() const override;
   void resp_consume() override;
+  bool supports_line_reads() const override { return true; }
+  void request_read_line(uint32_t addr, uint32_t bytes) override;
+  const uint32_t* resp_line() const override { return resps_[resp_head_].line; }
+  bool supports_tags() const override { return true; }
+  uint32_t max_outstanding() const override { return max_outstanding_; }
+  void request_read32_tagged(uint32_t addr, uint32_t tag) override;
+  void request_write32_tagged(uint32_t addr, uint32_t value, uint32_t tag) override;
+  uint32_t resp_tag() const override { return resps_[resp_head_].tag; }
+  bool supports_byte_writes() const override { return true; }
+  void request_write_bytes_tagged(uint32_t addr, uint32_t value, uint32_t bytes, uint32_t tag) override;
+
+  static constexpr uint32_t kMaxOutstanding = 16;
 
 private:
+  struct Req {
+    bool is_write = false;
+    uint32_t addr = 0;
+    uint32_t wdata = 0;
+    uint32_t bytes = 4;       // write: 1/2/4 at addr
+    uint32_t tag = 0;
+    uint32_t line_words = 0;  // > 0: line read
+    int cnt = 0;              // cycles left
+  };
+  struct Resp {
+    uint32_t data = 0;
+    uint32_t tag = 0;
+    uint32_t line[MemoryPort::kMaxLineBytes / 4] = {};
+  };
+  void issue(const Req& r);
+
   MemoryPort* backing_ = nullptr;
   int latency_ = 0;
-  bool in_flight_ = false;
-  bool is_write_ = false;
-  uint32_t req_addr_ = 0;
-  uint32_t req_wdata_ = 0;
-  int cnt_ = 0;
-  bool resp_valid_ = false;
-  uint32_t resp_data_ = 0;
+  uint32_t max_outstanding_ = 1;
+  std::unique_ptr<DramTiming> timing_;
+  uint64_t now_ = 0;                 // cycle() calls
+  Req reqs_[kMaxOutstanding] = {};   // ring of in-flight requests, oldest at req_head_
+  uint32_t req_head_ = 0;
+  uint32_t req_count_ = 0;
+  Resp resps_[kMaxOutstanding] = {}; // ring of responses not yet consumed
+  uint32_t resp_head_ = 0;
+  uint32_t resp_count_ = 0;
 };
 
 } // namespace smem
@@ -0,0 +1,95 @@
+// **********************************************************************
+// smem/include/smem/MemTrace.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Compact binary instruction/memory trace: one record per retired instruction
+(pc, instruction class, and for loads/stores the byte address and size).
+Written by a core (Tile1::attach_trace_writer) and read back by TraceReplay,
+which drives MemCtrl/Dram from it without re-running the core.
+
+File = zlib (gzip) stream of:
+  header  "SMTR" + u32 version (little endian)
+  records byte 0: bits 0..3 Kind, bit 4 = sequential pc (prev pc + 4),
+                  bits 5..6 log2(size) for Load/Store
+          then    zigzag varint (pc - (prev pc + 4))   if not sequential
+          then    zigzag varint (addr - prev mem addr)  if Load/Store
+A straight-line ALU instruction is one byte before compression; strided
+accesses delta-encode to one or two.  Writer and reader both buffer 64KB.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace smem {
+
+class MemTrace {
+public:
+  enum class Kind : uint8_t { Alu = 0, Mul, Load, Store, Branch, Jump, Simd, Custom, System, Other };
+
+  struct Rec {
+    uint32_t pc   = 0;
+    Kind     kind = Kind::Alu;
+    uint8_t  size = 0; // bytes (1/2/4), Load/Store only
+    uint32_t addr = 0; // Load/Store only
+  };
+
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t   kBufBytes = 64 * 1024;
+
+  static bool is_mem(Kind k) { return k == Kind::Load || k == Kind::Store; }
+  static const char* kind_name(Kind k);
+};
+
+class MemTraceWriter {
+public:
+  MemTraceWriter() = default;
+  ~MemTraceWriter() { close(); }
+  MemTraceWriter(const MemTraceWriter&) = delete;
+  MemTraceWriter& operator=(const MemTraceWriter&) = delete;
+
+  bool open(const std::string& path, std::string* err); // truncates; fast zlib level
+  bool is_open() const { return gz_ != nullptr; }
+  void record(uint32_t pc, MemTrace::Kind kind, uint32_t addr = 0, uint8_t size = 0);
+  void close();                                          // flush + finish the stream (idempotent)
+
+  uint64_t records()    const { return records_; }
+  uint64_t mem_records() const { return mem_records_; }
+  uint64_t raw_bytes()  const { return raw_bytes_; }  // encoded bytes before compression
+  uint64_t file_bytes() const { return file_bytes_; } // valid after close()
+
+private:
+  void flush();
+  void put_varint(int32_t v);
+
+  void*    gz_ = nullptr; // gzFile (kept opaque so users need not include zlib.h)
+  std::vector<uint8_t> buf_;
+  uint32_t prev_pc_ = 0, prev_addr_ = 0;
+  uint64_t records_ = 0, mem_records_ = 0, raw_bytes_ = 0, file_bytes_ = 0;
+};
+
+class MemTraceReader {
+public:
+  MemTraceReader() = default;
+  ~MemTraceReader() { close(); }
+  MemTraceReader(const MemTraceReader&) = delete;
+  MemTraceReader& operator=(const MemTraceReader&) = delete;
+
+  bool open(const std::string& path, std::string* err); // checks the header
+  bool next(MemTrace::Rec* out);                         // false at end of trace
+  void close();
+
+private:
+  bool get_byte(uint8_t* b);
+  bool get_varint(int32_t* v);
+
+  void*    gz_ = nullptr;
+  std::vector<uint8_t> buf_;
+  size_t   pos_ = 0, len_ = 0;
+  uint32_t prev_pc_ = 0, prev_addr_ = 0;
+};
+
+} // namespace smem
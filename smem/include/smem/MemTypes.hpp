@@ -4,25 +4,72 @@
 // Sebastian Claudiusz Magierowski Aug 16 2025
 /*
 Minimal memory request/response packet types (FIFO-friendly).  MemReq is a mem request ("read/write this addr"), and MemResp is mem response ("here's the read data or here's the store ack").  They travel through Cascade FIFO ports.
+
+Bursts: an op covers `size` bytes from `addr` (up to kMaxBurstBytes).  Byte i of
+the op lives in beat i/8, lane i%8 (little-endian); beat 0 is wdata/rdata, the
+rest wbeat[]/rbeat[].  Ops of 8 bytes or less are the single beat they always
+were.  Writes only store the bytes whose bit is set in `be` (bit i = byte i).
 */
 
 #pragma once
 #include <cascade/Cascade.hpp>
+#include <cstdint>
 
 namespace smem {
 
+constexpr uint32_t kBeatBytes     = 8;
+constexpr uint32_t kMaxBurstBytes = 64;                           // one cache line, or a smesh row of kDim=16 accumulators
+constexpr uint32_t kMaxBeats      = kMaxBurstBytes / kBeatBytes;
+
 struct MemReq {
   u64  addr  = 0;     // byte address
-  u64  wdata = 0;     // write data (single beat for now)
-  u16  size  = 8;     // bytes covered by memory op
+  u64  wdata = 0;     // write data, beat 0 (all of it for ops of <= 8 bytes)
+  u16  size  = 8;     // bytes covered by memory op (1..kMaxBurstBytes)
   bit  write = false; // write=1 store, write=0 load
   u16  id    = 0;     // transaction id (requester can label so response can be matched to req)
+  u8   src   = 0;     // requester, for per-requester stats (MemSrc)
+  u64  be    = 0xffffffffffffffffull; // write byte enables, bit i = byte i of the op (default: all)
+  u64  wbeat[kMaxBeats - 1] = {};     // write data, beats 1.. of a burst
+
+  uint32_t beats() const { const uint32_t n = (uint32_t)(u16)size; return n > kBeatBytes ? (n + kBeatBytes - 1u) / kBeatBytes : 1u; }
+  uint64_t wbeat_at(uint32_t i) const { return i == 0 ? (uint64_t)wdata : (uint64_t)wbeat[i - 1]; }
+  void     set_wbeat(uint32_t i, uint64_t v) { if (i == 0) wdata = v; else wbeat[i - 1] = v; }
+  uint8_t  wbyte(uint32_t i) const { return (uint8_t)(wbeat_at(i / kBeatBytes) >> (8u * (i % kBeatBytes))); }
+  void     set_wbyte(uint32_t i, uint8_t v) {
+    const uint32_t sh = 8u * (i % kBeatBytes);
+    set_wbeat(i / kBeatBytes, (wbeat_at(i / kBeatBytes) & ~(0xffull << sh)) | ((uint64_t)v << sh));
+  }
+  bool     byte_en(uint32_t i) const { return (((uint64_t)be >> i) & 1ull) != 0; }
 };
 
+// MemReq::src values (DramTiming keeps stats for each)
+enum MemSrc : uint8_t { kSrcCore = 0, kSrcAccel = 1, kSrcDma = 2, kSrcOther = 3 };
+
 struct MemResp {
-  u64  rdata = 0;   // read data (single beat for now)
+  u64  rdata = 0;   // read data, beat 0
   u16  id    = 0;   // transaction id
   u8   err   = 0;   // 0=OK, nonzero=error code
+  u64  rbeat[kMaxBeats - 1] = {}; // read data, beats 1.. of a burst
+
+  uint64_t rbeat_at(uint32_t i) const { return i == 0 ? (uint64_t)rdata : (uint64_t)rbeat[i - 1]; }
+  void     set_rbeat(uint32_t i, uint64_t v) { if (i == 0) rdata = v; else rbeat[i - 1] = v; }
+  uint8_t  rbyte(uint32_t i) const { return (uint8_t)(rbeat_at(i / kBeatBytes) >> (8u * (i % kBeatBytes))); }
+  void     set_rbyte(uint32_t i, uint8_t v) {
+    const uint32_t sh = 8u * (i % kBeatBytes);
+    set_rbeat(i / kBeatBytes, (rbeat_at(i / kBeatBytes) & ~(0xffull << sh)) | ((uint64_t)v << sh));
+  }
 };
 
+// pack/unpack bytes <-> beats (n <= kMaxBurstBytes)
+inline void set_wbytes(MemReq& r, const uint8_t* src, uint32_t n) {
+  for (uint32_t b = 0; b * kBeatBytes < n; ++b) {
+    uint64_t v = 0;
+    for (uint32_t k = 0; k < kBeatBytes && b * kBeatBytes + k < n; ++k) v |= (uint64_t)src[b * kBeatBytes + k] << (8u * k);
+    r.set_wbeat(b, v);
+  }
+}
+inline void get_rbytes(const MemResp& r, uint8_t* dst, uint32_t n) {
+  for (uint32_t i = 0; i < n; ++i) dst[i] = r.rbyte(i);
+}
+
 } // namespace smem
@@ -5,13 +5,50 @@
 /*
 Lightweight software memory-port protocol used by Tile1, memory adapters,
 debug tools, and accelerators. This is not a Cascade component by itself.
+
+Direct memory interface (TLM-style DMI): get_direct() may hand out a host
+pointer aliasing a range of port addresses so untimed users can skip the
+virtual read32/write32 path.  Ports whose accesses have side effects (or that
+do not know) refuse; DirectAccessor caches one grant/refusal and falls back
+to read32/write32 on its own.  A read grant (write=false) must not commit
+backing storage: a sparse port refuses an untouched range with `untouched`
+set (it reads zero through read32), and only a write grant commits it.
+
+Line reads (instruction fetch buffers): a port that supports them answers
+request_read_line() with a single response covering the whole line; resp_line()
+then points at its words (lowest address first) until resp_consume().  Lines
+are naturally aligned, a power of two from 4 to kMaxLineBytes.
+
+Tagged requests (several outstanding): a port with supports_tags() keeps up
+to max_outstanding() requests and responses in flight at once and labels each
+response with the tag of its request (untagged requests carry tag 0).
+Responses may come back in any order; match them by resp_tag().
+
+Byte writes (SB/SH): a port with supports_byte_writes() takes a naturally
+aligned 1, 2 or 4 byte store (value in the low bytes) as one write request and
+leaves the rest of the word alone, so callers need not read-modify-write.  It
+is answered like request_write32.
 */
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 
 namespace smem {
 
+// A port address range [lo, hi] (inclusive).  host != nullptr: the range is
+// backed by host memory at host[addr - lo].  host == nullptr: direct access
+// was refused for the whole range, use read32/write32 there.
+struct DirectRegion {
+  uint8_t* host = nullptr;
+  uint32_t lo   = 1;           // empty until filled in (lo > hi)
+  uint32_t hi   = 0;
+  bool untouched = false;      // refused only because nothing backs it yet: a write grant would succeed
+  bool covers(uint32_t addr, uint32_t bytes) const {
+    return addr >= lo && addr <= hi && (hi - addr) >= bytes - 1u;
+  }
+};
+
 class MemoryPort {
 public:
   virtual          ~MemoryPort()                          = default;
@@ -24,6 +61,74 @@ public:
   virtual bool     resp_valid() const                     = 0;
   virtual uint32_t resp_data() const                      = 0;
   virtual void     resp_consume()                         = 0;
+  // Line reads; default: unsupported (callers fall back to request_read32)
+  static constexpr uint32_t kMaxLineBytes = 64;
+  virtual bool            supports_line_reads() const                       { return false; }
+  virtual void            request_read_line(uint32_t /*addr*/, uint32_t /*bytes*/) {}
+  virtual const uint32_t* resp_line() const                                 { return nullptr; }
+  // Tagged requests; default: untagged, one request at a time
+  virtual bool            supports_tags() const                             { return false; }
+  virtual uint32_t        max_outstanding() const                           { return 1; }
+  virtual void            request_read32_tagged(uint32_t addr, uint32_t /*tag*/) { request_read32(addr); }
+  virtual void            request_write32_tagged(uint32_t addr, uint32_t value, uint32_t /*tag*/) { request_write32(addr, value); }
+  virtual uint32_t        resp_tag() const                                  { return 0; }
+  // Byte writes; default: unsupported (callers fall back to read32 + merge + write32)
+  virtual bool            supports_byte_writes() const                      { return false; }
+  virtual void            request_write_bytes_tagged(uint32_t /*addr*/, uint32_t /*value*/, uint32_t /*bytes*/, uint32_t /*tag*/) {}
+  // Direct memory interface; default refuses everything.  On return `out` must cover `addr`.
+  // write=false: the caller only reads through the grant (see above).
+  virtual bool     get_direct(uint32_t /*addr*/, DirectRegion* out, bool /*write*/ = false) {
+    out->host      = nullptr;
+    out->lo        = 0;
+    out->hi        = 0xffffffffu;
+    out->untouched = false;
+    return false;
+  }
+};
+
+// Untimed word access through a port's direct region when it grants one.
+// Caches the last few regions (granted or refused), so steady-state hits cost
+// a range check or two and a memcpy; call reset() if the port is re-attached
+// or its backing store is rebuilt.
+class DirectAccessor {
+public:
+  DirectAccessor() = default;
+  explicit DirectAccessor(MemoryPort* port) : port_(port) {}
+  void attach(MemoryPort* port) { port_ = port; reset(); }
+  void reset() {
+    for (DirectRegion& r : regions_) r = DirectRegion{};
+    mru_ = 0;
+  }
+
+  uint32_t read32(uint32_t addr) {
+    const DirectRegion& r = region_for(addr);
+    if (!r.host || !r.covers(addr, 4u)) return port_->read32(addr);
+    uint32_t value;
+    std::memcpy(&value, r.host + (addr - r.lo), sizeof(value));
+    return value;
+  }
+  void write32(uint32_t addr, uint32_t value) {
+    DirectRegion& r = region_for(addr);
+    if (!r.host && r.untouched) port_->get_direct(addr, &r, true); // first write: commit it and cache the grant
+    if (!r.host || !r.covers(addr, 4u)) { port_->write32(addr, value); return; }
+    std::memcpy(r.host + (addr - r.lo), &value, sizeof(value));
+  }
+
+private:
+  static constexpr unsigned kRegions = 4; // code, stack, a couple of data streams
+  DirectRegion& region_for(uint32_t addr) {      // cached, else a read grant
+    if (regions_[mru_].covers(addr, 4u)) return regions_[mru_];
+    for (unsigned k = 0; k < kRegions; ++k) {
+      if (regions_[k].covers(addr, 4u)) { mru_ = k; return regions_[k]; }
+    }
+    mru_ = (mru_ + 1u) % kRegions;        // replace round-robin
+    port_->get_direct(addr, &regions_[mru_]);
+    return regions_[mru_];
+  }
+
+  MemoryPort*  port_ = nullptr;
+  DirectRegion regions_[kRegions]{};
+  unsigned     mru_ = 0;
 };
 
 } // namespace smem
@@ -0,0 +1,78 @@
+// **********************************************************************
+// smem/include/smem/TraceReplay.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Trace-driven memory master: plays the loads/stores of a MemTrace file into a
+memory hierarchy (MemCtrl -> Dram today, caches later) instead of a core, the
+way MemTester plays a hand-built script.
+
+  m_req  -> in_core_req  (MemCtrl)
+  m_resp <- out_core_resp
+
+- One request per cycle, at most max_outstanding without a response (stores
+  count until their ack; posted stores are acked on acceptance).
+- Full speed (default) skips non-memory records; paced mode spends one cycle
+  per record, i.e. replays the program at one instruction per cycle.
+- Each access goes out at its own address and size (1/2/4 bytes).  The trace
+  carries no data, so store data is zero.
+*/
+
+#pragma once
+#include <cascade/Cascade.hpp>
+#include "smem/MemTypes.hpp"
+#include "smem/MemTrace.hpp"
+#include <string>
+#include <unordered_map>
+
+namespace smem {
+
+class TraceReplay : public Component {
+  DECLARE_COMPONENT(TraceReplay);
+public:
+  TraceReplay(std::string name, COMPONENT_CTOR);
+
+  Clock(clk);
+
+  // Memory master ports (same shape as MemTester)
+  FifoOutput(MemReq,  m_req);
+  FifoInput (MemResp, m_resp);
+
+  bool open(const std::string& path, std::string* err); // call before running
+  void set_base(uint64_t base) { base_ = base; }          // added to every trace address (e.g. Dram::get_base())
+  void set_max_outstanding(uint32_t n);                   // >= 1
+  void set_paced(bool en) { paced_ = en; }
+
+  bool done() const { return trace_done_ && !have_rec_ && pending_.empty(); }
+
+  uint64_t cycles()       const { return cyc_; }
+  uint64_t records()      const { return records_; }
+  uint64_t loads()        const { return loads_; }
+  uint64_t stores()       const { return stores_; }
+  uint64_t load_lat_sum() const { return load_lat_sum_; } // issue -> response, summed over loads
+  uint64_t load_lat_max() const { return load_lat_max_; }
+  uint64_t blocked()      const { return blocked_; }      // cycles an access waited (window full / m_req full)
+
+  void update_issue();   // reads internal state, writes m_req
+  void update_retire();  // reads m_resp, writes internal state
+  void reset();
+
+private:
+  MemTraceReader reader_;
+  MemTrace::Rec  rec_{};
+  bool     have_rec_ = false;   // rec_ holds the next record to play
+  bool     trace_done_ = true;
+  uint64_t base_ = 0;
+  uint32_t max_outstanding_ = 1;
+  bool     paced_ = false;
+
+  uint64_t cyc_ = 0;
+  uint16_t next_id_ = 0;
+  struct Pending { bool is_load; uint64_t sent_cyc; };
+  std::unordered_map<uint16_t, Pending> pending_;
+
+  uint64_t records_ = 0, loads_ = 0, stores_ = 0;
+  uint64_t load_lat_sum_ = 0, load_lat_max_ = 0, blocked_ = 0;
+};
+
+} // namespace smem
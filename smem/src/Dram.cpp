@@ -10,6 +10,7 @@
    +------------
 */
 #include "smem/Dram.hpp"
+#include <algorithm>
 #include <cstring>
 
 namespace smem {
@@ -17,7 +18,47 @@ namespace smem {
 Dram::Dram(std::string /*name*/, int latency, IMPL_CTOR) : latency_(latency) // DRAM constructor
 {
   UPDATE(update).reads(s_req).writes(s_resp); // hint let's Cascade order producer->consumer correctly
-  mem_.resize(256 * 1024 * 1024);             // upon construction resizes (allocates) mem_ to 256MB of DRAM
+  set_size(kDefaultSize);                     // 256MB window by default; pages only get host memory when written
+}
+
+// Resize the DRAM window; contents are dropped (call before loading anything)
+void Dram::set_size(uint64_t bytes) {
+  assert_always(bytes != 0, "Dram size must be non-zero");
+  size_ = (bytes + kPageBytes - 1) / kPageBytes * kPageBytes;
+  pages_.clear();
+  pages_.resize(size_ / kPageBytes);
+  resident_pages_ = 0;
+}
+
+uint8_t* Dram::page_for_write(uint64_t page_idx) {
+  std::unique_ptr<uint8_t[]>& page = pages_[page_idx];
+  if (!page) {
+    page.reset(new uint8_t[kPageBytes]()); // value-initialized: a fresh page reads as zero
+    ++resident_pages_;
+  }
+  return page.get();
+}
+
+void Dram::copy_in(uint64_t off, const void* src, uint64_t bytes) {
+  const uint8_t* in = static_cast<const uint8_t*>(src);
+  while (bytes != 0) {
+    const uint64_t in_page = off % kPageBytes;
+    const uint64_t n = std::min(bytes, kPageBytes - in_page);
+    std::memcpy(page_for_write(off / kPageBytes) + in_page, in, n);
+    off += n; in += n; bytes -= n;
+  }
+}
+
+void Dram::copy_out(uint64_t off, void* dst, uint64_t bytes) const {
+  uint8_t* out = static_cast<uint8_t*>(dst);
+  while (bytes != 0) {
+    const uint64_t in_page = off % kPageBytes;
+    const uint64_t n = std::min(bytes, kPageBytes - in_page);
+    const uint8_t* page = pages_[off / kPageBytes].get();
+    if (page) std::memcpy(out, page + in_page, n);
+    else      std::memset(out, 0, n);               // untouched page reads zero
+    off += n; out += n; bytes -= n;
+  }
 }
 
 // Set latency in cycles (applies to the next accepted request; in-flight unaffected)
@@ -36,7 +77,7 @@ void* Dram::alloc(uint64_t bytes) {
   return addr;                    // returns starting addr
 }
 
-// method: write to DRAM, use memcpy fn. to copy data between host program's memory and simulated DRAM (mem_ vector)
+// method: write to DRAM, use memcpy fn. to copy data between host program's memory and simulated DRAM (sparse pages)
 void Dram::write(uint64_t addr, const void* src, uint64_t bytes) {
   // Trace HAL-side writes for visibility in -test=multi/bounds
   if (bytes >= 8) {
@@ -52,8 +93,8 @@ void Dram::write(uint64_t addr, const void* src, uint64_t bytes) {
   }
   if (addr < base_addr_) return;
   uint64_t off = addr - base_addr_;
-  if (off + bytes > mem_.size()) return;
-  memcpy(&mem_[off], src, bytes);
+  if (off + bytes > size_) return;
+  copy_in(off, src, bytes);
 }
 // method: read from DRAM for HAL
 void Dram::read(uint64_t addr, void* dst, uint64_t bytes) {
@@ -64,7 +105,7 @@ void Dram::read(uint64_t addr, void* dst, uint64_t bytes) {
   }
   // Compute offset once (safe after the check above)
   uint64_t off_u64 = addr - base_addr_;
-  size_t   sz      = mem_.size();
+  size_t   sz      = (size_t)size_;
   size_t   off     = (size_t)off_u64;
   size_t   n       = (size_t)bytes;
   // OOB past end (overflow-safe): if n > sz - off, range doesn’t fit
@@ -73,7 +114,7 @@ void Dram::read(uint64_t addr, void* dst, uint64_t bytes) {
     return;
   }
   // In-bounds copy
-  std::memcpy(dst, mem_.data() + off, n);
+  copy_out(off, dst, n);
   // Trace a preview of the first 8 bytes (same as before)
   if (n >= 8) {
     uint64_t tmp = 0;
@@ -89,15 +130,38 @@ void Dram::read(uint64_t addr, void* dst, uint64_t bytes) {
   }
 }
 
+// method: direct host pointer into DRAM backing store (DMI), no trace/copy
+uint8_t* Dram::direct_ptr(uint64_t addr, uint64_t* avail, bool write) {
+  if (addr < base_addr_ || addr - base_addr_ >= size_) {
+    if (avail) *avail = 0;
+    return nullptr;
+  }
+  const uint64_t off = addr - base_addr_;
+  if (avail) *avail = kPageBytes - off % kPageBytes;
+  if (!write && !pages_[off / kPageBytes]) return nullptr; // untouched: reads are zero, don't commit it
+  return page_for_write(off / kPageBytes) + off % kPageBytes;
+}
+
 void Dram::update() {
   // Zero-latency storage with 1-entry read hold; writes produce no responses.
   if (!hold_valid_ && !s_req.empty()) {          // accept one req (if not already holding a LOAD req)
     auto rq = s_req.pop();
-    if (rq.write) {                                // if req=STORE copy wdata into to byte array; no sig on s_resp
+    assert_always((uint32_t)(u16)rq.size <= kMaxBurstBytes, "Dram: op larger than kMaxBurstBytes");
+    if (rq.write) {                                // if req=STORE copy wdata (all beats) into to byte array; no sig on s_resp
       if (rq.addr >= base_addr_) {
         uint64_t off = rq.addr - base_addr_;
-        if (off + rq.size <= mem_.size())
-          std::memcpy(&mem_[off], &rq.wdata, rq.size);
+        const uint32_t n = (u16)rq.size;
+        if (off + n <= size_) {
+          uint8_t buf[kMaxBurstBytes];
+          for (uint32_t i = 0; i < n; ++i) buf[i] = rq.wbyte(i);
+          for (uint32_t i = 0; i < n;) {            // copy each run of enabled bytes
+            if (!rq.byte_en(i)) { ++i; continue; }
+            uint32_t j = i;
+            while (j < n && rq.byte_en(j)) ++j;
+            copy_in(off + i, buf + i, j - i);
+            i = j;
+          }
+        }
       }
     } else {                                       // if req=LOAD put req in hold_ (1-entry latch)
       hold_ = rq;
@@ -109,10 +173,14 @@ void Dram::update() {
     MemResp resp{};                                // build zero-initialized resp
     if (hold_.addr >= base_addr_) {                // if addr inside DRAM window
       uint64_t off = hold_.addr - base_addr_;
-      if (off + hold_.size <= mem_.size())          // bounds check (if requested bytes fit)
-        std::memcpy(&resp.rdata, &mem_[off], hold_.size);
-      else
+      const uint32_t n = (u16)hold_.size;
+      if (off + n <= size_) {                       // bounds check (if requested bytes fit)
+        uint64_t buf[kMaxBeats] = {};
+        copy_out(off, buf, n);                      // beats in host order (little-endian, like the single-beat copy)
+        for (uint32_t b = 0; b < hold_.beats(); ++b) resp.set_rbeat(b, buf[b]);
+      } else {
         resp.rdata = 0;
+      }
     } else {
       resp.rdata = 0;
     }
@@ -127,7 +195,7 @@ void Dram::reset() {
   cnt_ = -1;
   // Preload memory location with the expected test pattern
   uint64_t v = 0x1122334455667788ull;
-  std::memcpy(&mem_[0], &v, 8);
+  copy_in(0, &v, 8);
 }
 
 } // namespace smem
@@ -28,13 +28,37 @@ bool DramMemoryPort::can_request() const {
 }
 
 void DramMemoryPort::request_read32(uint32_t addr) {
+  request_read32_tagged(addr, 0);
+}
+
+void DramMemoryPort::request_read32_tagged(uint32_t addr, uint32_t tag) {
   resp_data_ = read32(addr);
+  resp_tag_ = tag;
+  resp_valid_ = true;
+}
+
+void DramMemoryPort::request_read_line(uint32_t addr, uint32_t bytes) {
+  dram_.read(dram_.get_base() + static_cast<uint64_t>(addr), line_, bytes);
+  resp_data_ = line_[0];
+  resp_tag_ = 0;
   resp_valid_ = true;
 }
 
 void DramMemoryPort::request_write32(uint32_t addr, uint32_t value) {
+  request_write32_tagged(addr, value, 0);
+}
+
+void DramMemoryPort::request_write32_tagged(uint32_t addr, uint32_t value, uint32_t tag) {
   write32(addr, value);
   resp_data_ = 0;
+  resp_tag_ = tag;
+  resp_valid_ = true;
+}
+
+void DramMemoryPort::request_write_bytes_tagged(uint32_t addr, uint32_t value, uint32_t bytes, uint32_t tag) {
+  dram_.write(dram_.get_base() + static_cast<uint64_t>(addr), &value, bytes); // little-endian: low bytes of value
+  resp_data_ = 0;
+  resp_tag_ = tag;
   resp_valid_ = true;
 }
 
@@ -50,4 +74,28 @@ void DramMemoryPort::resp_consume() {
   resp_valid_ = false;
 }
 
+bool DramMemoryPort::get_direct(uint32_t addr, DirectRegion* out, bool write) {
+  // Port address 0 maps to the DRAM base.  Grants are per backing page.  A write grant
+  // commits the page; a read grant of a page never written is refused for just that page
+  // (marked untouched: read32() gives zeros without allocating).  Everything past the DRAM
+  // window reads as zero through read32() (and drops writes), so that tail is refused too.
+  const uint64_t page = Dram::kPageBytes;
+  const uint64_t lo   = static_cast<uint64_t>(addr) / page * page;
+  if (lo < dram_.get_size()) {
+    uint64_t avail = 0;
+    uint8_t* host = dram_.direct_ptr(dram_.get_base() + lo, &avail, write);
+    out->host      = host;
+    out->lo        = static_cast<uint32_t>(lo);
+    out->hi        = static_cast<uint32_t>(lo + avail - 1u);
+    out->untouched = host == nullptr;
+    return host != nullptr;
+  }
+  const uint64_t end = dram_.get_size();
+  out->host      = nullptr;
+  out->lo        = end < 0x100000000ull ? static_cast<uint32_t>(end) : 0u;
+  out->hi        = 0xffffffffu;
+  out->untouched = false;
+  return false;
+}
+
 } // namespace smem
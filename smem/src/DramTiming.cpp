@@ -0,0 +1,226 @@
+// **********************************************************************
+// smem/src/DramTiming.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Bank/row-buffer DRAM timing: config parsing, address mapping, per-access scheduling.
+*/
+#include "smem/DramTiming.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+namespace smem {
+
+namespace {
+
+bool pow2(uint32_t v) { return v != 0 && (v & (v - 1u)) == 0; }
+
+uint32_t log2u(uint32_t v) {
+  uint32_t n = 0;
+  while ((1u << n) < v) ++n;
+  return n;
+}
+
+bool fail(std::string* err, const std::string& msg) {
+  if (err) *err = msg;
+  return false;
+}
+
+bool parse_field(const std::string& name, DramTiming::Field* out) {
+  if (name == "row")                     { *out = DramTiming::Field::Row;     return true; }
+  if (name == "rank")                    { *out = DramTiming::Field::Rank;    return true; }
+  if (name == "bank")                    { *out = DramTiming::Field::Bank;    return true; }
+  if (name == "ch" || name == "channel") { *out = DramTiming::Field::Channel; return true; }
+  if (name == "col")                     { *out = DramTiming::Field::Col;     return true; }
+  return false;
+}
+
+bool parse_map(const std::string& spec, std::array<DramTiming::Field, 5>* out, std::string* err) {
+  using Field = DramTiming::Field;
+  std::vector<Field> order;
+  std::stringstream ss(spec);
+  std::string name;
+  while (std::getline(ss, name, ':')) {
+    Field f;
+    if (!parse_field(name, &f)) return fail(err, "dram map: unknown field '" + name + "'");
+    if (std::find(order.begin(), order.end(), f) != order.end()) return fail(err, "dram map: field '" + name + "' repeated");
+    order.push_back(f);
+  }
+  for (Field f : {Field::Row, Field::Bank, Field::Col}) {
+    if (std::find(order.begin(), order.end(), f) == order.end()) return fail(err, "dram map: needs row, bank and col");
+  }
+  for (Field f : {Field::Rank, Field::Channel}) { // left out: just above col (channel lowest)
+    if (std::find(order.begin(), order.end(), f) == order.end()) {
+      order.insert(std::find(order.begin(), order.end(), Field::Col), f);
+    }
+  }
+  std::copy(order.begin(), order.end(), out->begin());
+  return true;
+}
+
+} // namespace
+
+bool DramTiming::parse_config(const std::string& spec, Config* out, std::string* err) {
+  Config cfg;
+  if (spec != "on" && spec != "default") {
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      const size_t eq = item.find('=');
+      if (eq == std::string::npos) return fail(err, "dram timing: expected key=value, got '" + item + "'");
+      const std::string key = item.substr(0, eq);
+      const std::string val = item.substr(eq + 1);
+      if (key == "map") {
+        if (!parse_map(val, &cfg.map, err)) return false;
+        continue;
+      }
+      if (key == "policy") {
+        if (val != "open" && val != "closed") return fail(err, "dram timing: policy must be open or closed");
+        cfg.open_page = val == "open";
+        continue;
+      }
+      char* end = nullptr;
+      const unsigned long v = std::strtoul(val.c_str(), &end, 0);
+      if (val.empty() || *end != '\0') return fail(err, "dram timing: bad number for " + key);
+      const uint32_t n = static_cast<uint32_t>(v);
+      if      (key == "ch")       cfg.channels    = n;
+      else if (key == "rank")     cfg.ranks       = n;
+      else if (key == "bank")     cfg.banks       = n;
+      else if (key == "row_bits") cfg.row_bits    = n;
+      else if (key == "page")     cfg.page_bytes  = n;
+      else if (key == "burst")    cfg.burst_bytes = n;
+      else if (key == "trcd")     cfg.tRCD   = n;
+      else if (key == "tcas")     cfg.tCAS   = n;
+      else if (key == "trp")      cfg.tRP    = n;
+      else if (key == "tras")     cfg.tRAS   = n;
+      else if (key == "twr")      cfg.tWR    = n;
+      else if (key == "tburst")   cfg.tBURST = n;
+      else return fail(err, "dram timing: unknown key '" + key + "'");
+    }
+  }
+  if (!pow2(cfg.channels) || !pow2(cfg.ranks) || !pow2(cfg.banks) || !pow2(cfg.page_bytes) || !pow2(cfg.burst_bytes)) {
+    return fail(err, "dram timing: ch, rank, bank, page and burst must be powers of two");
+  }
+  if (cfg.row_bits == 0 || cfg.row_bits > 32 || cfg.page_bytes < 4) {
+    return fail(err, "dram timing: row_bits must be 1..32 and page at least 4 bytes");
+  }
+  *out = cfg;
+  return true;
+}
+
+DramTiming::DramTiming(const Config& cfg) : cfg_(cfg) {
+  uint32_t shift = 0;
+  for (size_t i = cfg_.map.size(); i-- > 0;) { // LSB first
+    const Field f = cfg_.map[i];
+    uint32_t bits = 0;
+    switch (f) {
+      case Field::Col:     bits = log2u(cfg_.page_bytes); break;
+      case Field::Channel: bits = log2u(cfg_.channels);   break;
+      case Field::Bank:    bits = log2u(cfg_.banks);      break;
+      case Field::Rank:    bits = log2u(cfg_.ranks);      break;
+      case Field::Row:     bits = cfg_.row_bits;          break;
+    }
+    shift_[static_cast<size_t>(f)] = shift;
+    mask_[static_cast<size_t>(f)]  = (1ull << bits) - 1ull;
+    shift += bits;
+  }
+  banks_.resize(static_cast<size_t>(cfg_.channels) * cfg_.ranks * cfg_.banks);
+  bus_free_.resize(cfg_.channels);
+}
+
+void DramTiming::reset() {
+  std::fill(banks_.begin(), banks_.end(), Bank{});
+  std::fill(bus_free_.begin(), bus_free_.end(), 0);
+  hits_ = misses_ = conflicts_ = bus_busy_ = 0;
+  req_.fill(RequesterStats{});
+}
+
+DramTiming::Loc DramTiming::decode(uint64_t addr) const {
+  auto field = [&](Field f) { return (addr >> shift_[static_cast<size_t>(f)]) & mask_[static_cast<size_t>(f)]; };
+  const uint32_t ch = static_cast<uint32_t>(field(Field::Channel));
+  const uint32_t bank = (ch * cfg_.ranks + static_cast<uint32_t>(field(Field::Rank))) * cfg_.banks +
+                        static_cast<uint32_t>(field(Field::Bank));
+  return Loc{bank, ch, field(Field::Row)};
+}
+
+DramTiming::Outcome DramTiming::classify(uint64_t addr) const {
+  const Loc l = decode(addr);
+  const Bank& b = banks_[l.bank];
+  if (!b.open) return Outcome::Miss;
+  return b.row == l.row ? Outcome::Hit : Outcome::Conflict;
+}
+
+uint64_t DramTiming::bank_ready(uint64_t addr) const {
+  return banks_[decode(addr).bank].ready;
+}
+
+uint64_t DramTiming::access(uint64_t addr, uint32_t bytes, bool write, uint64_t now, uint32_t src) {
+  const Loc l = decode(addr);
+  Bank& b = banks_[l.bank];
+  const uint64_t t = std::max(now, b.ready);
+  uint64_t cas = t;
+  if (b.open && b.row == l.row) {
+    hits_++;
+  } else {
+    uint64_t act = t;
+    if (b.open) {                                   // conflict: close the other row first
+      conflicts_++;
+      act = std::max({t, b.act + cfg_.tRAS, b.wr_end + cfg_.tWR}) + cfg_.tRP;
+    } else {
+      misses_++;
+    }
+    b.act = act;
+    cas = act + cfg_.tRCD;
+  }
+  const uint64_t beats = std::max<uint64_t>(1u, (bytes + cfg_.burst_bytes - 1u) / cfg_.burst_bytes);
+  const uint64_t xfer  = beats * cfg_.tBURST;
+  uint64_t& bus = bus_free_[l.channel];
+  const uint64_t data = std::max(cas + cfg_.tCAS, bus); // data bus: one access at a time, in schedule order
+  const uint64_t done = data + xfer;
+  bus = done;
+  bus_busy_ += xfer;
+  if (write) b.wr_end = done;
+  if (cfg_.open_page) {
+    b.open  = true;
+    b.row   = l.row;
+    b.ready = cas + xfer;
+  } else {                                          // auto-precharge once the data is out
+    b.open  = false;
+    b.ready = std::max({cas + xfer, b.act + cfg_.tRAS, write ? done + cfg_.tWR : uint64_t{0}}) + cfg_.tRP;
+  }
+
+  RequesterStats& r = req_[src < kMaxRequesters ? src : kMaxRequesters - 1];
+  if (r.reads + r.writes == 0) r.first = now;
+  (write ? r.writes : r.reads)++;
+  r.bytes   += bytes;
+  r.lat_sum += done - now;
+  r.last     = std::max(r.last, done);
+  return done;
+}
+
+void DramTiming::print_stats(uint64_t cycles) const {
+  static const char* const kNames[kMaxRequesters] = {"core", "accel", "dma", "other"}; // MemSrc order
+  const uint64_t acc = hits_ + misses_ + conflicts_;
+  printf("[DRAMT] policy=%s ch=%u banks=%u accesses=%llu row_hits=%llu row_misses=%llu row_conflicts=%llu hit_rate=%.1f%% bus_util=%.1f%%\n",
+         cfg_.open_page ? "open" : "closed", cfg_.channels, num_banks(),
+         (unsigned long long)acc,
+         (unsigned long long)hits_,
+         (unsigned long long)misses_,
+         (unsigned long long)conflicts_,
+         acc ? 100.0 * static_cast<double>(hits_) / static_cast<double>(acc) : 0.0,
+         cycles ? 100.0 * static_cast<double>(bus_busy_) / static_cast<double>(cycles * cfg_.channels) : 0.0);
+  for (uint32_t s = 0; s < kMaxRequesters; ++s) {
+    const RequesterStats& r = req_[s];
+    if (r.reads + r.writes == 0) continue;
+    printf("[DRAMT] src=%s reads=%llu writes=%llu bytes=%llu avg_lat=%.2f bw=%.3f B/cycle\n", kNames[s],
+           (unsigned long long)r.reads,
+           (unsigned long long)r.writes,
+           (unsigned long long)r.bytes,
+           static_cast<double>(r.lat_sum) / static_cast<double>(r.reads + r.writes),
+           r.bytes_per_cycle());
+  }
+}
+
+} // namespace smem
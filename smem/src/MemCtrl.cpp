@@ -4,10 +4,11 @@
 // S Magierowski Aug 22 2025
 /*
 Does three simple things each cycle.  
-1) Keeps a queue with a mem latency countdown per request. 
-  - Decrement a countdown on every queued item (not the one added this cycle).
-2) If the front item is ready (its countdown=0), send it to DRAM and remove from queue.
+1) Keeps a queue of requests, each stamped with the absolute cycle it may go to DRAM.
+  - nothing is aged per cycle, so the cost of a cycle does not grow with latency or queue depth
+2) If the front item is ready (its cycle has come), send it to DRAM and remove from queue.
 3) Take at most one new STORE or LOAD request from core. 
+(That is the Fifo scheduler; FrFcfs is at the bottom, see MemCtrl.hpp.)
 
 Some details:
 • core can make either STORE or LOAD request (obviously)
@@ -16,10 +17,21 @@ Some details:
   - non-posted STORE means core gets ACK only afer DRAM gets store
 • LOADs can fetch from STORE queue
   - if a LOAD matches a STORE in the queue, return that value to core right away (and still send that STORE to DRAM)
+  - pending STOREs are indexed by 8-byte beat (store_lines_), so the lookup is a hash probe, not a queue scan
+  - each beat keeps a byte mask, so a LOAD of any size/alignment is forwarded if pending STOREs wrote all its bytes;
+    a partial overlap queues behind them and reads DRAM once they have drained
+• write combining (optional): a posted STORE may merge into the youngest queued STORE of the same 64-byte block
+• ready cycle is latency_ away, or with DRAM timing on at latency_ + the bank/bus time DramTiming schedules
+  - the queue still issues in order, so a slow head holds back a younger request that would be ready earlier
 */
 
 #include "smem/MemCtrl.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
 namespace smem {
 
 MemCtrl::MemCtrl(std::string /*name*/, IMPL_CTOR) {  // constructor registers two update fns. & says what they touch
@@ -29,52 +41,70 @@ MemCtrl::MemCtrl(std::string /*name*/, IMPL_CTOR) {  // constructor registers tw
 
 // ----- first update: accepts from core, ages/queues, issues to DRAM -----
 void MemCtrl::update_issue() {
-  // 1) Age existing entries (do not age the one we may enqueue this tick)
-  for (auto &q : pipe_) if (q.cnt > 0) --q.cnt; // pipe_ holdes queued memory ops
-  // 2) Sending signals to DRAM
-  if (!pipe_.empty() && pipe_.front().cnt == 0) {  // if head of queue is matured
+  now_++;
+  if (sched_.policy == Sched::FrFcfs) {
+    issue_frfcfs();
+    for (uint32_t k = 0; k < sched_.accept && accept_core_req(); ++k) {}
+    return;
+  }
+  // 1)+2) Sending signals to DRAM
+  if (!pipe_.empty() && pipe_.front().ready <= now_) { // if head of queue is matured
     const MemReq &hq = pipe_.front().r;
     if (hq.write && !posted_writes_) {               // if non-posted STORE @ head (i.e., ACK not sent to core yet)
       if (!out_core_resp.full() && !s_req.full()) {    // if MemCtrl & DRAM FIFOs can take data
         MemResp ack{}; ack.rdata = 0; ack.id = hq.id; ack.err = 0; // build a STORE ACK
         out_core_resp.push(ack);                                   // send ACK to core now
         s_req.push(hq);                                            // issue STORE to DRAM
+        drop_store(hq);                                            // no longer pending for RAW
         pipe_.pop_front();                                         // remove from queue
       }
     } else if (!s_req.full()) {                      // if LOAD or posted STORE @ head (STORE ACK already sent to core)
       s_req.push(hq);                                  // issue to DRAM
+      if (hq.write) drop_store(hq);                    // no longer pending for RAW
       pipe_.pop_front();                               // remove from queue
     }
   }
   // 3) Take at most one new request from core; posted write-ack + RAW handling
-  if (!in_core_req.empty()) {       // if core has REQ ready 
-    if (out_core_resp.full()) return; // avoid pop if we might need to ACK a store but cannot (being convervative)
-    auto r = in_core_req.pop();       // take REQ from core
-    if (r.write) {                    // *** if core's REQ is STORE ***
-      if (posted_writes_) {                                       // if posted STORE
-        assert_always(((u64)r.size == 8) && (((u64)r.addr & 7ull) == 0ull), "MemCtrl posted write: only 8-byte aligned ops supported for now"); // Guard
-        MemResp ack{}; ack.rdata = 0; ack.id = r.id; ack.err = 0;   // build ACK
-        out_core_resp.push(ack);                                    // send ACK to core now
-      }
-      pipe_.push_back(Q{r, latency_});                            // put STORE in latency queue
-    } else {                          // *** if core's REQ is LOAD ***
-      u64 fwd = 0;
-      if (find_pending_store((u64)r.addr, (u16)r.size, fwd)) {   // check if a queued STORE=LOAD (store hazard); if so forward full word; partial size handling can be added later
-        assert_always(((u64)r.size == 8) && (((u64)r.addr & 7ull) == 0ull), "MemCtrl RAW forward: only 8-byte aligned ops supported for now"); // Guard
-        MemResp rr{}; rr.rdata = fwd; rr.id = r.id; rr.err = 0;    // build synthetic LOAD response with STORE's data
-        out_core_resp.push(rr);                                    // return data to core now (no DRAM access)
-      } else {                                                   // normal path through latency pipe
-        pipe_.push_back(Q{r, latency_});                           // no hazard: queue the read for timed issue to DRAM
-      }
+  accept_core_req();
+}
+
+// take one request from the core: posted write-ack + RAW handling, else queue it
+bool MemCtrl::accept_core_req() {
+  if (in_core_req.empty()) return false;          // if core has no REQ ready
+  if (out_core_resp.full()) return false;         // avoid pop if we might need to ACK a store but cannot (being convervative)
+  if (sched_.policy == Sched::FrFcfs && pipe_.size() + inflight_.size() >= sched_.depth) { full_stalls_++; return false; } // transaction queue full
+  auto r = in_core_req.pop();       // take REQ from core
+  assert_always((u16)r.size >= 1 && (u16)r.size <= kMaxBurstBytes, "MemCtrl: op size must be 1..kMaxBurstBytes");
+  if (r.write) {                    // *** if core's REQ is STORE ***
+    stores_++;
+    if (posted_writes_) {                                       // if posted STORE
+      MemResp ack{}; ack.rdata = 0; ack.id = r.id; ack.err = 0;   // build ACK
+      out_core_resp.push(ack);                                    // send ACK to core now
+    }
+    if (!(wc_ && posted_writes_ && combine_store(r))) {         // merged into a queued STORE, or …
+      enqueue(r);                                               // … put STORE in latency queue
+    }
+  } else {                          // *** if core's REQ is LOAD ***
+    MemResp rr{};
+    bool fwd = false;
+    const bool hit = find_pending_store(r, rr, fwd);
+    if (hit && fwd) {                                          // check if queued STOREs=LOAD (store hazard); if they wrote all its bytes forward them
+      rr.id = r.id; rr.err = 0;                                  // synthetic LOAD response with STOREs' data (all beats)
+      out_core_resp.push(rr);                                    // return data to core now (no DRAM access)
+      load_fwd_++;
+    } else {                                                   // normal path through latency pipe
+      if (hit) load_partial_++;                                  // partly covered: DRAM has the rest once the STOREs drain
+      enqueue(r);                                                // no (forwardable) hazard: queue the read for timed issue to DRAM
     }
   }
+  return true;
 }
 
 // ----- second update: passes DRAM results back to core -----
 void MemCtrl::update_retire() {
   if (!s_resp.empty() && !out_core_resp.full()) { // if DRAM returns LOAD & core can take it
     auto rr = s_resp.pop();                         // get DRAM's resp
-    MemResp o{}; o.rdata = rr.rdata; o.id = rr.id; o.err = 0; // build o/p resposne to core
+    MemResp o = rr; o.err = 0;                      // build o/p resposne to core (all beats)
     out_core_resp.push(o);                          // send resp to core 
   }
 }
@@ -82,29 +112,289 @@ void MemCtrl::update_retire() {
 // clear state
 void MemCtrl::reset() {
   pipe_.clear(); // forget all queued resuests
+  inflight_ = decltype(inflight_)();
+  store_lines_.clear();
+  pending_writes_ = 0;
+  seq_ = 0;
+  now_ = 0;
+  if (timing_) timing_->reset();
+  draining_ = last_write_ = false;
+  bus_free_ = 0;
+  queued_writes_ = 0;
+  picks_ = reorders_ = hit_picks_ = drains_ = turnarounds_ = full_stalls_ = 0;
+  stores_ = combined_ = drained_ = load_fwd_ = load_partial_ = 0;
+}
+
+void MemCtrl::set_dram_timing(const DramTiming::Config& cfg) {
+  assert_always(pipe_.empty() && inflight_.empty(), "MemCtrl DRAM timing changed while busy");
+  timing_ = std::make_unique<DramTiming>(cfg);
+  trace("mem: dram timing banks=%u policy=%s", timing_->num_banks(), cfg.open_page ? "open" : "closed");
+}
+
+// queue a request: Fifo gets its full hold now (issued >= 1 cycle later), FrFcfs only the front end (DRAM is booked when picked)
+void MemCtrl::enqueue(const MemReq& r) {
+  Q q{r, 0, seq_++};
+  if (sched_.policy == Sched::Fifo) {
+    q.ready = now_ + (uint64_t)std::max(hold_cycles(r), 1);
+  } else {
+    q.ready = now_ + (uint64_t)latency_;
+    if (r.write) queued_writes_++;
+  }
+  if (r.write) add_store(r);
+  pipe_.push_back(q);
+}
+
+// fixed front-end latency, then (if modelled) the bank/bus schedule; the DRAM access starts once latency_ is up
+int MemCtrl::hold_cycles(const MemReq& r) {
+  if (!timing_) return latency_;
+  const uint64_t start = now_ + (uint64_t)latency_;
+  const uint64_t done  = timing_->access((u64)r.addr, (uint32_t)(u16)r.size, (bool)r.write, start, (uint32_t)(u8)r.src);
+  return (int)(done - now_);
+}
+
+// ----- FR-FCFS -----
+bool MemCtrl::parse_sched(const std::string& spec, SchedConfig* out, std::string* err) {
+  SchedConfig cfg;
+  std::stringstream ss(spec);
+  std::string item;
+  bool first = true;
+  while (std::getline(ss, item, ',')) {
+    if (first) {
+      first = false;
+      if (item == "fifo")   { cfg.policy = Sched::Fifo;   continue; }
+      if (item == "frfcfs") { cfg.policy = Sched::FrFcfs; continue; }
+      if (err) *err = "mem sched: expected fifo or frfcfs, got '" + item + "'";
+      return false;
+    }
+    const size_t eq = item.find('=');
+    const std::string key = item.substr(0, eq);
+    const std::string val = eq == std::string::npos ? std::string() : item.substr(eq + 1);
+    char* end = nullptr;
+    const unsigned long v = std::strtoul(val.c_str(), &end, 0);
+    if (val.empty() || *end != '\0') {
+      if (err) *err = "mem sched: expected key=number, got '" + item + "'";
+      return false;
+    }
+    const uint32_t n = (uint32_t)v;
+    if      (key == "depth")      cfg.depth      = n;
+    else if (key == "accept")     cfg.accept     = n;
+    else if (key == "wr_hi")      cfg.wr_hi      = n;
+    else if (key == "wr_lo")      cfg.wr_lo      = n;
+    else if (key == "turnaround") cfg.turnaround = n;
+    else {
+      if (err) *err = "mem sched: unknown key '" + key + "'";
+      return false;
+    }
+  }
+  if (first || cfg.depth == 0 || cfg.accept == 0 || cfg.wr_lo > cfg.wr_hi) {
+    if (err) *err = "mem sched: needs fifo|frfcfs, depth and accept >= 1, wr_lo <= wr_hi";
+    return false;
+  }
+  *out = cfg;
+  return true;
+}
+
+void MemCtrl::set_scheduler(const SchedConfig& cfg) {
+  assert_always(pipe_.empty() && inflight_.empty(), "MemCtrl scheduler changed while busy");
+  assert_always(cfg.depth >= 1 && cfg.accept >= 1 && cfg.wr_lo <= cfg.wr_hi, "MemCtrl scheduler: depth/accept >= 1, wr_lo <= wr_hi");
+  sched_ = cfg;
+  trace("mem: sched=%s depth=%u accept=%u", cfg.policy == Sched::FrFcfs ? "frfcfs" : "fifo", cfg.depth, cfg.accept);
+}
+
+// 1) hand the picked request whose data is done first to Dram, 2) book DRAM time for the next pick
+void MemCtrl::issue_frfcfs() {
+  if (!inflight_.empty() && inflight_.top().done <= now_) { // earliest done wins, oldest on a tie
+    const MemReq &r = inflight_.top().r;
+    const bool ack = r.write && !posted_writes_;             // non-posted STORE: ACK once it reaches DRAM
+    if (!s_req.full() && !(ack && out_core_resp.full())) {
+      if (ack) { MemResp a{}; a.rdata = 0; a.id = r.id; a.err = 0; out_core_resp.push(a); }
+      s_req.push(r);
+      if (r.write) drop_store(r);
+      inflight_.pop();
+    }
+  }
+
+  if (!draining_ && queued_writes_ >= sched_.wr_hi && queued_writes_ != 0) { draining_ = true; drains_++; }
+  if (draining_ && queued_writes_ <= sched_.wr_lo) draining_ = false;
+  const int i = pick_frfcfs();
+  if (i < 0) return;
+  const Q &q = pipe_[(size_t)i];
+  const bool w = (bool)q.r.write;
+  uint64_t start = std::max(now_, bus_free_);              // never ahead of an earlier pick (or its turnaround)
+  if (picks_ != 0 && w != last_write_) { start += sched_.turnaround; turnarounds_++; }
+  bus_free_ = start;
+  uint64_t done = start;
+  if (timing_) {
+    if (timing_->classify((u64)q.r.addr) == DramTiming::Outcome::Hit) hit_picks_++;
+    done = timing_->access((u64)q.r.addr, (uint32_t)(u16)q.r.size, w, start, (uint32_t)(u8)q.r.src);
+  }
+  if (i != 0) reorders_++;                                  // went ahead of an older request
+  inflight_.push(Inflight{done, q.seq, q.r});
+  pipe_.erase(pipe_.begin() + i);
+  if (w) queued_writes_--;
+  last_write_ = w;
+  picks_++;
+}
+
+// reads first unless draining writes (the other kind only if none can go); then, among requests whose bank can
+// take a command now (so requests pile up behind a busy bank and row hits can jump the queue), row hit, oldest
+int MemCtrl::pick_frfcfs() const {
+  for (int pass = 0; pass < 2; ++pass) {
+    const bool want_write = (pass == 0) == draining_;
+    int best = -1, best_rank = 2;
+    for (size_t i = 0; i < pipe_.size(); ++i) {
+      const Q &q = pipe_[i];
+      if (q.ready > now_ || (bool)q.r.write != want_write || blocked_by_older(i)) continue;
+      int rank = 1;
+      if (timing_) {
+        if (timing_->bank_ready((u64)q.r.addr) > now_) continue;
+        if (timing_->classify((u64)q.r.addr) == DramTiming::Outcome::Hit) rank = 0;
+      }
+      if (rank < best_rank) { best = (int)i; best_rank = rank; }
+      if (rank == 0) break;
+    }
+    if (best >= 0) return best;
+  }
+  return -1;
+}
+
+bool MemCtrl::blocked_by_older(size_t i) const {
+  const MemReq &a = pipe_[i].r;
+  const u64 a0 = (u64)a.addr, a1 = a0 + (u64)a.size;
+  for (size_t j = 0; j < i; ++j) {
+    const Q &q = pipe_[j];
+    if (!a.write && !q.r.write) continue;                    // two reads may pass each other
+    const u64 b0 = (u64)q.r.addr, b1 = b0 + (u64)q.r.size;
+    if (!(a1 <= b0 || b1 <= a0)) return true;
+  }
+  return false;
+}
+
+void MemCtrl::print_sched_stats() const {
+  if (sched_.policy != Sched::FrFcfs) return;
+  printf("[MCSCHED] policy=frfcfs depth=%u accept=%u picks=%llu reordered=%llu row_hit_picks=%llu write_drains=%llu turnarounds=%llu queue_full=%llu\n",
+         sched_.depth, sched_.accept,
+         (unsigned long long)picks_,
+         (unsigned long long)reorders_,
+         (unsigned long long)hit_picks_,
+         (unsigned long long)drains_,
+         (unsigned long long)turnarounds_,
+         (unsigned long long)full_stalls_);
 }
 
 // small helpers
-// deal with LOAD = queued STORE (store hazard); scan most-recent-first for a pending write that overlaps [addr, addr+size)
-bool MemCtrl::find_pending_store(u64 addr, u16 size, u64 &val) const {
-  if (size == 0) return false;                           // empty LOAD size is a miss
-  u64 a0 = addr;                                         // read range start
-  u64 a1 = addr + (u64)size;                             // read range end (exclusive)
-  for (int i = (int)pipe_.size() - 1; i >= 0; --i) {     // search newset --> oldest
-    const Q &q = pipe_[(size_t)i];                         // candidate entry
-    if (!q.r.write) continue;                              // only consider STOREs
-    u64 b0 = (u64)q.r.addr;                                // STORE range start
-    u64 b1 = b0 + (u64)q.r.size;                           // STORE range end (exlucsive)
-    bool overlap = !(a1 <= b0 || b1 <= a0);                // overlap test
-    if (overlap) { val = (u64)q.r.wdata; return true; }    // on hit: return STORE data
+// pending STOREs by 8-byte beat: how many touch it, which bytes they write and the values DRAM ends up with there
+// (overlapping stores drain in order, so the youngest byte is what DRAM holds once they have all drained; bytes of
+// an already drained store stay valid until the beat's last pending store drains, since DRAM then holds them too)
+void MemCtrl::add_store(const MemReq& r) {
+  pending_writes_++;
+  const uint64_t a0 = (uint64_t)(u64)r.addr, n = (u16)r.size;
+  if (n == 0) return;
+  for (uint64_t b = a0 >> 3; b <= (a0 + n - 1u) >> 3; ++b) store_lines_[b].count++;
+  merge_store_bytes(r);
+}
+
+void MemCtrl::merge_store_bytes(const MemReq& r) {
+  const uint64_t a0 = (uint64_t)(u64)r.addr, n = (u16)r.size;
+  for (uint32_t i = 0; i < n; ++i) {
+    if (!r.byte_en(i)) continue;
+    StoreLine &l = store_lines_[(a0 + i) >> 3];
+    const uint32_t k = (uint32_t)((a0 + i) & 7u);
+    l.mask |= (uint8_t)(1u << k);
+    l.data  = (l.data & ~(0xffull << (8u * k))) | ((uint64_t)r.wbyte(i) << (8u * k));
   }
-  return false;                                         // no pending STORE covers this LOAD
+}
+
+void MemCtrl::drop_store(const MemReq& r) {
+  pending_writes_--;
+  drained_++;
+  const uint64_t a0 = (uint64_t)(u64)r.addr, n = (u16)r.size;
+  if (n == 0) return;
+  for (uint64_t b = a0 >> 3; b <= (a0 + n - 1u) >> 3; ++b) {
+    auto it = store_lines_.find(b);
+    if (it != store_lines_.end() && --it->second.count == 0) store_lines_.erase(it);
+  }
+}
+
+// write combining: fold posted STORE w into the youngest queued STORE t (Fifo: not issued, FrFcfs: not picked) if
+// both fit one kMaxBurstBytes-aligned block and no LOAD queued after t reads w's bytes (it must not see them early).
+// t grows to span both; bytes neither wrote stay disabled in its be.
+bool MemCtrl::combine_store(const MemReq& w) {
+  const uint64_t w0 = (uint64_t)(u64)w.addr, w1 = w0 + (u16)w.size;
+  const size_t stop = pipe_.size() > kCombineWindow ? pipe_.size() - kCombineWindow : 0;
+  for (size_t j = pipe_.size(); j-- > stop;) {
+    MemReq &t = pipe_[j].r;
+    const uint64_t t0 = (uint64_t)(u64)t.addr, t1 = t0 + (u16)t.size;
+    if (!t.write) {
+      if (!(w1 <= t0 || t1 <= w0)) return false;             // a younger LOAD reads these bytes
+      continue;
+    }
+    const uint64_t lo = std::min(t0, w0), hi = std::max(t1, w1);
+    if (lo / kMaxBurstBytes != (hi - 1u) / kMaxBurstBytes) return false;
+    MemReq m = t;
+    m.addr = (u64)lo;
+    m.size = (u16)(hi - lo);
+    uint64_t be = 0;
+    for (uint32_t b = 0; b < kMaxBeats; ++b) m.set_wbeat(b, 0);
+    for (uint32_t i = 0; i < t1 - t0; ++i) {
+      if (!t.byte_en(i)) continue;
+      m.set_wbyte((uint32_t)(t0 - lo) + i, t.wbyte(i));
+      be |= 1ull << (t0 - lo + i);
+    }
+    for (uint32_t i = 0; i < w1 - w0; ++i) {                  // w is younger: its bytes win
+      if (!w.byte_en(i)) continue;
+      m.set_wbyte((uint32_t)(w0 - lo) + i, w.wbyte(i));
+      be |= 1ull << (w0 - lo + i);
+    }
+    m.be = (u64)be;
+    for (uint64_t b = lo >> 3; b <= (hi - 1u) >> 3; ++b) {    // t now spans every beat in lo..hi (gaps too): drop_store
+      if (b < (t0 >> 3) || b > ((t1 - 1u) >> 3)) store_lines_[b].count++; // will take one off each
+    }
+    merge_store_bytes(w);
+    t = m;
+    combined_++;
+    return true;
+  }
+  return false;
+}
+
+// deal with LOAD = queued STORE (store hazard).  Returns true if the LOAD touches a pending STORE; `out` gets the
+// data only if pending STOREs wrote every byte of the LOAD (fwd=true).  Otherwise the LOAD goes to DRAM behind
+// those STOREs, which the queue order (FrFcfs: blocked_by_older) keeps correct.
+bool MemCtrl::find_pending_store(const MemReq& r, MemResp& out, bool& fwd) const {
+  fwd = false;
+  const uint64_t a0 = (uint64_t)(u64)r.addr, n = (u16)r.size;
+  if (n == 0 || store_lines_.empty()) return false;      // empty LOAD size is a miss
+  bool touched = false, all = true;
+  for (uint64_t b = a0 >> 3; b <= (a0 + n - 1u) >> 3; ++b) {
+    auto it = store_lines_.find(b);
+    if (it == store_lines_.end()) { all = false; continue; }
+    touched = true;
+    if (!all) continue;
+    const uint64_t lo = std::max(a0, b * 8u), hi = std::min(a0 + n, b * 8u + 8u);
+    for (uint64_t a = lo; a < hi; ++a) {
+      const uint32_t k = (uint32_t)(a & 7u);
+      if (!((it->second.mask >> k) & 1u)) { all = false; break; }
+      out.set_rbyte((uint32_t)(a - a0), (uint8_t)(it->second.data >> (8u * k)));
+    }
+  }
+  fwd = touched && all;
+  return touched;
+}
+
+void MemCtrl::print_store_stats() const {
+  printf("[MCSTORE] stores=%llu combined=%llu dram_writes=%llu load_fwd=%llu load_partial=%llu write_combining=%s\n",
+         (unsigned long long)stores_,
+         (unsigned long long)combined_,
+         (unsigned long long)drained_,
+         (unsigned long long)load_fwd_,
+         (unsigned long long)load_partial_,
+         wc_ ? "on" : "off");
 }
 
 // true when no STOREs remain in the latency queue (used for fences)
 bool MemCtrl::writes_empty() const {
-  for (const auto &q : pipe_) if (q.r.write) return false; // if any queued request is a store, not empty
-  return true;                                             // otherwise all stores are drained
+  return pending_writes_ == 0;
 }
 
 } // namespace smem
@@ -3,11 +3,12 @@
 // **********************************************************************
 // Sebastian Claudiusz Magierowski Feb 9 2026
 /*
-Timed single-outstanding MemoryPort wrapper.
+Timed fixed-latency MemoryPort wrapper (one or more requests outstanding).
 */
 #include "smem/MemCtrlTimedPort.hpp"
 
 #include <cascade/Cascade.hpp>
+#include "smem/MemTypes.hpp"
 
 namespace smem {
 
@@ -29,53 +30,130 @@ void MemCtrlTimedPort::write32(uint32_t addr, uint32_t value) {
   backing_->write32(addr, value);
 }
 
+bool MemCtrlTimedPort::get_direct(uint32_t addr, DirectRegion* out, bool write) {
+  return backing_->get_direct(addr, out, write);
+}
+
+void MemCtrlTimedPort::set_max_outstanding(uint32_t n) {
+  assert_always(n >= 1 && n <= kMaxOutstanding, "MemCtrlTimedPort max_outstanding must be 1..kMaxOutstanding");
+  assert_always(req_count_ == 0 && resp_count_ == 0, "MemCtrlTimedPort max_outstanding changed while busy");
+  max_outstanding_ = n;
+}
+
+void MemCtrlTimedPort::set_dram_timing(const DramTiming::Config& cfg) {
+  assert_always(req_count_ == 0 && resp_count_ == 0, "MemCtrlTimedPort DRAM timing changed while busy");
+  timing_ = std::make_unique<DramTiming>(cfg);
+}
+
 void MemCtrlTimedPort::cycle() {
-  if (in_flight_ && cnt_ > 0) {
-    --cnt_;
+  now_++;
+  for (uint32_t k = 0; k < req_count_; ++k) {
+    Req& r = reqs_[(req_head_ + k) % kMaxOutstanding];
+    if (r.cnt > 0) --r.cnt;
   }
-  if (in_flight_ && cnt_ == 0 && !resp_valid_) {
-    if (is_write_) {
-      backing_->write32(req_addr_, req_wdata_);
-      resp_data_ = 0;
+  while (req_count_ != 0 && reqs_[req_head_].cnt == 0) { // in order: with DRAM timing a younger ready one waits
+    const Req& r = reqs_[req_head_];
+    Resp& out = resps_[(resp_head_ + resp_count_) % kMaxOutstanding];
+    if (r.is_write) {
+      if (r.bytes == 4u) {
+        backing_->write32(r.addr, r.wdata);
+      } else {                                           // byte write: merge into the word as it lands
+        const uint32_t shift = (r.addr & 0x3u) * 8u;
+        const uint32_t mask  = ((1u << (8u * r.bytes)) - 1u) << shift;
+        const uint32_t word  = backing_->read32(r.addr & ~0x3u);
+        backing_->write32(r.addr & ~0x3u, (word & ~mask) | ((r.wdata << shift) & mask));
+      }
+      out.data = 0;
+    } else if (r.line_words != 0) {
+      for (uint32_t i = 0; i < r.line_words; ++i) out.line[i] = backing_->read32(r.addr + 4u * i);
+      out.data = out.line[0];
     } else {
-      resp_data_ = backing_->read32(req_addr_);
+      out.data = backing_->read32(r.addr);
     }
-    resp_valid_ = true;
-    in_flight_ = false;
+    out.tag = r.tag;
+    resp_count_++;
+    req_head_ = (req_head_ + 1u) % kMaxOutstanding;
+    req_count_--;
   }
 }
 
 bool MemCtrlTimedPort::can_request() const {
-  return !in_flight_ && !resp_valid_;
+  return req_count_ + resp_count_ < max_outstanding_;
+}
+
+void MemCtrlTimedPort::issue(const Req& r) {
+  Req& slot = reqs_[(req_head_ + req_count_) % kMaxOutstanding];
+  slot = r;
+  slot.cnt = latency_;
+  if (timing_) { // access starts once the front-end latency is up
+    const uint32_t bytes = r.line_words != 0 ? 4u * r.line_words : (r.is_write ? r.bytes : 4u);
+    const uint64_t done = timing_->access(r.addr, bytes, r.is_write, now_ + static_cast<uint64_t>(latency_), kSrcCore);
+    slot.cnt = static_cast<int>(done - now_);
+  }
+  req_count_++;
 }
 // Enqueue a read or write request with the given address (and data for write). The response will be available after latency_cycles have passed and can be checked with resp_valid()/resp_data() and consumed with resp_consume().
 void MemCtrlTimedPort::request_read32(uint32_t addr) {
+  request_read32_tagged(addr, 0);
+}
+
+void MemCtrlTimedPort::request_read32_tagged(uint32_t addr, uint32_t tag) {
   assert_always(can_request(), "MemCtrlTimedPort read request issued while busy");
-  in_flight_ = true;
-  is_write_ = false;
-  req_addr_ = addr;
-  cnt_ = latency_;
+  Req r;
+  r.addr = addr;
+  r.tag = tag;
+  issue(r);
+}
+
+void MemCtrlTimedPort::request_read_line(uint32_t addr, uint32_t bytes) {
+  assert_always(can_request(), "MemCtrlTimedPort line request issued while busy");
+  assert_always(bytes >= 4u && bytes <= kMaxLineBytes && (bytes & (bytes - 1u)) == 0u && (addr & (bytes - 1u)) == 0u,
+                "MemCtrlTimedPort line read must be an aligned power-of-two line of at most kMaxLineBytes");
+  Req r;
+  r.addr = addr;
+  r.line_words = bytes / 4u;
+  issue(r);
 }
 
 void MemCtrlTimedPort::request_write32(uint32_t addr, uint32_t value) {
+  request_write32_tagged(addr, value, 0);
+}
+
+void MemCtrlTimedPort::request_write32_tagged(uint32_t addr, uint32_t value, uint32_t tag) {
+  assert_always(can_request(), "MemCtrlTimedPort write request issued while busy");
+  Req r;
+  r.is_write = true;
+  r.addr = addr;
+  r.wdata = value;
+  r.tag = tag;
+  issue(r);
+}
+
+void MemCtrlTimedPort::request_write_bytes_tagged(uint32_t addr, uint32_t value, uint32_t bytes, uint32_t tag) {
   assert_always(can_request(), "MemCtrlTimedPort write request issued while busy");
-  in_flight_ = true;
-  is_write_ = true;
-  req_addr_ = addr;
-  req_wdata_ = value;
-  cnt_ = latency_;
+  assert_always((bytes == 1u || bytes == 2u || bytes == 4u) && (addr & (bytes - 1u)) == 0u,
+                "MemCtrlTimedPort byte write must be 1, 2 or 4 naturally aligned bytes");
+  Req r;
+  r.is_write = true;
+  r.addr = addr;
+  r.wdata = value;
+  r.bytes = bytes;
+  r.tag = tag;
+  issue(r);
 }
 
 bool MemCtrlTimedPort::resp_valid() const {
-  return resp_valid_;
+  return resp_count_ != 0;
 }
 
 uint32_t MemCtrlTimedPort::resp_data() const {
-  return resp_data_;
+  return resps_[resp_head_].data;
 }
 
 void MemCtrlTimedPort::resp_consume() {
-  resp_valid_ = false;
+  if (resp_count_ == 0) return;
+  resp_head_ = (resp_head_ + 1u) % kMaxOutstanding;
+  resp_count_--;
 }
 
 } // namespace smem
@@ -0,0 +1,192 @@
+// **********************************************************************
+// smem/src/MemTrace.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Delta/varint encoder and decoder for the MemTrace format, on top of zlib's gz
+stream API.  Records go into a 64KB buffer first so the gz layer sees a few
+large writes instead of one per instruction.
+*/
+
+#include "smem/MemTrace.hpp"
+
+#include <cascade/Cascade.hpp>
+#include <cstring>
+#include <zlib.h>
+
+namespace smem {
+
+namespace {
+constexpr char kMagic[4] = {'S', 'M', 'T', 'R'};
+
+inline uint32_t zigzag(int32_t v)    { return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+inline int32_t  unzigzag(uint32_t u) { return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1u); }
+
+inline uint8_t size_code(uint8_t size) { return size >= 4 ? 2u : (size == 2 ? 1u : 0u); }
+} // namespace
+
+const char* MemTrace::kind_name(Kind k) {
+  switch (k) {
+    case Kind::Alu:    return "alu";
+    case Kind::Mul:    return "mul";
+    case Kind::Load:   return "load";
+    case Kind::Store:  return "store";
+    case Kind::Branch: return "branch";
+    case Kind::Jump:   return "jump";
+    case Kind::Simd:   return "simd";
+    case Kind::Custom: return "custom";
+    case Kind::System: return "system";
+    default:           return "other";
+  }
+}
+
+// ----- writer -----
+bool MemTraceWriter::open(const std::string& path, std::string* err) {
+  close();
+  gzFile f = gzopen(path.c_str(), "wb1"); // level 1: the trace is written while the core runs
+  if (!f) {
+    if (err) *err = "cannot open trace for writing: " + path;
+    return false;
+  }
+  gz_ = f;
+  buf_.clear();
+  buf_.reserve(MemTrace::kBufBytes);
+  prev_pc_ = prev_addr_ = 0;
+  records_ = mem_records_ = raw_bytes_ = file_bytes_ = 0;
+  buf_.insert(buf_.end(), kMagic, kMagic + 4);
+  for (int i = 0; i < 4; ++i) buf_.push_back(static_cast<uint8_t>(MemTrace::kVersion >> (8 * i)));
+  return true;
+}
+
+void MemTraceWriter::put_varint(int32_t v) {
+  uint32_t u = zigzag(v);
+  while (u >= 0x80u) {
+    buf_.push_back(static_cast<uint8_t>(u | 0x80u));
+    u >>= 7;
+  }
+  buf_.push_back(static_cast<uint8_t>(u));
+}
+
+void MemTraceWriter::record(uint32_t pc, MemTrace::Kind kind, uint32_t addr, uint8_t size) {
+  if (!gz_) return;
+  const bool seq = pc == prev_pc_ + 4u;
+  const bool mem = MemTrace::is_mem(kind);
+  uint8_t head = static_cast<uint8_t>(kind) & 0x0fu;
+  if (seq) head |= 0x10u;
+  if (mem) head |= static_cast<uint8_t>(size_code(size) << 5);
+  const size_t before = buf_.size();
+  buf_.push_back(head);
+  if (!seq) put_varint(static_cast<int32_t>(pc - (prev_pc_ + 4u)));
+  if (mem) {
+    put_varint(static_cast<int32_t>(addr - prev_addr_));
+    prev_addr_ = addr;
+    mem_records_++;
+  }
+  prev_pc_ = pc;
+  records_++;
+  raw_bytes_ += buf_.size() - before;
+  if (buf_.size() + 16 > MemTrace::kBufBytes) flush(); // a record is at most 11 bytes
+}
+
+void MemTraceWriter::flush() {
+  if (!gz_ || buf_.empty()) return;
+  const int n = gzwrite(static_cast<gzFile>(gz_), buf_.data(), static_cast<unsigned>(buf_.size()));
+  assert_always(n == static_cast<int>(buf_.size()), "MemTraceWriter: gzwrite failed");
+  buf_.clear();
+}
+
+void MemTraceWriter::close() {
+  if (!gz_) return;
+  flush();
+  gzFile f = static_cast<gzFile>(gz_);
+  gzflush(f, Z_FINISH);
+  file_bytes_ = static_cast<uint64_t>(gzoffset(f));
+  gzclose(f);
+  gz_ = nullptr;
+}
+
+// ----- reader -----
+bool MemTraceReader::open(const std::string& path, std::string* err) {
+  close();
+  gzFile f = gzopen(path.c_str(), "rb");
+  if (!f) {
+    if (err) *err = "cannot open trace: " + path;
+    return false;
+  }
+  gzbuffer(f, static_cast<unsigned>(MemTrace::kBufBytes));
+  gz_ = f;
+  buf_.resize(MemTrace::kBufBytes);
+  pos_ = len_ = 0;
+  prev_pc_ = prev_addr_ = 0;
+  uint8_t hdr[8] = {};
+  for (uint8_t& b : hdr) {
+    if (!get_byte(&b)) break;
+  }
+  uint32_t version = 0;
+  for (int i = 0; i < 4; ++i) version |= static_cast<uint32_t>(hdr[4 + i]) << (8 * i);
+  if (std::memcmp(hdr, kMagic, 4) != 0 || version != MemTrace::kVersion) {
+    if (err) *err = "not a version-1 SMTR trace: " + path;
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool MemTraceReader::get_byte(uint8_t* b) {
+  if (pos_ == len_) {
+    if (!gz_) return false;
+    const int n = gzread(static_cast<gzFile>(gz_), buf_.data(), static_cast<unsigned>(buf_.size()));
+    if (n <= 0) return false;
+    len_ = static_cast<size_t>(n);
+    pos_ = 0;
+  }
+  *b = buf_[pos_++];
+  return true;
+}
+
+bool MemTraceReader::get_varint(int32_t* v) {
+  uint32_t u = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    uint8_t b = 0;
+    if (!get_byte(&b)) return false;
+    u |= static_cast<uint32_t>(b & 0x7fu) << shift;
+    if (!(b & 0x80u)) {
+      *v = unzigzag(u);
+      return true;
+    }
+  }
+  return false; // malformed
+}
+
+bool MemTraceReader::next(MemTrace::Rec* out) {
+  uint8_t head = 0;
+  if (!get_byte(&head)) return false;
+  out->kind = static_cast<MemTrace::Kind>(head & 0x0fu);
+  int32_t d = 0;
+  if (head & 0x10u) {
+    out->pc = prev_pc_ + 4u;
+  } else {
+    if (!get_varint(&d)) return false;
+    out->pc = prev_pc_ + 4u + static_cast<uint32_t>(d);
+  }
+  prev_pc_ = out->pc;
+  if (MemTrace::is_mem(out->kind)) {
+    if (!get_varint(&d)) return false;
+    out->addr = prev_addr_ + static_cast<uint32_t>(d);
+    out->size = static_cast<uint8_t>(1u << ((head >> 5) & 0x3u));
+    prev_addr_ = out->addr;
+  } else {
+    out->addr = 0;
+    out->size = 0;
+  }
+  return true;
+}
+
+void MemTraceReader::close() {
+  if (!gz_) return;
+  gzclose(static_cast<gzFile>(gz_));
+  gz_ = nullptr;
+  pos_ = len_ = 0;
+}
+
+} // namespace smem
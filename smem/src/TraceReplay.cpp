@@ -0,0 +1,77 @@
+// **********************************************************************
+// smem/src/TraceReplay.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+
+#include "smem/TraceReplay.hpp"
+
+namespace smem {
+
+TraceReplay::TraceReplay(std::string /*name*/, IMPL_CTOR) {
+  UPDATE(update_issue).writes(m_req);
+  UPDATE(update_retire).reads(m_resp);
+}
+
+bool TraceReplay::open(const std::string& path, std::string* err) {
+  if (!reader_.open(path, err)) return false;
+  trace_done_ = false;
+  have_rec_ = false;
+  return true;
+}
+
+void TraceReplay::set_max_outstanding(uint32_t n) {
+  assert_always(n >= 1, "TraceReplay: max_outstanding must be >= 1");
+  max_outstanding_ = n;
+}
+
+void TraceReplay::update_issue() {
+  cyc_++;
+  if (done()) return;
+  // Next record to play; full speed skips straight past non-memory ones
+  while (!have_rec_ && !trace_done_) {
+    if (!reader_.next(&rec_)) { trace_done_ = true; break; }
+    records_++;
+    if (MemTrace::is_mem(rec_.kind)) { have_rec_ = true; break; }
+    if (paced_) return;             // this instruction's cycle
+  }
+  if (!have_rec_) return;
+  if (pending_.size() >= max_outstanding_ || m_req.full()) { blocked_++; return; }
+
+  const bool is_load = rec_.kind == MemTrace::Kind::Load;
+  MemReq r{};
+  r.addr  = (u64)(base_ + static_cast<uint64_t>(rec_.addr));
+  r.size  = (u16)(rec_.size ? rec_.size : 4u);
+  r.write = !is_load;
+  r.wdata = (u64)0;
+  r.id    = (u16)next_id_;
+  pending_[next_id_] = Pending{is_load, cyc_};
+  next_id_++;
+  m_req.push(r);
+  if (is_load) loads_++; else stores_++;
+  have_rec_ = false;
+}
+
+void TraceReplay::update_retire() {
+  if (!m_resp.empty()) {
+    auto rr = m_resp.pop();
+    auto it = pending_.find((uint16_t)rr.id);
+    if (it != pending_.end()) {
+      if (it->second.is_load) {
+        const uint64_t lat = cyc_ - it->second.sent_cyc;
+        load_lat_sum_ += lat;
+        if (lat > load_lat_max_) load_lat_max_ = lat;
+      }
+      pending_.erase(it);
+    }
+  }
+}
+
+void TraceReplay::reset() {
+  cyc_ = 0;
+  next_id_ = 0;
+  pending_.clear();
+  records_ = loads_ = stores_ = 0;
+  load_lat_sum_ = load_lat_max_ = blocked_ = 0;
+}
+
+} // namespace smem
@@ -22,13 +22,14 @@ void DmaReader::updateRequest() {
 
   active_ = req_in.pop();
   const auto bytes = static_cast<std::uint16_t>(active_.cols);
-  assert_always(bytes > 0 && bytes <= sizeof(std::uint64_t), "DmaReader currently supports one 1-to-8-byte row");
+  assert_always(bytes > 0 && bytes <= smem::kMaxBurstBytes && bytes <= DmaReadData{}.size(), "DmaReader supports one row of 1 to kMaxBurstBytes bytes");
 
   smem::MemReq req{};
   req.addr = active_.vaddr;
   req.size = u16(bytes);
   req.write = false;
   req.id = active_.cmd_id;
+  req.src = u8(smem::kSrcDma);
   mem_req.push(req);
   waiting_ = true;
 
@@ -49,9 +50,9 @@ void DmaReader::updateResponse() {
 
   const auto bytes = static_cast<std::uint16_t>(active_.cols);
   DmaReadResp dma_resp{};
-  dma_resp.data          = packDmaReadData(resp.rdata);
+  smem::get_rbytes(resp, dma_resp.data.data(), bytes); // whole row, one burst
   dma_resp.laddr         = active_.laddr;
-  dma_resp.mask          = u8(bytes == 8 ? 0xffu : ((1u << bytes) - 1u));
+  dma_resp.mask          = u8(bytes >= 8 ? 0xffu : ((1u << bytes) - 1u));
   dma_resp.has_acc_bitwidth = active_.has_acc_bitwidth;
   dma_resp.scale         = active_.scale;
   dma_resp.repeats       = active_.repeats;
@@ -10,20 +10,6 @@ Store-side DMA writer skeleton implementation.
 
 namespace smesh {
 
-namespace {
-
-// Writer currently extracts the low 64 bits since smem::MemReq still has u64 data fields
-std::uint64_t low64(const StWriterData& data) {
-  // TODO: remove this adapter once the external memory write packet carries a full store row.
-  std::uint64_t value = 0;
-  for (std::size_t i = 0; i < data.size() && i < sizeof(value); ++i) {
-    value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
-  }
-  return value;
-}
-
-} // namespace
-
 DmaWriter::DmaWriter(std::string /*name*/, IMPL_CTOR) {
   UPDATE(updateReady).writes(req_rdy);
   UPDATE(update).reads(req_val, req_bits).writes(mem_req);
@@ -44,8 +30,12 @@ void DmaWriter::update() {
   req.addr = issue.vaddr;
   req.write = true;
   req.size = writer_req.len_bytes;
+  assert_always(static_cast<std::uint32_t>(writer_req.len_bytes) <= smem::kMaxBurstBytes, "DmaWriter store row larger than kMaxBurstBytes");
   req.id = issue.cmd_id;
-  req.wdata = writer_req.data_is_all_zeros ? u64(0) : u64(low64(writer_req.data));
+  req.src = u8(smem::kSrcDma);
+  if (!writer_req.data_is_all_zeros) { // whole row as one burst (beats default to zero)
+    smem::set_wbytes(req, writer_req.data.data(), static_cast<std::uint32_t>(writer_req.len_bytes));
+  }
   mem_req.push(req);
   trace("dma_writer: store vaddr=0x%llx data=0x%llx cmd_id=%u",
         static_cast<unsigned long long>(req.addr),
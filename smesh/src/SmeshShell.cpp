@@ -9,6 +9,7 @@ Cascade component wrapping the existing SmeshDevice, and SmeshMemory, and SmeshR
 
 #include "SmeshCommand.hpp"
 
+#include <cstring>
 #include <exception>
 
 namespace smesh {
@@ -164,7 +165,13 @@ void SmeshShell::startExternalMvin(SmeshFunct funct, std::uint64_t rs1, std::uin
         static_cast<unsigned long long>(active_.shape.rows),
         static_cast<unsigned long long>(active_.shape.cols));
 }
-// 2) sends one read when m_req has space
+// columns the next mvin/mvout burst covers: the rest of the row, up to one kMaxBurstBytes burst
+std::uint32_t SmeshShell::burstCols(std::size_t elem_bytes) const {
+  const auto left = static_cast<std::uint32_t>(active_.shape.cols) - active_.c;
+  const auto max = static_cast<std::uint32_t>(smem::kMaxBurstBytes / elem_bytes);
+  return left < max ? left : max;
+}
+// 2) sends one burst read (a row, or kMaxBurstBytes of it) when m_req has space
 void SmeshShell::updateExternalMvinIssue() {
   if (active_.r >= active_.shape.rows) {
     finishActive(0);
@@ -176,9 +183,10 @@ void SmeshShell::updateExternalMvinIssue() {
 
   smem::MemReq req{};
   req.addr = u64(active_.dram_addr + active_.r * active_.stride_bytes + active_.c * sizeof(Elem));
-  req.size = u16(sizeof(Elem));
+  req.size = u16(burstCols(sizeof(Elem)) * sizeof(Elem));
   req.write = false;
   req.id = u16(active_.next_id++);
+  req.src = u8(smem::kSrcDma);
   m_req.push(req);
   state_ = State::MvinWait;
 }
@@ -194,10 +202,16 @@ void SmeshShell::updateExternalMvinWait() {
     return;
   }
 
-  const auto value = static_cast<Elem>(static_cast<std::uint64_t>(resp.rdata) & 0xffu);
-  device_.writeSpadElem(active_.local_row + active_.r, active_.c, value);
+  const auto cols = burstCols(sizeof(Elem));
+  std::uint8_t bytes[smem::kMaxBurstBytes] = {};
+  smem::get_rbytes(resp, bytes, cols * static_cast<std::uint32_t>(sizeof(Elem)));
+  for (std::uint32_t k = 0; k < cols; ++k) {
+    Elem value{};
+    std::memcpy(&value, bytes + k * sizeof(Elem), sizeof(Elem));
+    device_.writeSpadElem(active_.local_row + active_.r, active_.c + k, value);
+  }
 
-  ++active_.c;
+  active_.c += cols;
   if (active_.c >= active_.shape.cols) {
     active_.c = 0;
     ++active_.r;
@@ -221,7 +235,7 @@ void SmeshShell::startExternalMvout(std::uint64_t rs1, std::uint64_t rs2, SmeshR
         static_cast<unsigned long long>(active_.shape.rows),
         static_cast<unsigned long long>(active_.shape.cols));
 }
-// 2) sends one write when m_req has space
+// 2) sends one burst write (a row, or kMaxBurstBytes of it) when m_req has space
 void SmeshShell::updateExternalMvoutIssue() {
   if (active_.r >= active_.shape.rows) {
     finishActive(0);
@@ -232,12 +246,18 @@ void SmeshShell::updateExternalMvoutIssue() {
   }
 
   smem::MemReq req{};
-  const auto value = device_.readAccElem(active_.local_row + active_.r, active_.c);
+  const auto cols = burstCols(sizeof(Acc));
+  std::uint8_t bytes[smem::kMaxBurstBytes] = {};
+  for (std::uint32_t k = 0; k < cols; ++k) {
+    const auto value = device_.readAccElem(active_.local_row + active_.r, active_.c + k);
+    std::memcpy(bytes + k * sizeof(Acc), &value, sizeof(Acc));
+  }
   req.addr = u64(active_.dram_addr + active_.r * active_.stride_bytes + active_.c * sizeof(Acc));
-  req.size = u16(sizeof(Acc));
+  req.size = u16(cols * sizeof(Acc));
   req.write = true;
-  req.wdata = u64(static_cast<std::uint32_t>(value));
+  smem::set_wbytes(req, bytes, cols * static_cast<std::uint32_t>(sizeof(Acc)));
   req.id = u16(active_.next_id++);
+  req.src = u8(smem::kSrcDma);
   m_req.push(req);
   state_ = State::MvoutWait;
 }
@@ -253,7 +273,7 @@ void SmeshShell::updateExternalMvoutWait() {
     return;
   }
 
-  ++active_.c;
+  active_.c += burstCols(sizeof(Acc));
   if (active_.c >= active_.shape.cols) {
     active_.c = 0;
     ++active_.r;
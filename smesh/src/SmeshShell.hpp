@@ -77,6 +77,7 @@ class SmeshShell : public Component {
   // ********** MEMORY SEQUENCER BEHAVIOR **********
 
   void startExternalMvin(SmeshFunct funct, std::uint64_t rs1, std::uint64_t rs2, SmeshRsTag rs_tag);
+  std::uint32_t burstCols(std::size_t elem_bytes) const;
   void updateExternalMvinIssue();
   void updateExternalMvinWait();
   void startExternalMvout(std::uint64_t rs1, std::uint64_t rs2, SmeshRsTag rs_tag);
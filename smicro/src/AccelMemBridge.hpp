@@ -7,9 +7,10 @@ Tiny MemCtrl client shim for accelerators to facilitate more realistic SoC-memor
 
 Sits on the smem::MemReq/smem::MemResp protocol boundary (same as RvCore / MemTester).
 Accelerator (or other host) calls start_load32/start_store32(), and this bridge
-converts those 32-bit operations into MemCtrl-compatible 8-byte smem::MemReq traffic.
-Load32 issues one aligned 64-bit load and selects a 32-bit lane.
-Store32 performs an internal RMW sequence (load64 -> merge lane -> store64).
+converts those 32-bit operations into MemCtrl smem::MemReq traffic.
+Load32 issues one 4-byte load.
+Store32 issues one 4-byte store (MemCtrl takes byte-enabled partial stores, so
+no read-modify-write).
 
   host API 
   (how AccelArraySumSoc.cpp talks to this bridge)
@@ -31,8 +32,7 @@ update()             |   |                                      |   |
 ---------------------+   +--------------------------------------+   +----------
 
 Notes / v1 constraints:
-- Single-outstanding: one host operation at a time; internal RMW uses sequential
-  requests while the bridge remains busy.
+- Single-outstanding: one host operation at a time, one MemReq per operation.
 - Blocking-style completion: resp_valid() stays true until resp_consume().
 - Stores also wait for a smem::MemResp "ack" (assumes MemCtrl returns a completion resp).
 - The Tile1 core in smicro is *not* on this MemCtrl path yet; Tile1Core still talks
@@ -80,10 +80,10 @@ private:
 
   enum class Phase : uint8_t {
     IDLE,
-    ISSUE_LOAD64,
-    WAIT_LOAD64_RESP,
-    ISSUE_STORE64,
-    WAIT_STORE64_ACK
+    ISSUE_LOAD,
+    WAIT_LOAD_RESP,
+    ISSUE_STORE,
+    WAIT_STORE_ACK
   };
 
   OpKind op_kind_ = OpKind::NONE;
@@ -94,7 +94,6 @@ private:
   uint64_t aligned_addr_ = 0;
   bool upper_lane_       = false; // false: [31:0], true: [63:32]
   uint32_t store_data32_ = 0;     // used for STORE32
-  uint64_t rmw_word64_   = 0;     // merged store payload after RMW load
 
   // Sticky response latch (must be consumed explicitly)
   bool resp_valid_    = false;
@@ -16,10 +16,16 @@ void MemTester::clear_script() { script_.clear(); pc_ = 0; }
 void MemTester::clear_results() { results_.clear(); pending_.clear(); }
 
 void MemTester::enqueue_store(uint64_t addr, uint64_t data, uint16_t size) {
-  script_.push_back(Op{STORE, addr, data, size});
+  script_.push_back(Op{STORE, addr, data, size, ~0ull, {}});
 }
 void MemTester::enqueue_load(uint64_t addr, uint16_t size) {
-  script_.push_back(Op{LOAD, addr, 0ull, size});
+  script_.push_back(Op{LOAD, addr, 0ull, size, ~0ull, {}});
+}
+void MemTester::enqueue_store_burst(uint64_t addr, const uint8_t* src, uint16_t size, uint64_t be) {
+  assert_always(size >= 1 && size <= smem::kMaxBurstBytes, "MemTester: burst size must be 1..kMaxBurstBytes");
+  Op op{STORE, addr, 0ull, size, be, {}};
+  op.bytes.assign(src, src + size);
+  script_.push_back(op);
 }
 
 void MemTester::update_issue() {
@@ -36,6 +42,8 @@ void MemTester::update_issue() {
     if (op.kind == STORE) {
       r.write = true;
       r.wdata = (u64)op.data;
+      r.be    = (u64)op.be;
+      if (!op.bytes.empty()) smem::set_wbytes(r, op.bytes.data(), (uint32_t)op.bytes.size());
       pending_[r.id] = Pending{false, cyc_};
     } else {
       r.write = false;
@@ -57,6 +65,7 @@ void MemTester::update_retire() {
       e.sent_cyc = it->second.sent_cyc;
       e.resp_cyc = cyc_;
       e.rdata = rr.rdata;
+      e.resp = rr;
       results_.push_back(e);
       pending_.erase(it);
     }
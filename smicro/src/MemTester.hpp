@@ -22,16 +22,21 @@ public:
 
   // Scripted ops
   enum Kind : uint8_t { LOAD=0, STORE=1 };
-  struct Op { Kind kind; uint64_t addr; uint64_t data; uint16_t size; };
+  struct Op {
+    Kind kind; uint64_t addr; uint64_t data; uint16_t size;
+    uint64_t be = ~0ull;           // store byte enables (MemReq::be)
+    std::vector<uint8_t> bytes;    // burst store data (size bytes); empty = `data`
+  };
 
   // Result record (one per response observed)
-  struct Ev { uint16_t id; bool is_load; uint64_t sent_cyc; uint64_t resp_cyc; u64 rdata; };
+  struct Ev { uint16_t id; bool is_load; uint64_t sent_cyc; uint64_t resp_cyc; u64 rdata; smem::MemResp resp; }; // resp: all beats
 
   // Host helpers to build scripts and inspect results
   void clear_script();
   void clear_results();
   void enqueue_store(uint64_t addr, uint64_t data, uint16_t size=8);
   void enqueue_load(uint64_t addr, uint16_t size=8);
+  void enqueue_store_burst(uint64_t addr, const uint8_t* src, uint16_t size, uint64_t be=~0ull); // up to kMaxBurstBytes
   const std::vector<Ev>& results() const { return results_; }
 
   void update_issue();   // reads internal state, writes m_req
@@ -56,6 +56,9 @@ public:
   void set_mem_latency(int v) { if (mem_) mem_->set_latency(v); }            // set MemCtrl latency in cycles
   void set_dram_latency(int v) { set_mem_latency(v); }                       // back-compat alias
   void set_posted_writes(bool en) { if (mem_) mem_->set_posted_writes(en); } // enable/disable posted write acks
+  void set_dram_timing(const smem::DramTiming::Config& cfg) { if (mem_) mem_->set_dram_timing(cfg); } // bank/row timing behind MemCtrl
+  void set_mem_scheduler(const smem::MemCtrl::SchedConfig& cfg) { if (mem_) mem_->set_scheduler(cfg); } // fifo | frfcfs
+  void set_write_combining(bool en) { if (mem_) mem_->set_write_combining(en); } // merge posted stores in MemCtrl
 
   void attach_accelerator(AccelPort* accel);
 
@@ -45,6 +45,8 @@ public:
   void attach_dram(smem::Dram* dram); // let SoC give Tile1Core a DRAM to talk to
   void attach_accelerator(AccelPort* accel);
   void set_pc(uint32_t pc);
+  Tile1&       tile()       { return tile_; } // e.g. for checkpointing (smile/src/util/Checkpoint.hpp)
+  const Tile1& tile() const { return tile_; }
 
 private:
   Tile1 tile_;                  // the actual RISC-V core (in smile)
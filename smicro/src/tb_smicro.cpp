@@ -35,12 +35,16 @@ cedar/build/smicro % ./smicro <options>
 // **********************************************************************
 #endif
 #include <descore/Parameter.hpp>
+#include <algorithm> // std::sort/std::equal for tester results
 #include <cstddef> // proto_accel_sum needs size_t for vector params
 #include <cstdint> // for uint32_t, etc. in proto_accel_sum
 #include <iostream>
 #include <vector>  // for vector parameters in proto_accel_sum
 #include "SoC.hpp"
 #include "AccelCmd.hpp" 
+#include "util/Checkpoint.hpp"
+#include "smem/DramMemoryPort.hpp"
+#include "smem/MemCtrlTimedPort.hpp"
 
 using namespace std;
 
@@ -50,12 +54,16 @@ using namespace std;
 StringParameter(topo,       "via_l2", "Topology: via_l1|via_l2|dram|priv"); // defaults topo is via_l2
 IntParameter(steps,          0,      "Batch steps; 0=interactive");
 // New single-switch suite
-StringParameter(suite,      "proto_core", "Suite: hal_none|hal_multi|hal_bounds|proto_core|proto_accel_sum|proto_accel_sum_altaddr|proto_accel_sum_badarg|proto_accel_sum_unsupported|proto_accel_sum_twice|proto_raw|proto_no_raw|proto_rar|proto_lat");
+StringParameter(suite,      "proto_core", "Suite: hal_none|hal_multi|hal_bounds|proto_core|proto_accel_sum|proto_accel_sum_altaddr|proto_accel_sum_badarg|proto_accel_sum_unsupported|proto_accel_sum_twice|proto_raw|proto_no_raw|proto_rar|proto_lat|proto_fwd_partial|proto_fwd_unaligned|proto_wc_block|proto_wc_gap|proto_frfcfs|proto_burst");
 IntParameter(mem_latency,     3, "MemCtrl latency (cycles)");
 IntParameter(dram_latency,   -1, "[deprecated] use -mem_latency; if >=0 overrides mem_latency");
 BoolParameter(drain,         false, "After run, fence: keep stepping until posted stores drain");
 BoolParameter(showcontexts,  false, "List component instance names (contexts) and exit");
+StringParameter(checkpoint,  "",     "Batch run (-steps>0): afterwards write a Tile1+DRAM checkpoint here (resume with tb_tile1 -restore)");
 BoolParameter(posted_writes, true, "Enable posted write ACKs (1=posted, 0=ack on drain)");
+BoolParameter(mem_wc,        false, "MemCtrl write combining: merge posted stores into a queued store to the same 64-byte block");
+StringParameter(mem_sched,   "fifo", "MemCtrl scheduler: fifo, or frfcfs[,depth=N][,accept=N][,wr_hi=N][,wr_lo=N][,turnaround=N] (responses out of order, matched by id)");
+StringParameter(dram_timing, "",     "Bank/row-buffer DRAM timing behind MemCtrl: on, or key=value,... (see smem/DramTiming.hpp); empty = fixed -mem_latency only");
 
 static AttachMode parse_mode(const std::string& topo) {
   if (topo == "via_l1") return ViaL1;
@@ -106,6 +114,19 @@ int main (int argc, char *argv[]) {
   int eff_lat = (dram_latency >= 0) ? (int)dram_latency : (int)mem_latency;
   soc.set_mem_latency(eff_lat);
   soc.set_posted_writes(posted_writes);
+  soc.set_write_combining(mem_wc);
+  if (!std::string(dram_timing).empty()) { // latency checks in the proto_* suites assume fixed latency
+    smem::DramTiming::Config dcfg;
+    std::string err;
+    assert_always(smem::DramTiming::parse_config(std::string(dram_timing), &dcfg, &err), err.c_str());
+    soc.set_dram_timing(dcfg);
+  }
+  {
+    smem::MemCtrl::SchedConfig scfg;
+    std::string err;
+    assert_always(smem::MemCtrl::parse_sched(std::string(mem_sched), &scfg, &err), err.c_str());
+    soc.set_mem_scheduler(scfg);
+  }
   
   // **************
   // Step 5: Hook clock and initialize simulator
@@ -377,6 +398,226 @@ int main (int argc, char *argv[]) {
       }
       return true;
     }
+    // results() in script order: every op (posted stores included) answers exactly once, ids go up by one
+    auto by_op = [&]() {
+      std::vector<MemTester::Ev> v = t->results();
+      std::sort(v.begin(), v.end(), [](const MemTester::Ev& a, const MemTester::Ev& b) { return a.id < b.id; });
+      return v;
+    };
+    // little-endian value of n bytes at p (expected load data)
+    auto le = [](const uint8_t* p, int n) { uint64_t v = 0; for (int i = n - 1; i >= 0; --i) v = (v << 8) | p[i]; return v; };
+    uint8_t seed[32];
+    for (int i = 0; i < 32; ++i) seed[i] = static_cast<uint8_t>(0x40 + i);
+    if (s == "proto_fwd_partial") {
+      // Loads only partly covered by pending stores are not forwarded: they queue behind the stores and
+      // read DRAM, which by then holds the store bytes next to the old ones.
+      soc.dram_->write(A, seed, sizeof(seed));
+      soc.set_mem_latency(16); Sim::run(); log("\n");             // stores stay pending over the script
+      t->clear_script(); t->clear_results();
+      t->enqueue_store(A + 4,  0xddccbbaaULL, 4);           // upper half of beat 0
+      t->enqueue_load (A);                                  // beat 0: half covered
+      t->enqueue_store(A + 8,  0x1716151413121110ULL);      // all of beat 1
+      t->enqueue_load (A + 12);                             // beats 1-2: beat 2 not covered
+      for (int i=0;i<30;i++) { Sim::run(); log("\n"); }
+      const auto rs = by_op();
+      assert_always(rs.size() == 4, "fwd_partial: missing responses");
+      uint8_t m[32];
+      std::copy(seed, seed + 32, m);
+      for (int i = 0; i < 4; ++i) m[4 + i] = static_cast<uint8_t>(0xaa + 0x11 * i);
+      for (int i = 0; i < 8; ++i) m[8 + i] = static_cast<uint8_t>(0x10 + i);
+      assert_always(rs[1].resp_cyc > rs[1].sent_cyc && rs[3].resp_cyc > rs[3].sent_cyc, "fwd_partial: partly covered load was forwarded");
+      assert_always((uint64_t)rs[1].rdata == le(m, 8),      "fwd_partial: beat 0 load mismatch");
+      assert_always((uint64_t)rs[3].rdata == le(m + 12, 8), "fwd_partial: beat 1-2 load mismatch");
+      return true;
+    }
+    if (s == "proto_fwd_unaligned") {
+      // Loads of any alignment whose bytes pending stores wrote (across beats, or pieced together from
+      // several sub-word stores) are answered on the spot.
+      soc.set_mem_latency(16); Sim::run(); log("\n");             // stores stay pending over the script
+      t->clear_script(); t->clear_results();
+      t->enqueue_store(A,      0x0706050403020100ULL);
+      t->enqueue_store(A + 8,  0x0f0e0d0c0b0a0908ULL);
+      t->enqueue_store(A + 16, 0x10ULL, 1);
+      t->enqueue_store(A + 17, 0x11ULL, 1);
+      t->enqueue_load (A + 3);                              // 8 bytes over beats 0-1
+      t->enqueue_load (A + 7, 2);                           // 2 bytes straddling beats 0-1
+      t->enqueue_load (A + 16, 2);                          // two byte stores
+      for (int i=0;i<30;i++) { Sim::run(); log("\n"); }
+      const auto rs = by_op();
+      assert_always(rs.size() == 7, "fwd_unaligned: missing responses");
+      for (size_t k = 4; k < 7; ++k) {
+        assert_always(rs[k].resp_cyc == rs[k].sent_cyc, "fwd_unaligned: covered load not forwarded");
+      }
+      assert_always((uint64_t)rs[4].rdata == 0x0a09080706050403ULL, "fwd_unaligned: 8-byte load mismatch");
+      assert_always((uint64_t)rs[5].rdata == 0x0807ULL,             "fwd_unaligned: straddling load mismatch");
+      assert_always((uint64_t)rs[6].rdata == 0x1110ULL,             "fwd_unaligned: byte-store load mismatch");
+      return true;
+    }
+    if (s == "proto_wc_block") {
+      // A store may not combine into an older one while a load queued between them reads its bytes
+      // (the load would see the new data early); with nothing in between it does combine.
+      soc.dram_->write(A, seed, sizeof(seed));
+      soc.set_mem_latency(4); soc.set_write_combining(true); Sim::run(); log("\n");
+      const uint64_t combined0 = soc.mem_->combined_stores();
+      t->clear_script(); t->clear_results();
+      t->enqueue_store(A,     0xa3a2a1a0ULL, 4);
+      t->enqueue_load (A + 4, 4);                           // reads the next store's bytes: queued, not forwarded
+      t->enqueue_store(A + 4, 0xb3b2b1b0ULL, 4);            // blocked by that load
+      t->enqueue_store(A + 8, 0xc3c2c1c0ULL, 4);            // combines with the previous store
+      for (int i=0;i<30;i++) { Sim::run(); log("\n"); }
+      const auto rs = by_op();
+      assert_always(rs.size() == 4, "wc_block: missing responses");
+      assert_always((uint64_t)rs[1].rdata == le(seed + 4, 4), "wc_block: load saw a younger store");
+      assert_always(soc.mem_->combined_stores() - combined0 == 1, "wc_block: expected exactly one combine");
+      assert_always(soc.mem_->writes_empty(), "wc_block: stores did not drain");
+      uint8_t got[16];
+      soc.dram_->read(A, got, sizeof(got));
+      assert_always(le(got, 8) == 0xb3b2b1b0a3a2a1a0ULL && le(got + 8, 4) == 0xc3c2c1c0ULL && le(got + 12, 4) == le(seed + 12, 4),
+                    "wc_block: DRAM contents mismatch");
+      return true;
+    }
+    if (s == "proto_frfcfs") {
+      // The same read/write mix over two rows of one bank and a second bank, in arrival order (Fifo), then under
+      // FrFcfs with a read/write turnaround and no DRAM timing (a write switching the bus must still land before
+      // a younger write to its bytes), then under FrFcfs with DRAM timing (row hits and reads jump ahead).  Every
+      // load must return what it did under Fifo and DRAM must end up the same.
+      const uint64_t R = A + 0x4000, C = A + 0x800;         // default map: R same bank as A, other row; C next bank
+      soc.set_mem_latency(3);
+      struct Step { bool store; uint64_t addr; uint64_t data; uint16_t size; };
+      const std::vector<Step> script = {
+        {false, A, 0, 8},      {false, R, 0, 8},      {false, A + 8, 0, 8},  {true, R + 8, 0x1111111111111111ULL, 8},
+        {false, C, 0, 8},      {false, A + 16, 0, 8}, {true, A + 8, 0x2222222222222222ULL, 8},   // after load A+8
+        {true, A + 8, 0x5555555555555555ULL, 8},       // same bytes again
+        {false, R + 4, 0, 8},  {false, R + 16, 0, 8}, {true, C + 4, 0x33333333ULL, 4},
+        {false, A + 4, 0, 8},  {false, C, 0, 8},      {false, R, 0, 8},      {false, A + 24, 0, 8},
+        {true, R, 0x4444444444444444ULL, 8},           {false, C + 8, 0, 8},  {false, A, 0, 8},      {false, R, 0, 8}};
+      auto pass = [&](smem::MemCtrl::Sched policy, uint32_t turnaround, std::vector<uint64_t>* loads, std::vector<uint8_t>* mem) {
+        for (uint64_t r : {A, R, C}) soc.dram_->write(r, seed, sizeof(seed));
+        smem::MemCtrl::SchedConfig cfg;
+        cfg.policy = policy; cfg.depth = 8; cfg.wr_hi = 4; cfg.wr_lo = 1; cfg.turnaround = turnaround;
+        soc.set_mem_scheduler(cfg);
+        t->clear_script(); t->clear_results();
+        for (const Step& st : script) {
+          if (st.store) t->enqueue_store(st.addr, st.data, st.size); else t->enqueue_load(st.addr, st.size);
+        }
+        for (int i = 0; i < 4000 && (t->results().size() < script.size() || !soc.mem_->writes_empty()); ++i) { Sim::run(); log("\n"); }
+        for (int i = 0; i < 16; ++i) { Sim::run(); log("\n"); }           // last store through Dram
+        const auto rs = by_op();
+        assert_always(rs.size() == script.size(), "frfcfs: missing responses");
+        for (const auto& e : rs) loads->push_back(e.is_load ? (uint64_t)e.rdata : 0);
+        for (uint64_t r : {A, R, C}) {
+          uint8_t got[32];
+          soc.dram_->read(r, got, sizeof(got));
+          mem->insert(mem->end(), got, got + sizeof(got));
+        }
+      };
+      std::vector<uint64_t> fifo_loads, ta_loads, fr_loads;
+      std::vector<uint8_t> fifo_mem, ta_mem, fr_mem;
+      pass(smem::MemCtrl::Sched::Fifo, 0, &fifo_loads, &fifo_mem);
+      pass(smem::MemCtrl::Sched::FrFcfs, 3, &ta_loads, &ta_mem);
+      assert_always(ta_loads == fifo_loads, "frfcfs: load data differs from Fifo (turnaround)");
+      assert_always(ta_mem == fifo_mem, "frfcfs: final DRAM contents differ from Fifo (turnaround)");
+      soc.set_dram_timing(smem::DramTiming::Config{});
+      const uint64_t picks0 = soc.mem_->sched_picks(), reorders0 = soc.mem_->sched_reorders();
+      pass(smem::MemCtrl::Sched::FrFcfs, 0, &fr_loads, &fr_mem);
+      assert_always(fr_loads == fifo_loads, "frfcfs: load data differs from Fifo");
+      assert_always(fr_mem == fifo_mem, "frfcfs: final DRAM contents differ from Fifo");
+      assert_always(soc.mem_->sched_picks() > picks0 && soc.mem_->sched_reorders() > reorders0, "frfcfs: nothing was reordered");
+      return true;
+    }
+    if (s == "proto_burst") {
+      // 16/32/64-byte bursts, aligned or not and with sparse byte enables, through MemCtrl to Dram, read back
+      // with bursts (some while the stores are still pending); then 1/2-byte writes through DramMemoryPort and
+      // MemCtrlTimedPort, which merge them into the word they land in.
+      const uint64_t W = A + 0x40;
+      uint8_t m[0x140];                                     // what the window should hold
+      for (size_t i = 0; i < sizeof(m); ++i) m[i] = static_cast<uint8_t>(i * 7 + 3);
+      soc.dram_->write(W, m, sizeof(m));
+      soc.set_mem_latency(16); Sim::run(); log("\n");             // loads overlap pending stores
+      const uint64_t fwd0 = soc.mem_->loads_forwarded();
+      struct Burst { uint64_t off; uint16_t size; uint64_t be; };
+      const Burst stores[] = {
+        {0x00, 16, 0xa5a5ULL},                              // aligned
+        {0x13, 32, 0xf0f00ff1ULL},                          // unaligned, over a beat boundary
+        {0x41, 64, 0x8000f0f0a5a50001ULL},                  // unaligned kMaxBurstBytes, over a 64-byte block
+        {0x80, 64, 0x00ff00ff00ff00ffULL},
+        {0xc6, 64, 0xfedcba9876543210ULL}};
+      const Burst loads[] = {{0x80, 8, 0}, {0x00, 64, 0}, {0x40, 64, 0}, {0x80, 64, 0}, {0xc0, 64, 0}, {0x100, 64, 0}, {0x0d, 48, 0}, {0x3b, 64, 0}, {0x14, 16, 0}};
+      t->clear_script(); t->clear_results();
+      for (size_t k = 0; k < sizeof(stores) / sizeof(stores[0]); ++k) {
+        const Burst& b = stores[k];
+        uint8_t data[smem::kMaxBurstBytes];
+        for (uint32_t i = 0; i < b.size; ++i) data[i] = static_cast<uint8_t>(0x80 + 0x10 * k + i);
+        t->enqueue_store_burst(W + b.off, data, b.size, b.be);
+        for (uint32_t i = 0; i < b.size; ++i) if ((b.be >> i) & 1ull) m[b.off + i] = data[i];
+      }
+      for (const Burst& b : loads) t->enqueue_load(W + b.off, b.size);
+      const size_t n_ops = sizeof(stores) / sizeof(stores[0]) + sizeof(loads) / sizeof(loads[0]);
+      for (int i = 0; i < 400 && (t->results().size() < n_ops || !soc.mem_->writes_empty()); ++i) { Sim::run(); log("\n"); }
+      for (int i = 0; i < 16; ++i) { Sim::run(); log("\n"); }
+      const auto rs = by_op();
+      assert_always(rs.size() == n_ops, "burst: missing responses");
+      for (size_t k = 0; k < sizeof(loads) / sizeof(loads[0]); ++k) {
+        const Burst& b = loads[k];
+        uint8_t got[smem::kMaxBurstBytes];
+        smem::get_rbytes(rs[sizeof(stores) / sizeof(stores[0]) + k].resp, got, b.size);
+        assert_always(std::equal(got, got + b.size, m + b.off), "burst: burst load data mismatch");
+      }
+      assert_always(soc.mem_->loads_forwarded() > fwd0, "burst: load covered by a pending burst not forwarded");
+      uint8_t dram[sizeof(m)];
+      soc.dram_->read(W, dram, sizeof(dram));
+      assert_always(std::equal(dram, dram + sizeof(dram), m), "burst: DRAM contents mismatch");
+
+      // Sub-word writes: tagged responses in order, merged bytes, neighbours untouched.
+      smem::DramMemoryPort direct(*soc.dram_);
+      smem::MemCtrlTimedPort timed(&direct, 2);
+      timed.set_max_outstanding(4);
+      struct ByteWrite { uint32_t off, value, bytes; };
+      const ByteWrite bws[] = {{1, 0xab, 1}, {2, 0xcdef, 2}, {7, 0x5a, 1}, {4, 0x0706, 2}};
+      uint32_t at = static_cast<uint32_t>(W + sizeof(m) - base);  // port address 0 = DRAM base
+      for (smem::MemoryPort* p : {static_cast<smem::MemoryPort*>(&direct), static_cast<smem::MemoryPort*>(&timed)}) {
+        p->write32(at, 0x44332211u); p->write32(at + 4, 0x88776655u); p->write32(at + 8, 0xdeadbeefu);
+        uint32_t sent = 0, done = 0;
+        for (int c = 0; c < 64 && done < 4; ++c) {
+          if (sent < 4 && p->can_request()) { p->request_write_bytes_tagged(at + bws[sent].off, bws[sent].value, bws[sent].bytes, 10 + sent); sent++; }
+          p->cycle();
+          while (p->resp_valid()) {
+            assert_always(p->resp_tag() == 10 + done, "burst: byte write answered out of order");
+            done++; p->resp_consume();
+          }
+        }
+        assert_always(done == 4, "burst: byte writes not answered");
+        assert_always(p->read32(at) == 0xcdefab11u && p->read32(at + 4) == 0x5a770706u && p->read32(at + 8) == 0xdeadbeefu,
+                      "burst: byte write merge mismatch");
+        at += 16;
+      }
+      return true;
+    }
+    if (s == "proto_wc_gap") {
+      // Write combining across a gap beat: stores to beat 0 and beat 2 merge into one store spanning beat 1.
+      // A younger store to beat 1 (kept out of the merge by the load before it) must stay forwardable after
+      // the merged store drains, i.e. draining it may not take that store's count on beat 1.
+      soc.set_mem_latency(4); soc.set_write_combining(true); Sim::run(); log("\n");
+      t->clear_script(); t->clear_results();
+      t->enqueue_store(A,      0xa1ULL, 1);                 // beat 0
+      t->enqueue_store(A + 16, 0x2222222222222222ULL);      // beat 2: combines with the beat 0 store
+      t->enqueue_load (A + 8);                              // keeps the next store out of the merge
+      t->enqueue_store(A + 8,  0x3333333333333333ULL);      // beat 1
+      t->enqueue_load (base + 0x800);                       // filler: the merged store drains meanwhile
+      t->enqueue_load (A + 8);                              // beat 1 store still pending -> forwarded
+      for (int i=0;i<20;i++) { Sim::run(); log("\n"); }
+      const auto rs = by_op();
+      assert_always(rs.size() == 6, "wc_gap: missing responses");
+      assert_always((int64_t)(rs[5].resp_cyc - rs[5].sent_cyc) == 0, "wc_gap: load of a pending store's beat not forwarded");
+      assert_always((uint64_t)rs[5].rdata == 0x3333333333333333ULL, "wc_gap: forwarded data mismatch");
+      assert_always(soc.mem_->combined_stores() == 1, "wc_gap: expected the beat 0 and beat 2 stores to combine");
+      assert_always(soc.mem_->writes_empty(), "wc_gap: stores did not drain");
+      uint64_t got[3] = {};
+      soc.dram_->read(A, got, sizeof(got));
+      assert_always(got[0] == 0xa1ULL && got[1] == 0x3333333333333333ULL && got[2] == 0x2222222222222222ULL,
+                    "wc_gap: DRAM contents mismatch");
+      return true;
+    }
     return false;
   };
   if (is_proto) {
@@ -400,6 +641,26 @@ int main (int argc, char *argv[]) {
       // Advance until all posted stores drain from MemCtrl (useful for fences)
       while (!soc.mem_->writes_empty()) { Sim::run(); log("\n"); }
     }
+    soc.mem_->print_sched_stats();
+    soc.mem_->print_store_stats();
+    if (const smem::DramTiming* dt = soc.mem_->dram_timing()) dt->print_stats(soc.mem_->cycles());
+    if (!std::string(checkpoint).empty()) {
+      // Settle Tile1 on an instruction boundary, then dump it with the DRAM contents.
+      // Only Tile1 + DRAM are saved (not MemCtrl/L1/L2/accelerator state).
+      Tile1& tile = soc.core_->tile();
+      int extra = 0;
+      for (; extra < 1000 && !tile.quiescent(); ++extra) { Sim::run(); log("\n"); }
+      CheckpointRun run;
+      tile.save_context(run.threads[0]);
+      run.threads[0].active = !tile.halted();
+      run.cycle = static_cast<uint64_t>(steps) + static_cast<uint64_t>(extra);
+      std::string err;
+      CheckpointInfo info;
+      const bool ok_ckpt = save_checkpoint(std::string(checkpoint), tile, *soc.dram_, run, &err, &info);
+      assert_always(ok_ckpt, err.c_str());
+      cout << "[CKPT] wrote " << std::string(checkpoint) << " pc=0x" << hex << tile.pc() << dec
+           << " pages=" << info.pages << " bytes=" << info.file_bytes << endl;
+    }
     return 0;
   }
 
@@ -12,8 +12,8 @@ It logs each request, walks DRAM synchronously via the memory hooks, and exposes
 #pragma once
 
 #include "AccelPort.hpp"
+#include "smem/MemoryPort.hpp"
 
-namespace smem { class MemoryPort; }
 
 // AccelArraySum implements the AccelPort protocol by interpreting CUSTOM-0
 // instructions as "sum an array of 32-bit words from memory".
@@ -37,6 +37,7 @@ public:
 
 private:
   smem::MemoryPort& mem_;
+  smem::DirectAccessor mem_direct_; // untimed accesses (direct region when the port grants one)
   bool has_resp_ = false;
   uint32_t resp_ = 0;
 };
@@ -12,8 +12,8 @@ request/response interface and publishes a sticky response once complete.
 #pragma once
 
 #include "AccelPort.hpp"
+#include "smem/MemoryPort.hpp"
 
-namespace smem { class MemoryPort; }
 
 // AccelArraySumMc implements the AccelPort protocol by interpreting CUSTOM-0
 // instructions as "sum an array of 32-bit words from memory", one load per tick.
@@ -39,6 +39,7 @@ public:
 
 private:
   smem::MemoryPort& mem_;
+  smem::DirectAccessor mem_direct_; // untimed accesses (direct region when the port grants one)
 
   // Accelerator command/response state.
   bool busy_ = false;
@@ -50,6 +51,6 @@ private:
   uint32_t len_ = 0;
   uint32_t idx_ = 0;
   uint32_t sum_ = 0;
-  // True after request_read32() until its response is consumed.
+  // True after request_read32_tagged() until its response is consumed.
   bool waiting_mem_ = false;
 };
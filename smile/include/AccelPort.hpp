@@ -9,6 +9,12 @@ can back this with any Cascade component that exposes custom instruction issue/r
 
 A concrete accelerator will inherit from this class and implement the issue() method
 (and optionally tick()/has_response()/read_response() methods for multi-cycle accelerators).
+
+v2 (decoupled, docs/accel_port.md section 10): a port with supports_queue() takes
+commands through issue_tagged() into a bounded queue and answers with responses
+labelled by resp_tag() (the command's rd).  Tile1 then retires a CUSTOM-0 as soon as
+it is queued and only waits when it needs the result.  AccelQueue puts any v1
+accelerator behind such a queue.
 */
 
 #pragma once
@@ -21,6 +27,8 @@ public:
   static constexpr uint32_t ACCEL_E_UNSUPPORTED = 1u;
   static constexpr uint32_t ACCEL_E_BUSY        = 2u; // reserved
   static constexpr uint32_t ACCEL_E_BADARG      = 3u; // reserved
+  // Tag on accelerator MemoryPort requests (Tile1 uses 0, 1..8 and 0x100 + hart)
+  static constexpr uint32_t kMemTag = 0x80u;
 
   virtual ~AccelPort() = default;
 
@@ -42,6 +50,7 @@ public:
 
   // Optional: true if the accelerator cannot accept a new issue() this cycle.
   // v1 Tile1 does not consult busy(); it uses issue-once + stall on has_response().
+  // v2 Tile1 holds a CUSTOM-0 while busy() (command queue full).
   virtual bool busy() const { return false; }
 
   // Optional response side, if/when you want rd results.
@@ -53,6 +62,13 @@ public:
   // Default stub returns 0 and has no queued-response state.
   virtual uint32_t read_response() { return 0; }
 
+  // v2 decoupled contract; default: v1 (blocking, untagged)
+  virtual bool     supports_queue() const { return false; }
+  virtual void     issue_tagged(uint32_t raw_inst, uint32_t pc, uint32_t rs1_val, uint32_t rs2_val, uint32_t /*tag*/) {
+    issue(raw_inst, pc, rs1_val, rs2_val);
+  }
+  virtual uint32_t resp_tag() const { return 0; } // tag of the response read_response() would return
+
   // --------------------------------------------------------------------
   // Memory access API (RoCC-style, simplified as blocking operations).
   //
@@ -0,0 +1,63 @@
+// **********************************************************************
+// smile/include/AccelQueue.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Decoupled (v2) front end for any v1 accelerator: a bounded command queue in front
+of it and a response queue behind it, each response tagged with its command's rd.
+The wrapped accelerator still sees one issue() at a time; the next command starts
+as soon as it has answered the previous one.  At most depth() commands are in
+flight, counting the queued, the one in service and unread responses, so busy()
+(queue full) is the only back-pressure Tile1 sees.
+*/
+
+#pragma once
+
+#include "AccelPort.hpp"
+
+#include <array>
+#include <cstdint>
+
+class AccelQueue : public AccelPort {
+public:
+  static constexpr uint32_t kMaxDepth = 16;
+
+  AccelQueue(AccelPort& inner, uint32_t depth); // depth 1..kMaxDepth
+
+  // Command path: queued, started when the wrapped accelerator is free
+  void issue(uint32_t raw_inst, uint32_t pc, uint32_t rs1_val, uint32_t rs2_val) override;
+  void issue_tagged(uint32_t raw_inst, uint32_t pc, uint32_t rs1_val, uint32_t rs2_val, uint32_t tag) override;
+  void tick() override;
+  bool busy() const override { return cmd_count_ + (in_service_ ? 1u : 0u) + resp_count_ >= depth_; }
+
+  // Response path: oldest first
+  bool     has_response() const override { return resp_count_ != 0; }
+  uint32_t read_response() override;
+  uint32_t resp_tag() const override { return resps_[resp_head_].tag; }
+  bool     supports_queue() const override { return true; }
+
+  // Memory client view: the wrapped accelerator's
+  uint32_t mem_load32(uint32_t addr) override { return inner_.mem_load32(addr); }
+  void     mem_store32(uint32_t addr, uint32_t data) override { inner_.mem_store32(addr, data); }
+
+  uint32_t depth() const { return depth_; }
+
+private:
+  struct Cmd {
+    uint32_t raw = 0, pc = 0, rs1 = 0, rs2 = 0, tag = 0;
+  };
+  struct Resp {
+    uint32_t data = 0, tag = 0;
+  };
+  void start_next(); // hand the oldest command to the wrapped accelerator if it is free
+  void collect();    // move its response (if any) into the response queue
+
+  AccelPort& inner_;
+  uint32_t   depth_;
+  std::array<Cmd, kMaxDepth>  cmds_{};
+  uint32_t   cmd_head_ = 0, cmd_count_ = 0;
+  std::array<Resp, kMaxDepth> resps_{};
+  uint32_t   resp_head_ = 0, resp_count_ = 0;
+  bool       in_service_ = false;
+  uint32_t   service_tag_ = 0;
+};
@@ -0,0 +1,82 @@
+// **********************************************************************
+// smile/include/BranchPredictor.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Front-end branch prediction model for Tile1 (attach with Tile1::attach_branch_predictor).
+Tile1 resolves every branch/jump in the cycle it retires; this model says whether a
+fetch stage ahead of it would have guessed the same next pc, and Tile1 charges
+penalty() bubble cycles for each miss.
+- Direction (conditional branches): static BTFN (backward taken, forward not),
+  bimodal (2-bit counters indexed by pc) or gshare (2-bit counters indexed by
+  pc ^ global history).
+- Targets: with a BTB (btb_entries > 0) a taken branch or jump is only predicted
+  if the BTB holds its target, otherwise it falls through; without one targets
+  are free (known at decode).  A return-address stack (ras_depth > 0) predicts
+  jalr x0, ra/t0; other jalr targets come from the BTB, or always miss without one.
+Calls/returns follow the same link-register convention as PcProfile.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class BranchPredictor {
+public:
+  enum class Scheme : uint8_t { Btfn, Bimodal, Gshare };
+
+  struct Config {
+    Scheme   scheme      = Scheme::Bimodal;
+    uint32_t table_bits  = 10; // log2 of the 2-bit counter table (bimodal/gshare); gshare history = table_bits
+    uint32_t btb_entries = 0;  // direct-mapped, power of two; 0 = ideal targets
+    uint32_t ras_depth   = 0;  // 0 = no return-address stack
+    uint32_t penalty     = 2;  // bubble cycles per mispredict
+  };
+
+  explicit BranchPredictor(const Config& cfg);
+
+  // Tile1 hooks: true when the front end would have fetched the wrong next pc
+  bool branch(uint32_t pc, uint32_t target, bool taken);                           // conditional branch
+  bool jump(uint32_t pc, uint32_t target, uint32_t rd, uint32_t rs1, bool indirect); // jal/jalr
+  void reset();                                                                     // cold tables, zero stats
+
+  const Config& config() const { return cfg_; }
+  uint32_t penalty()     const { return cfg_.penalty; }
+  const char* scheme_name() const;
+
+  uint64_t branches()      const { return branches_; }
+  uint64_t branch_misses() const { return dir_misses_ + target_misses_; }
+  uint64_t dir_misses()    const { return dir_misses_; }    // wrong direction
+  uint64_t target_misses() const { return target_misses_; } // right direction (taken), BTB had no/wrong target
+  uint64_t jumps()         const { return jumps_; }
+  uint64_t jump_misses()   const { return jump_misses_; }
+  uint64_t returns()       const { return returns_; }
+  uint64_t ras_misses()    const { return ras_misses_; }
+  uint64_t btb_lookups()   const { return btb_lookups_; }
+  uint64_t btb_hits()      const { return btb_hits_; }
+
+private:
+  struct BtbEntry {
+    uint32_t pc = 0, target = 0;
+    bool     valid = false;
+  };
+  uint32_t index(uint32_t pc) const;
+  bool     btb_lookup(uint32_t pc, uint32_t* target);
+  void     btb_update(uint32_t pc, uint32_t target);
+
+  Config   cfg_;
+  std::vector<uint8_t>  counters_; // 2-bit saturating, >= 2 predicts taken
+  uint32_t history_ = 0;           // gshare global history, newest outcome in bit 0
+  uint32_t table_mask_ = 0;
+  std::vector<BtbEntry> btb_;
+  std::vector<uint32_t> ras_;      // circular; overflow overwrites the oldest entry
+  uint32_t ras_top_ = 0, ras_count_ = 0;
+
+  uint64_t branches_ = 0, dir_misses_ = 0, target_misses_ = 0;
+  uint64_t jumps_ = 0, jump_misses_ = 0, returns_ = 0, ras_misses_ = 0;
+  uint64_t btb_lookups_ = 0, btb_hits_ = 0;
+};
+
+// "btfn" | "bimodal" | "gshare"; false on anything else
+bool parse_bpred_scheme(const std::string& name, BranchPredictor::Scheme* out);
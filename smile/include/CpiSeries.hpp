@@ -0,0 +1,43 @@
+// **********************************************************************
+// smile/include/CpiSeries.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+CPI stack as a time series (attach with Tile1::attach_cpi_series, -cpi_interval).
+Every `interval` cycles Tile1 hands over its running CPI slot totals and one CSV
+row is written with what the interval added:
+  cycle,inst,cpi,base,fetch,branch,load,store,store_rmw,load_use,port_busy,accel,other
+`cycle` is where the interval ended; the slot columns are cycles and add up to the
+interval length.  Block ticks can run past a boundary, so rows land on the first
+tick at or after it (exact in timed mode, within one block in ideal mode).
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "Tile1.hpp"
+
+class CpiSeries {
+public:
+  ~CpiSeries() { close(); }
+
+  bool open(const std::string& path, uint64_t interval, const Tile1& tile, std::string* err); // baseline = tile's totals now
+  void close();
+  bool is_open() const { return f_ != nullptr; }
+
+  uint64_t next_cycle() const { return next_; }  // Tile1: sample() once cycle_count() reaches this
+  void sample(const Tile1& tile);                // one row for the cycles since the last one
+  void finish(const Tile1& tile);                // trailing partial interval (if any), then close
+  uint64_t rows() const { return rows_; }
+
+private:
+  FILE*    f_ = nullptr;
+  uint64_t interval_ = 0;
+  uint64_t next_ = 0;
+  uint64_t rows_ = 0;
+  uint64_t last_cycle_ = 0;
+  uint64_t last_inst_ = 0;
+  std::array<uint64_t, Tile1::kCpiSlots> last_{};
+};
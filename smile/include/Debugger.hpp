@@ -10,6 +10,7 @@ Debugger REPLfor Tile1 simulator.
 #include "Tile1.hpp"
 
 #include <cstdint>
+#include <unordered_set>
 #include <vector>
 
 namespace smile {
@@ -17,6 +18,7 @@ namespace smile {
 struct DebuggerState {
   Tile1 &tile;
   smem::MemoryPort &mem;
+  smem::DirectAccessor mem_direct; // per-cycle instruction peeks without the virtual read32 path
   int configured_threads; // let debugger know if 1 or 2 threads are configured
   ThreadContext threads[2];
   bool saw_breakpoint_trap[2];
@@ -30,10 +32,14 @@ struct DebuggerState {
   int current_thread;
   int cycle;
   bool trace_enabled;
-  std::vector<uint32_t> breakpoints;
+  std::vector<uint32_t> breakpoints;           // in insertion order (listing, .smile_dbg)
+  std::unordered_set<uint32_t> breakpoint_set; // same addresses, for the per-cycle lookup
 
   DebuggerState(Tile1 &t, smem::MemoryPort &m, int thread_count);
   void reset();
+  bool add_breakpoint(uint32_t addr);    // false if already set
+  bool remove_breakpoint(uint32_t addr); // false if not set
+  void clear_breakpoints();
 };
 
 void auto_run(DebuggerState &state, int max_cycles);
@@ -0,0 +1,66 @@
+// **********************************************************************
+// smile/include/DecodeCache.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+PC-indexed predecode cache for Tile1.  Each entry holds a fully decoded
+Instruction plus its resolved ExecOp, so a hot loop pays for decode once
+instead of every tick.  Direct-mapped on (pc >> 2); stores that hit a cached
+instruction word invalidate it, fence.i and reset flush everything.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Instruction.hpp"
+#include "Tile1_exec.hpp"
+
+class DecodeCache {
+public:
+  struct Entry {
+    uint32_t    pc    = 0;
+    uint32_t    raw   = 0;
+    bool        valid = false;
+    ExecOp      op    = ExecOp::Unknown;
+    uint32_t    regs  = 0;       // bit i: xi read or written (x0 never set); ~0 for CSR/SYSTEM/CUSTOM-0/unknown
+    Instruction instr{0u};
+  };
+
+  static constexpr size_t kDefaultEntries = 4096; // 16KB of code, power of two
+
+  explicit DecodeCache(size_t entries = kDefaultEntries);
+
+  // Ideal fetch path: hit on pc tag alone (no memory read needed), nullptr on miss.
+  const Entry* lookup(uint32_t pc) {
+    Entry& e = entries_[(pc >> 2) & mask_];
+    if (e.valid && e.pc == pc) { ++hits_; return &e; }
+    ++misses_;
+    return nullptr;
+  }
+  // Timed fetch path: the word was fetched anyway, so also require it to match.
+  const Entry& lookup_or_fill(uint32_t pc, uint32_t raw) {
+    Entry& e = entries_[(pc >> 2) & mask_];
+    if (e.valid && e.pc == pc && e.raw == raw) { ++hits_; return e; }
+    ++misses_;
+    return fill(pc, raw);
+  }
+  const Entry& fill(uint32_t pc, uint32_t raw); // decode raw and install it for pc
+  void invalidate(uint32_t addr) {              // store to addr: drop the word it lands in
+    Entry& e = entries_[(addr >> 2) & mask_];
+    if (e.valid && e.pc == (addr & ~0x3u)) { e.valid = false; ++invalidates_; }
+  }
+  void flush();                                 // drop all entries (fence.i / reset)
+  void reset_stats() { hits_ = misses_ = invalidates_ = 0; }
+
+  uint64_t hits()        const { return hits_; }
+  uint64_t misses()      const { return misses_; }
+  uint64_t invalidates() const { return invalidates_; }
+
+private:
+  std::vector<Entry> entries_;
+  uint32_t mask_ = 0;
+  uint64_t hits_        = 0;
+  uint64_t misses_      = 0;
+  uint64_t invalidates_ = 0;
+};
@@ -34,6 +34,7 @@ struct Instruction {
     CSR,
     CSR_IMM,
     CUSTOM,
+    SIMD,    // packed 4x8/2x16 ops on the integer registers (CUSTOM-1 opcode)
     Unknown,
   };
 
@@ -0,0 +1,88 @@
+// **********************************************************************
+// smile/include/JitX64.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Minimal x86-64 code buffer and emitter for Tile1's JIT tier (Tile1_jit.cpp).
+One mmap'd region, written while mapped read/write and flipped to read/execute
+before anything in it runs (never writable and executable at once).  Only the
+handful of instruction forms the block translator needs are provided; every
+memory operand is [base + disp32].  supported() is false on hosts that are not
+x86-64 SysV (the JIT then stays off).
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JitX64 {
+public:
+  enum Reg : uint8_t { RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+                       R8 = 8, R9 = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14, R15 = 15 };
+  enum Alu : uint8_t { ADD = 0, OR = 1, AND = 4, SUB = 5, XOR = 6, CMP = 7 }; // group-1 /digit
+  enum Shift : uint8_t { SHL = 4, SHR = 5, SAR = 7 };                          // group-2 /digit
+  enum Cond : uint8_t { B = 0x2, AE = 0x3, NE = 0x5, L = 0xc };                // jcc/setcc low nibble
+  enum Ext : uint8_t { MOVZX8 = 0xb6, MOVZX16 = 0xb7, MOVSX8 = 0xbe, MOVSX16 = 0xbf };
+
+  static bool supported();
+
+  JitX64() = default;
+  ~JitX64();
+  JitX64(const JitX64&) = delete;
+  JitX64& operator=(const JitX64&) = delete;
+
+  bool   reserve(size_t bytes);            // map the buffer once; false if the host refuses
+  void   clear();                          // drop all translated code
+  size_t capacity() const { return cap_; }
+  size_t used()     const { return used_; }
+
+  // One function at a time: begin(), emit, finish() copies it in and returns its
+  // entry (nullptr if the buffer is full; clear() and retry).
+  void   begin() { code_.clear(); }
+  void*  finish();
+  size_t pos() const { return code_.size(); }
+  void   patch_rel32(size_t at, size_t target); // at = offset of a rel32 field
+
+  // 32-bit register <-> [base + disp]
+  void mov_r32_m(Reg dst, Reg base, int32_t disp);
+  void mov_m_r32(Reg base, int32_t disp, Reg src);
+  void mov_m_imm32(Reg base, int32_t disp, uint32_t imm);
+  void alu_r32_m(Alu op, Reg dst, Reg base, int32_t disp);
+  void alu_r32_imm(Alu op, Reg dst, int32_t imm);
+  void imul_r32_m(Reg dst, Reg base, int32_t disp);
+  void mov_r32_r32(Reg dst, Reg src);
+  void mov_r32_imm(Reg dst, uint32_t imm);
+  void shift_r32_cl(Shift op, Reg dst);
+  void shift_r32_imm(Shift op, Reg dst, uint8_t n);
+  void setcc_zx(Cond cc, Reg dst);         // dst = cc ? 1 : 0 (dst in rax..rbx)
+  void test_r32_imm(Reg r, uint32_t imm);
+  // 64-bit forms for the high multiplies and host pointers
+  void movsxd_r64_m(Reg dst, Reg base, int32_t disp);
+  void imul_r64_r64(Reg dst, Reg src);
+  void shift_r64_imm(Shift op, Reg dst, uint8_t n);
+  void mov_r64_m(Reg dst, Reg base, int32_t disp);
+  void mov_r64_r64(Reg dst, Reg src);
+  void mov_r64_imm(Reg dst, uint64_t imm);
+  // dst = zero/sign-extended byte/half or dword at [base + index]
+  void load_idx(Ext ext, Reg dst, Reg base, Reg index);
+  void load32_idx(Reg dst, Reg base, Reg index);
+  // Control flow; jcc/jmp return the rel32 offset to patch
+  size_t jcc(Cond cc);
+  size_t jmp();
+  void   call_r64(Reg r);
+  void   push(Reg r);
+  void   pop(Reg r);
+  void   ret();
+
+private:
+  void byte(uint8_t b) { code_.push_back(b); }
+  void u32(uint32_t v);
+  void rex(bool w, Reg reg, Reg index, Reg base); // emitted only when needed
+  void modrm_disp(Reg reg, Reg base, int32_t disp); // [base + disp32] (SIB for rsp/r12)
+
+  std::vector<uint8_t> code_{}; // function being built
+  uint8_t* buf_  = nullptr;     // mapped region
+  size_t   cap_  = 0;
+  size_t   used_ = 0;
+};
@@ -0,0 +1,95 @@
+// **********************************************************************
+// smile/include/PcProfile.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Per-PC execution profile filled in by Tile1 (attach with Tile1::attach_profiler).
+Every simulated cycle lands on exactly one PC: a retired instruction counts one
+cycle at its own PC, a stall cycle counts against the instruction being fetched
+(fetch), the load/store in flight (dmem) or the CUSTOM-0 waiting (accel).
+- Counters are flat arrays indexed by (pc - base) >> 2; PCs outside the
+  configured window share one overflow slot.
+- Taken backward branches/direct jumps are kept per source slot (one target per
+  instruction), which is enough to recover loops for the hot-loop listing.
+- A shadow call stack (jal/jalr linking ra or t0 = call, jalr x0, ra/t0 = return)
+  attributes cycles to call paths for collapsed-stack (flame graph) output.
+  It follows one instruction stream, so it is only meaningful with one software thread.
+Reporting lives in ProfileReport.hpp.
+*/
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class PcProfile {
+public:
+  enum Stall : uint8_t { Fetch = 0, Dmem = 1, Accel = 2 };
+  static constexpr int kStallKinds = 3;
+
+  struct StackNode {
+    uint32_t parent;   // index into stack_nodes() (root is its own parent)
+    uint32_t entry_pc; // callee entry (root: first PC retired)
+  };
+
+  void configure(uint32_t base, uint32_t bytes); // profile window [base, base + bytes); clears counts
+
+  // Hot-path hooks (Tile1)
+  void retire(uint32_t pc) {
+    if (!rooted_) root(pc);
+    insts_[slot(pc)]++;
+    stack_cycles_[stack_]++;
+  }
+  void stall(Stall kind, uint32_t pc) {
+    stalls_[kind][slot(pc)]++;
+    stack_cycles_[stack_]++;
+  }
+  void jump(uint32_t from, uint32_t to, uint32_t rd, uint32_t rs1, bool indirect); // jal/jalr: call/return/back edge
+  void branch_taken(uint32_t from, uint32_t to) {
+    if (to <= from) {
+      const uint32_t s = slot(from);
+      back_target_[s] = to;
+      back_count_[s]++;
+    }
+  }
+
+  // Report-side accessors
+  uint32_t base()              const { return base_; }
+  uint32_t slots()             const { return static_cast<uint32_t>(insts_.size() - 1u); } // excludes overflow
+  uint32_t pc_of(uint32_t s)   const { return base_ + (s << 2); }
+  uint64_t insts(uint32_t s)   const { return insts_[s]; }
+  uint64_t stalls(Stall kind, uint32_t s) const { return stalls_[kind][s]; }
+  uint64_t cycles(uint32_t s)  const { return insts_[s] + stalls_[Fetch][s] + stalls_[Dmem][s] + stalls_[Accel][s]; }
+  uint64_t back_count(uint32_t s)  const { return back_count_[s]; }
+  uint32_t back_target(uint32_t s) const { return back_target_[s]; }
+  uint32_t overflow_slot()     const { return slots(); }
+  const std::vector<StackNode>& stack_nodes()  const { return stack_nodes_; }
+  const std::vector<uint64_t>&  stack_cycles() const { return stack_cycles_; }
+
+private:
+  static constexpr uint32_t kMaxStackNodes = 1u << 16; // deeper/wider call trees fold into the caller
+
+  uint32_t slot(uint32_t pc) const {
+    const uint32_t s = (pc - base_) >> 2;
+    return s < slots_ ? s : slots_;
+  }
+  void root(uint32_t pc) {
+    stack_nodes_[0].entry_pc = pc;
+    rooted_ = true;
+  }
+
+  uint32_t base_  = 0;
+  uint32_t slots_ = 0;
+  std::vector<uint64_t> insts_{0};
+  std::vector<uint64_t> stalls_[kStallKinds] = {{0}, {0}, {0}};
+  std::vector<uint64_t> back_count_{0};
+  std::vector<uint32_t> back_target_{0};
+
+  // Shadow call stack: interned (parent, callee) paths
+  std::vector<StackNode> stack_nodes_{StackNode{0, 0}};
+  std::vector<uint64_t>  stack_cycles_{0};
+  std::unordered_map<uint64_t, uint32_t> stack_index_{}; // (parent << 32 | callee) -> node
+  uint32_t stack_ = 0;
+  uint32_t folded_calls_ = 0; // calls not given a node (table full) still awaiting their return
+  bool rooted_ = false;
+};
@@ -0,0 +1,30 @@
+// **********************************************************************
+// smile/include/ProfileReport.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Reports over a PcProfile (tb_tile1 -profile):
+- flat function profile: cycles (retire + stall) per ELF function, hottest first
+- hot-loop listing: the top loops (ranges closed by a taken backward branch or jal),
+  one line per instruction with its counts and mnemonic (callees' cycles are not included)
+- collapsed stacks ("main;run_trellis;log_em 1234" lines) for flamegraph.pl & co.
+Without symbols everything lands in one "?" function and stacks show hex entry PCs.
+*/
+#pragma once
+
+#include "PcProfile.hpp"
+
+#include <string>
+#include <vector>
+
+namespace smem { class MemoryPort; }
+struct ElfSymbol; // util/ElfSymbols.hpp
+
+namespace smile {
+
+// mem is only read (instruction words for the loop listing)
+void print_profile(const PcProfile& prof, const std::vector<ElfSymbol>& syms, smem::MemoryPort& mem, int top_loops);
+bool write_folded_stacks(const std::string& path, const PcProfile& prof, const std::vector<ElfSymbol>& syms,
+                         std::string* err = nullptr);
+
+} // namespace smile
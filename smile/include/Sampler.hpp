@@ -0,0 +1,43 @@
+// **********************************************************************
+// smile/include/Sampler.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Sampled simulation (SMARTS-style systematic sampling) for tb_tile1.  The run is
+cut into sampling units of `period` instructions.  Each unit fast-forwards on the
+ideal memory model, then switches Tile1 to the timed model for `warmup`
+instructions (unmeasured) followed by a measured window of `window` instructions.
+The per-window CPIs give a mean CPI and a 95% confidence interval, which are
+scaled by the total instruction count to estimate the full timed run's cycles.
+*/
+#pragma once
+
+#include "Debugger.hpp"
+
+#include <cstdint>
+
+namespace smile {
+
+struct SampleConfig {
+  uint64_t period = 0; // instructions per sampling unit (fast-forward + warm-up + window)
+  uint64_t warmup = 0; // timed, unmeasured instructions before each window
+  uint64_t window = 0; // timed, measured instructions per unit
+};
+
+struct SampleReport {
+  uint64_t windows       = 0; // complete measured windows
+  uint64_t ffwd_insts    = 0; // instructions retired on the ideal model
+  uint64_t timed_insts   = 0; // instructions retired on the timed model (warm-up + windows + tail)
+  uint64_t total_insts   = 0;
+  double   cpi_mean      = 0.0;
+  double   cpi_ci95      = 0.0; // half-width of the 95% interval on mean CPI (0 if windows < 2)
+  double   est_cycles    = 0.0; // cpi_mean * total_insts
+  double   est_ci95      = 0.0; // cpi_ci95 * total_insts
+};
+
+// Drive the debugger in sampled mode for at most max_cycles simulated cycles (mixed
+// ideal/timed, as counted by state.cycle).  Leaves Tile1 on the timed model.
+SampleReport run_sampled(DebuggerState& state, int max_cycles, const SampleConfig& cfg);
+void print_sample_report(const SampleConfig& cfg, const SampleReport& rep);
+
+} // namespace smile
@@ -11,8 +11,16 @@ Define tile processing sequence upon ticks as well as support methods and it's m
 #include <array>
 #include <cstdint>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include "Instruction.hpp"
+#include "DecodeCache.hpp"
+#include "BranchPredictor.hpp"
+#include "PcProfile.hpp"
+#include "JitX64.hpp"
 #include "smem/MemoryPort.hpp"
+#include "smem/MemTrace.hpp"
 struct ThreadContext {       // structure to hold thread context
   uint32_t pc       = 0;     // what pc to start the thread at
   uint32_t regs[32] = {};    // value of regs for thread
@@ -20,6 +28,7 @@ struct ThreadContext {       // structure to hold thread context
 };
 
 class AccelPort;
+class CpiSeries;
 
 // Define the tile
 class Tile1 : public Component { // inherit from Component, 
@@ -34,7 +43,11 @@ public:
 
   // External interfaces
   void attach_memory(smem::MemoryPort* mem); // assigns Tile1 ptr to a mem port
-  void attach_accelerator(AccelPort* accel) { accel_port_ = accel; } // assigns Tile1 ptr to an accel port
+  void attach_accelerator(AccelPort* accel); // assigns Tile1 ptr to an accel port (v2 ports run decoupled)
+  void attach_profiler(PcProfile* prof)     { profile_ = prof; }     // per-PC profile (nullptr = off)
+  void attach_branch_predictor(BranchPredictor* bp) { bpred_ = bp; }  // mispredict penalties (nullptr = free branches)
+  void attach_trace_writer(smem::MemTraceWriter* w) { trace_out_ = w; } // record every retired instruction (nullptr = off)
+  void attach_cpi_series(CpiSeries* s)      { cpi_series_ = s; } // per-interval CPI stack rows (nullptr = off)
 
   // Trap and privilege enums
   enum class TrapCause : uint32_t {
@@ -55,6 +68,50 @@ public:
   static constexpr uint32_t CSR_MTVEC   = 0x305u;
   static constexpr uint32_t CSR_MEPC    = 0x341u;
   static constexpr uint32_t CSR_MCAUSE  = 0x342u;
+  static constexpr uint32_t CSR_MHARTID = 0xf14u; // index of the hart reading it (hardware threads)
+  // Zicntr/Zihpm counter CSRs (low halves; the high halves sit at +0x80)
+  static constexpr uint32_t CSR_MHPMEVENT3    = 0x323u; // ..0x33f selectors for mhpmcounter3..31
+  static constexpr uint32_t CSR_MCYCLE        = 0xb00u;
+  static constexpr uint32_t CSR_MINSTRET      = 0xb02u;
+  static constexpr uint32_t CSR_MHPMCOUNTER3  = 0xb03u; // ..0xb1f
+  static constexpr uint32_t CSR_CYCLE         = 0xc00u; // user read-only shadows of the above
+  static constexpr uint32_t CSR_TIME          = 0xc01u; // no wall clock: reads as cycle
+  static constexpr uint32_t CSR_INSTRET       = 0xc02u;
+  static constexpr uint32_t CSR_HPMCOUNTER3   = 0xc03u; // ..0xc1f
+  static constexpr uint32_t CSR_COUNTER_HI    = 0x80u;  // e.g. mcycleh = CSR_MCYCLE + CSR_COUNTER_HI
+  static constexpr uint32_t kHpmCounters      = 29u;    // mhpmcounter3..31
+  // Events selectable through mhpmevent3..31 (anything else reads back as None)
+  enum class HpmEvent : uint32_t {
+    None        = 0u,
+    FetchStall  = 1u, // cycles with no instruction to run: fetch issued or outstanding (timed mem), mispredict bubbles
+    DmemStall   = 2u, // cycles waiting on a data access, incl. the SB/SH write-back phase
+    AccelStall  = 3u, // cycles waiting on a CUSTOM-0 accelerator response
+    Load        = 4u, // retired loads
+    Store       = 5u, // retired stores
+    Branch      = 6u, // retired conditional branches
+    BranchTaken = 7u,
+    Arith       = 8u, // retired ALU/M-extension ops
+    Mul         = 9u,
+    Simd        = 10u, // retired packed-SIMD ops
+    Count
+  };
+  // CPI stack: every cycle the tile runs lands in exactly one slot.  Base = the cycle retired an
+  // instruction; the others say why it did not, set at the same spots as the stall counters.
+  enum class CpiSlot : uint8_t {
+    Base     = 0,
+    Fetch    = 1, // instruction fetch issued or outstanding (word or line)
+    Branch   = 2, // mispredict bubbles
+    Load     = 3, // blocking load in flight, incl. its completion cycle
+    Store    = 4, // SW in flight (SB/SH too on a port with byte writes)
+    StoreRmw = 5, // SB/SH read-modify-write, read and write phase (word-only ports)
+    LoadUse  = 6, // waiting on a register a non-blocking load is still filling
+    PortBusy = 7, // load/store held for a request slot (line prefetch in flight, load slots full)
+    Accel    = 8, // CUSTOM-0 response, accelerator queue slot or owner
+    Other    = 9, // anything not attributed above
+    Count
+  };
+  static constexpr size_t kCpiSlots = static_cast<size_t>(CpiSlot::Count);
+  static const char* cpi_slot_name(CpiSlot s); // short lowercase name ([CPI], CSV header)
 
   // MSTATUS bit masks
   static constexpr uint32_t MSTATUS_MIE         = 1u << 3;
@@ -98,16 +155,117 @@ public:
     exited_ = true;
     halted_ = true;
   }
+  // Checkpointing (util/Checkpoint.hpp): everything architectural plus trap flow and counters.
+  // Only complete at a quiescent point, i.e. no fetch/data/accelerator request in flight.
+  struct ArchState {
+    uint32_t  pc = 0;
+    uint32_t  regs[32] = {};
+    uint32_t  mstatus = 0, mtvec = 0, mepc = 0, mcause = 0;
+    PrivMode  priv = PrivMode::Machine;
+    bool      trap_pending = false;
+    TrapCause pending_trap = TrapCause::EnvironmentCallFromUMode;
+    bool      pc_override_pending = false;
+    uint32_t  pc_override_value = 0;
+    bool      halted = false, exited = false;
+    uint32_t  exit_code = 0;
+    uint64_t  counters[9] = {};                       // inst, arith, add, mul, load, store, branch, taken, simd
+    uint64_t  cycles = 0, stalls[3] = {};             // cycle count; fetch, dmem, accel stall cycles
+    uint64_t  cpi[kCpiSlots] = {};                    // CPI stack cycles, by CpiSlot
+    uint64_t  counter_offset[2 + kHpmCounters] = {};  // mcycle, minstret, mhpmcounter3..31 (see counter_offset_)
+    uint32_t  hpm_event[kHpmCounters] = {};
+    std::vector<std::pair<uint32_t, uint32_t>> csrs; // csrs_ entries, sorted by address
+  };
+  bool      quiescent() const { return !ifetch_wait_ && !fline_wait_ && !dmem_wait_ && !accel_wait_ && nb_inflight_ == 0 &&
+                                       accel_inflight_ == 0 && bpred_bubble_ == 0 &&
+                                       (hw_threads_ == 1 || parked_harts_idle()); }
+  ArchState save_arch_state() const;
+  void      load_arch_state(const ArchState& s); // also drops predecoded code and cached direct regions
   bool     has_exited()            const { return exited_; }
   uint32_t exit_code()             const { return exit_code_; }
   uint64_t inst_count()            const { return inst_count_; }
   uint64_t arith_count()           const { return arith_count_; }
   uint64_t add_count()             const { return add_count_; }
   uint64_t mul_count()             const { return mul_count_; }
+  uint64_t simd_count()            const { return simd_count_; }
   uint64_t load_count()            const { return load_count_; }
   uint64_t store_count()           const { return store_count_; }
   uint64_t branch_count()          const { return branch_count_; }
   uint64_t branch_taken_count()    const { return branch_taken_count_; }
+  uint64_t cycle_count()           const { return cycle_count_; }        // ticks the tile ran (what mcycle counts)
+  uint64_t fetch_stall_cycles()    const { return fetch_stall_cycles_; }
+  uint64_t dmem_stall_cycles()     const { return dmem_stall_cycles_; }
+  uint64_t accel_stall_cycles()    const { return accel_stall_cycles_; }
+  uint64_t event_count(HpmEvent e) const;                                // running total behind an mhpmevent selector
+  uint64_t cpi_cycles(CpiSlot s)   const { return cpi_cycles_[static_cast<size_t>(s)]; } // slots sum to cycle_count()
+  uint64_t decode_hits()           const { return decode_cache_.hits(); }        // predecode cache stats
+  uint64_t decode_misses()         const { return decode_cache_.misses(); }
+  uint64_t decode_invalidates()    const { return decode_cache_.invalidates(); }
+  void     flush_decode_cache()    { decode_cache_.flush(); flush_blocks(); fline_.valid = fline_next_.valid = false; } // call after writing code behind the core's back (fence.i does this)
+  // Basic-block engine (ideal mem only): one tick may retire a whole straight-line run
+  void     set_block_exec(bool on)          { block_exec_ = on; }
+  bool     block_exec()              const  { return block_exec_; }
+  void     set_tick_budget(uint32_t n)      { tick_budget_ = n ? n : 1u; } // max instrs the next tick may retire (driver sets this)
+  uint32_t last_tick_cycles()        const  { return last_tick_cycles_; }  // cycles the last tick accounted for (>= 1)
+  uint64_t block_dispatches()        const  { return block_dispatches_; }
+  uint64_t block_insts()             const  { return block_insts_; }
+  // JIT tier (Tile1_jit.cpp, x86-64 hosts): block bodies dispatched `threshold` times run as
+  // native code from then on; check => every native run is redone on the interpreter and compared
+  static constexpr uint32_t kJitThreshold = 16;
+  static bool jit_supported()               { return JitX64::supported(); }
+  void     set_jit(bool on, uint32_t threshold = kJitThreshold, bool check = false);
+  bool     jit()                     const  { return jit_on_; }
+  bool     jit_check()               const  { return jit_check_; }
+  uint64_t jit_blocks()              const  { return jit_blocks_; }     // bodies translated
+  uint64_t jit_dispatches()          const  { return jit_dispatches_; } // bodies run natively
+  uint64_t jit_insts()               const  { return jit_insts_; }      // instructions they retired
+  uint64_t jit_flushes()             const  { return jit_flushes_; }    // code buffer filled up and was dropped
+  size_t   jit_code_bytes()          const  { return jit_code_.used(); }
+  BranchPredictor* branch_predictor() const { return bpred_; }
+  uint64_t bpred_penalty_cycles()    const  { return bpred_penalty_cycles_; } // mispredict bubbles (also counted as fetch stalls)
+  // Instruction fetch line buffer (timed mem): 0 => one request_read32 per instruction
+  void     set_fetch_line(uint32_t bytes, bool prefetch);    // bytes: power of two, 4..MemoryPort::kMaxLineBytes
+  uint32_t fetch_line_bytes()        const  { return fetch_line_bytes_; }
+  uint64_t fetch_line_hits()         const  { return fetch_line_hits_; }     // instructions served from a buffered line
+  uint64_t fetch_line_misses()       const  { return fetch_line_misses_; }   // demand line requests
+  uint64_t fetch_prefetches()        const  { return fetch_prefetches_; }    // next-line prefetches issued
+  uint64_t fetch_prefetch_hits()     const  { return fetch_prefetch_hits_; } // prefetched lines later fetched from
+  // Non-blocking loads (timed mem, one software thread): a load retires at issue and only
+  // the instructions touching its rd (or needing a request slot) wait.  0 => blocking loads.
+  static constexpr uint32_t kMaxNbLoads = 8;
+  void     set_nonblocking_loads(uint32_t slots);          // loads in flight at once, 0..kMaxNbLoads; port needs tags
+  uint32_t nonblocking_loads()       const  { return nb_load_slots_; }
+  uint64_t nb_loads()                const  { return nb_loads_issued_; }
+  uint64_t nb_load_latency_cycles()  const  { return nb_latency_cycles_; } // issue-to-data cycles (what blocking would stall)
+  uint64_t nb_use_stalls()           const  { return nb_use_stalls_; }     // cycles an instruction waited on a pending rd
+  uint64_t nb_slot_stalls()          const  { return nb_slot_stalls_; }    // cycles a load/store waited for a request slot
+  uint64_t nb_busy_cycles()          const  { return nb_busy_cycles_; }    // cycles with at least one load in flight
+  uint64_t nb_inflight_sum()         const  { return nb_inflight_sum_; }   // sum of loads in flight over those cycles
+  // Decoupled accelerator (AccelPort::supports_queue()): a CUSTOM-0 retires once queued and its rd
+  // joins a scoreboard until the response tagged with it comes back; CSR/SYSTEM/FENCE wait for all.
+  bool     accel_queued()            const  { return accel_queued_; }
+  uint64_t accel_cmds()              const  { return accel_cmds_; }
+  uint64_t accel_full_stalls()       const  { return accel_full_stalls_; }  // cycles a CUSTOM-0 waited for a queue slot
+  uint64_t accel_empty_stalls()      const  { return accel_empty_stalls_; } // cycles spent waiting on a result still in flight
+  // Hardware multithreading: hw_threads register contexts (harts) live in the core and one of
+  // them runs each cycle; switching costs nothing.  The tile stops once every hart has, and
+  // reports hart 0's exit code.  Harts share memory, CSRs other than the trap set, and counters.
+  enum class HartSwitch : uint8_t {
+    OnStall    = 0, // keep the running hart until it waits on memory (fetch or data) or the accelerator
+    RoundRobin = 1, // next hart that can make progress, every cycle
+  };
+  static constexpr uint32_t kMaxHarts = 8;
+  struct HartStats {
+    uint64_t insts = 0;
+    uint64_t cycles = 0;        // cycles this hart was the one running (stalls included)
+    uint64_t switches_in = 0;
+  };
+  void     set_hw_threads(uint32_t n, HartSwitch policy); // 1..kMaxHarts; timed mem needs a tagged port with > n slots
+  uint32_t hw_threads()              const  { return hw_threads_; }
+  HartSwitch hart_switch()           const  { return hart_switch_; }
+  uint32_t current_hart()            const  { return hart_; }             // hart that ran (or will run) the current cycle
+  void     hart_context(uint32_t h, ThreadContext* out) const;           // pc/regs of hart h; active = not stopped
+  const HartStats& hart_stats(uint32_t h) const { return hart_stats_[h]; }
+  uint64_t hart_switches()           const  { return hart_switches_; }
   void     set_pc(uint32_t pc);                           // a way to set the PC
   void     set_mem_model(MemModel m) { mem_model_ = m; }  // a way to set ideal or timed mem model…
   MemModel mem_model() const { return mem_model_; }       // …(currently used by testbench cmdline args)
@@ -175,11 +333,148 @@ private:
     }
   }
   void reset_trap_csrs();
+  bool fetch_from_line(uint32_t pc, uint32_t* word); // false => stalled (line requested or on its way)
+  void prefetch_next_line();
+  void absorb_fetch_line();                          // a line response landed: fill the buffer it was for
+  bool read_counter_csr(uint32_t addr, uint32_t* value) const; // false => not a counter CSR
+  bool write_counter_csr(uint32_t addr, uint32_t value);
+  uint64_t counter_source(uint32_t slot) const;                // raw running total behind counter slot
+  void run_hart();                        // one cycle of the running hart: finish its wait, else fetch/decode/execute
   void complete_dmem(uint32_t resp_data); // helper for completing dmem access after stall (update RF, clear fields)
+  void account_cycles(uint64_t insts_before); // charge the tick's cycles to the CPI stack, feed cpi_series_
+  CpiSlot dmem_slot() const {             // CPI slot of the blocking data access in flight
+    if (dmem_op_ == DmemOp::SB || dmem_op_ == DmemOp::SH) return port_byte_writes_ ? CpiSlot::Store : CpiSlot::StoreRmw;
+    return dmem_op_ == DmemOp::SW ? CpiSlot::Store : CpiSlot::Load;
+  }
+  bool take_response(uint32_t* data) {    // the running hart's fetch/data response, once it has landed
+    if (hw_threads_ > 1) {                // routed to the hart by tag (route_hart_responses)
+      if (!mail_valid_) return false;
+      mail_valid_ = false;
+      *data = mail_data_;
+      return true;
+    }
+    if (!mem_port_->resp_valid()) return false;
+    *data = mem_port_->resp_data();
+    mem_port_->resp_consume();
+    return true;
+  }
+  uint32_t load_value(DmemOp op, uint32_t addr, uint32_t word) const; // extract/extend a load from its aligned word
+  bool issue_hazard(const DecodeCache::Entry& e, uint32_t pc); // true => held this cycle (scoreboard, port slot, accelerator)
+  void drain_nb_loads();                                    // retire load responses at the head of the port
+  void issue_accel_cmd(const Instruction& decoded, uint32_t pc); // v2: queue a CUSTOM-0, rd joins accel_sb_
+  void drain_accel_responses();                             // v2: write back results that came back
+  bool accel_hazard(const DecodeCache::Entry& e);           // v2: true => e waits on the accelerator queue (stats counted)
+  void load_ideal(const Instruction& decoded);  // synchronous load (ideal mem), no counters
+  void trace_retire(uint32_t pc, ExecOp op, const Instruction& decoded); // one MemTrace record, before rd is written
+  void store_ideal(const Instruction& decoded); // synchronous store (ideal mem), no counters
+  void note_code_store(uint32_t aligned) {      // drop predecoded state covering a stored word
+    decode_cache_.invalidate(aligned);
+    if (fetch_line_bytes_ != 0) {                 // and any buffered fetch line holding it
+      const uint32_t tag = aligned & ~(fetch_line_bytes_ - 1u);
+      if (fline_.tag == tag)      fline_.valid = false;
+      if (fline_next_.tag == tag) fline_next_.valid = false;
+    }
+    if (aligned >= block_code_lo_ && aligned <= block_code_hi_ && block_code_words_.count(aligned)) {
+      block_smc_ = true; // blocks flushed once the running body (if any) stops
+    }
+  }
+
+  // Hardware threads: the running hart lives in the members below, the others are parked in harts_
+  struct Hart {
+    uint32_t pc = 0, last_pc = 0, last_instr = 0;
+    std::array<uint32_t, 32> regs{};
+    bool     ifetch_wait = false, ifetch_valid = false;
+    uint32_t ifetch_word = 0;
+    bool     dmem_wait = false;
+    DmemOp   dmem_op = DmemOp::None;
+    bool     dmem_rmw_write_issued = false;
+    uint32_t dmem_rd = 0, dmem_addr = 0, dmem_store_data = 0, dmem_store_mask = 0, dmem_store_shift = 0, dmem_next_pc = 0;
+    bool     accel_wait = false;
+    uint32_t accel_rd = 0, accel_next_pc = 0;
+    bool     halted = false, exited = false;
+    uint32_t exit_code = 0;
+    TrapCsrState trap_csrs{};
+    bool     trap_pending = false;
+    TrapCause pending_trap = TrapCause::EnvironmentCallFromUMode;
+    bool     pc_override_pending = false;
+    uint32_t pc_override_value = 0;
+    PrivMode priv = PrivMode::Machine;
+    bool     mail_valid = false;
+    uint32_t mail_data = 0;
+    uint32_t bpred_bubble = 0;
+  };
+  static constexpr uint32_t kHartTag = 0x100u; // request tag = kHartTag + hart (0: accelerators, 1..8: load slots)
+  void tick_harts();
+  void reset_harts();                          // every hart a copy of the (just reset) running one
+  void park_hart(Hart& h) const;
+  void unpark_hart(const Hart& h);
+  void switch_hart(uint32_t h);
+  void select_hart();
+  void route_hart_responses();
+  void hart_stopped();                         // running hart halted/exited: retire it, move on
+  bool hart_blocked(const Hart& h) const; // parked hart cannot make progress this cycle
+  bool active_blocked() const;            // running hart waits on memory or the accelerator
+  bool accel_owned_elsewhere() const;     // a parked hart is waiting on the accelerator
+  bool parked_harts_idle() const;
+
+  // Basic-block engine (Tile1_block.cpp)
+  struct BlockInsn;
+  using BlockHandler = void (*)(Tile1& tile, const BlockInsn& bi);
+  struct BlockInsn {          // pre-bound straight-line instruction
+    BlockHandler fn;
+    uint32_t     pc;
+    Instruction  instr;
+  };
+  struct JitCounts {          // counters the natively translated instructions of a body bump
+    uint32_t inst = 0, arith = 0, add = 0, mul = 0, load = 0, store = 0;
+  };
+  using JitFn = uint32_t (*)(Tile1* tile, uint32_t* regs, void* region); // returns body insts retired
+  struct Block {              // body = ALU/LOAD/STORE run; the terminator is left to the per-instruction path
+    std::vector<BlockInsn> body;
+    uint32_t  execs = 0;      // dispatches so far (JIT hotness)
+    JitFn     jit = nullptr;  // native body once translated
+    JitCounts jit_counts{};   // per full native run
+  };
+  static constexpr size_t kMaxBlockBody = 256;
+  Block& lookup_block(uint32_t pc);
+  uint32_t run_block_body(uint32_t max_insts, bool* at_terminator);
+  void flush_blocks();
+
+  // JIT tier (Tile1_jit.cpp)
+  struct JitRegion {          // data page the native loads read directly: hit when ((addr - lo) & ~3) < limit
+    uint8_t* host = nullptr;
+    uint32_t lo = 0;
+    uint32_t limit = 0;       // 0 => every load takes the slow path
+  };
+  static bool jit_native(ExecOp op);                     // translated inline (others call their block handler)
+  static void jit_count(const BlockInsn* body, size_t n, JitCounts* out);
+  bool     jit_translate(Block& blk);
+  uint32_t jit_dispatch(Block& blk);                     // body insts retired natively, 0 => interpret it
+  uint32_t jit_run_checked(Block& blk);                  // native run, rolled back and redone on the interpreter
+  static uint32_t jit_load_slow(Tile1* tile, const BlockInsn* bi);  // region miss/misaligned: load_ideal + refill
+  static uint32_t jit_store(Tile1* tile, const BlockInsn* bi);      // store_ideal; nonzero => body patched code
+
+  // Compile-time dispatch tables (Tile1_dispatch.cpp), indexed by ExecOp, counters included
+  using ExecHandler = void (*)(Tile1& tile, const Instruction& d, uint32_t pc);
+  template <ExecOp Op> static void exec_op(Tile1& tile, const Instruction& d, uint32_t pc);
+  template <ExecOp Op> static void block_op(Tile1& tile, const BlockInsn& bi);
+  template <ExecOp Op> static constexpr ExecHandler  exec_entry();  // &exec_op<Op> or nullptr
+  template <ExecOp Op> static constexpr BlockHandler block_entry(); // &block_op<Op> or nullptr
+  template <size_t... I> static constexpr std::array<ExecHandler, sizeof...(I)> make_exec_table(std::index_sequence<I...>);
+  template <size_t... I> static constexpr std::array<BlockHandler, sizeof...(I)> make_block_table(std::index_sequence<I...>);
+  static const std::array<ExecHandler, kNumExecOps>  kExecTable;  // is_compute_op() ops; nullptr => run_hart's switch
+  static const std::array<BlockHandler, kNumExecOps> kBlockTable; // block body ops; nullptr => op ends a block
 
   // Attached interfaces
   smem::MemoryPort* mem_port_ = nullptr;   // tile's pointer to external mem port   (lets it fetch instr & read/write data)
+  smem::DirectAccessor mem_direct_{};      // untimed (ideal) accesses via the port's direct region when granted
+  bool port_byte_writes_ = false;          // mem_port_ takes SB/SH as one write (no read-modify-write)
   AccelPort*  accel_port_ = nullptr; // currently attached accelerator, seen through the AccelPort interface
+  PcProfile*  profile_ = nullptr;    // optional per-PC profile, fed from the same spots as the counters
+  BranchPredictor* bpred_ = nullptr; // optional front-end predictor; a miss costs its penalty in bubbles
+  uint32_t    bpred_bubble_ = 0;     // bubble cycles left before the next fetch
+  uint64_t    bpred_penalty_cycles_ = 0;
+  smem::MemTraceWriter* trace_out_ = nullptr; // optional retired-instruction trace (class + load/store address)
 
   // Private state for core execution state
   uint32_t pc_ = 0;                 // 32b PC
@@ -191,16 +486,74 @@ private:
   uint32_t ifetch_word_ = 0;        // buffered instr word for fetch stage (holds fetched instr until fetch stage consumes it)
   MemModel mem_model_ = MemModel::Timed; // for setting ideal vs. timed mem model
 
+  // Private state for the fetch line buffer (timed mem, fetch_line_bytes_ != 0)
+  struct FetchLine {
+    uint32_t tag   = 0;     // line-aligned address
+    bool     valid = false;
+    std::array<uint32_t, smem::MemoryPort::kMaxLineBytes / 4> words{};
+  };
+  uint32_t  fetch_line_bytes_ = 0;
+  bool      fetch_prefetch_ = true;
+  FetchLine fline_{};                // line being fetched from
+  FetchLine fline_next_{};           // sequential next line (prefetched)
+  bool      fline_wait_ = false;     // a line request is outstanding on mem_port_
+  bool      fline_req_prefetch_ = false;
+  uint32_t  fline_req_tag_ = 0;
+  uint64_t  fetch_line_hits_ = 0;
+  uint64_t  fetch_line_misses_ = 0;
+  uint64_t  fetch_prefetches_ = 0;
+  uint64_t  fetch_prefetch_hits_ = 0;
+
   // Private state for data stalling (separate from IFetch)
   bool dmem_wait_ = false;
   DmemOp dmem_op_ = DmemOp::None;
-  bool dmem_rmw_write_issued_ = false; // for SB/SH two-phase timed read-modify-write
+  bool dmem_rmw_write_issued_ = false; // for SB/SH two-phase timed read-modify-write (set at issue on a byte-write port)
   uint32_t dmem_rd_ = 0;
   uint32_t dmem_addr_ = 0;      // original effective byte address
   uint32_t dmem_store_data_ = 0;
   uint32_t dmem_store_mask_ = 0;
   uint32_t dmem_store_shift_ = 0;
   uint32_t dmem_next_pc_ = 0;   // PC to apply after completion
+  // Non-blocking loads: slot i travels with tag i + 1 (tag 0 = fetch, line, store)
+  struct PendingLoad {
+    DmemOp   op = DmemOp::None;
+    uint32_t rd = 0;
+    uint32_t addr = 0;
+    uint64_t issued = 0;        // cycle_count_ at issue
+  };
+  std::array<PendingLoad, kMaxNbLoads> nb_loads_{};
+  uint32_t nb_load_slots_ = 0;
+  uint32_t nb_inflight_ = 0;
+  uint32_t nb_free_ = 0;        // bit i: slot i free
+  uint32_t load_sb_ = 0;        // scoreboard: bit i => xi waits on a load
+  uint64_t nb_loads_issued_ = 0;
+  uint64_t nb_latency_cycles_ = 0;
+  uint64_t nb_use_stalls_ = 0;
+  uint64_t nb_slot_stalls_ = 0;
+  uint64_t nb_busy_cycles_ = 0;
+  uint64_t nb_inflight_sum_ = 0;
+  bool check_issue_ = false;    // nb loads, decoupled accelerator or harts on: run issue_hazard before executing
+
+  // Decoupled accelerator state (accel_queued_)
+  bool     accel_queued_ = false;
+  uint32_t accel_sb_ = 0;       // bit r set => xr waits on an accelerator response
+  uint32_t accel_inflight_ = 0; // commands queued, running or answered but not yet written back
+  uint64_t accel_cmds_ = 0;
+  uint64_t accel_full_stalls_ = 0;
+  uint64_t accel_empty_stalls_ = 0;
+
+  // Hardware thread state (hw_threads_ > 1)
+  uint32_t   hw_threads_ = 1;
+  HartSwitch hart_switch_ = HartSwitch::OnStall;
+  uint32_t   hart_ = 0;         // running hart
+  uint32_t   hart_tag_ = 0;     // tag on the running hart's requests (0 with one hart)
+  uint32_t   live_harts_ = 1;
+  bool       hart_held_ = false;  // running hart was held at issue (port slot, accelerator) last cycle
+  bool       mail_valid_ = false; // running hart's routed response
+  uint32_t   mail_data_ = 0;
+  uint64_t   hart_switches_ = 0;
+  std::array<Hart, kMaxHarts>      harts_{};
+  std::array<HartStats, kMaxHarts> hart_stats_{};
   bool accel_wait_ = false;     // waiting for accelerator response after CUSTOM-0 issue
   uint32_t accel_rd_ = 0;       // destination rd captured on CUSTOM-0 issue
   uint32_t accel_next_pc_ = 0;  // PC to apply when accelerator response completes
@@ -215,10 +568,52 @@ private:
   uint64_t arith_count_        = 0;
   uint64_t add_count_          = 0;
   uint64_t mul_count_          = 0;
+  uint64_t simd_count_         = 0;
   uint64_t load_count_         = 0;
   uint64_t store_count_        = 0;
   uint64_t branch_count_       = 0;
   uint64_t branch_taken_count_ = 0;
+  uint64_t cycle_count_        = 0;
+  uint64_t fetch_stall_cycles_ = 0;
+  uint64_t dmem_stall_cycles_  = 0;
+  uint64_t accel_stall_cycles_ = 0;
+  CpiSlot  cpi_stall_ = CpiSlot::Other;           // why the current cycle retires nothing (if it doesn't)
+  std::array<uint64_t, kCpiSlots> cpi_cycles_{};
+  CpiSeries* cpi_series_ = nullptr;               // optional interval time series (-cpi_interval)
+
+  // Counter CSRs are views of the running totals above: slot 0 = mcycle, 1 = minstret,
+  // 2 + i = mhpmcounter(3+i).  A counter reads (source - offset); a write just moves the offset,
+  // so nothing extra is done per tick.
+  std::array<uint64_t, 2 + kHpmCounters> counter_offset_{};
+  std::array<uint32_t, kHpmCounters>     hpm_event_{};   // mhpmevent3..31 (HpmEvent values)
+
+  // Predecoded instructions keyed by PC (see DecodeCache.hpp)
+  DecodeCache decode_cache_{};
+
+  // Basic-block engine state (ideal mem only)
+  bool block_exec_ = false;
+  uint32_t tick_budget_ = 1;        // 1 => classic one-instruction tick
+  uint32_t last_tick_cycles_ = 1;
+  std::unordered_map<uint32_t, Block> blocks_{}; // keyed by block start pc
+  std::unordered_set<uint32_t> block_code_words_{}; // word addrs covered by cached blocks (SMC detection)
+  uint32_t block_code_lo_ = 0xffffffffu;
+  uint32_t block_code_hi_ = 0;
+  bool block_smc_ = false;
+  uint64_t block_dispatches_ = 0;
+  uint64_t block_insts_ = 0;
+
+  // JIT tier state (ideal mem + block engine only)
+  bool jit_on_ = false;
+  bool jit_check_ = false;
+  uint32_t jit_threshold_ = kJitThreshold;
+  JitX64 jit_code_{};
+  JitRegion jit_region_{};
+  bool jit_undo_on_ = false;                                   // -jit_check: stores log the word they replace
+  std::vector<std::pair<uint32_t, uint32_t>> jit_undo_{};      // (aligned addr, prior word)
+  uint64_t jit_blocks_ = 0;
+  uint64_t jit_dispatches_ = 0;
+  uint64_t jit_insts_ = 0;
+  uint64_t jit_flushes_ = 0;
 
   // Trap/CSR state
   TrapCsrState trap_csrs_{};
@@ -8,9 +8,49 @@
 #pragma once
 
 #include "Instruction.hpp"
+#include <cstddef>
 
 class Tile1;
 
+// Resolved execution handler for a decoded instruction.  Computed once per
+// instruction word (see DecodeCache) so tick() dispatches on it directly
+// instead of re-walking the category/opcode/funct3/funct7 ladder.
+enum class ExecOp : uint8_t {
+  Unknown = 0, // undecodable word: counts as an instruction, no side effects
+  // RV32I R-type
+  ADD, SUB, SLL, SLT, SLTU, XOR, SRL, SRA, OR, AND,
+  // M extension (+ MULW accepted for compatibility testing)
+  MUL, MULH, MULHSU, MULHU, DIV, DIVU, REM, REMU, MULW,
+  // RV32I I-type ALU
+  ADDI, SLLI, SLTI, SLTIU, XORI, SRLI, SRAI, ORI, ANDI,
+  // RV32I U-type
+  LUI, AUIPC,
+  // Loads / stores
+  LB, LH, LW, LBU, LHU, SB, SH, SW,
+  // Branches / jumps
+  BEQ, BNE, BLT, BGE, BLTU, BGEU, JAL, JALR,
+  // System / trap / fence
+  ECALL, EBREAK, URET, SRET, MRET, SYSTEM_NOP, FENCE, FENCE_I,
+  // CSR
+  CSRRW, CSRRS, CSRRC, CSRRWI, CSRRSI, CSRRCI,
+  // Custom extension
+  CUSTOM0,
+  // Packed SIMD (CUSTOM-1), same order as funct7 within each lane width
+  PADD_B, PSUB_B, PMIN_B, PMAX_B, PMINU_B, PMAXU_B, PCMPEQ_B, PCMPLT_B, PCMPLTU_B, PSADD_B, PSADDU_B,
+  PADD_H, PSUB_H, PMIN_H, PMAX_H, PMINU_H, PMAXU_H, PCMPEQ_H, PCMPLT_H, PCMPLTU_H, PSADD_H, PSADDU_H,
+};
+
+constexpr size_t kNumExecOps = static_cast<size_t>(ExecOp::PSADDU_H) + 1;
+
+// Ops whose only effects are a register write and counters (no pc, memory, trap or
+// accelerator side): these go through Tile1's compile-time handler table.
+constexpr bool is_compute_op(ExecOp op) {
+  return (op >= ExecOp::ADD && op <= ExecOp::AUIPC) || (op >= ExecOp::PADD_B && op <= ExecOp::PSADDU_H);
+}
+
+// Map a decoded instruction to its execution handler (mirrors the decoder's categories).
+ExecOp resolve_exec_op(const Instruction& instr);
+
 // RV32I base - R-type
 void exec_add(Tile1& tile, const Instruction& instr);
 void exec_sub(Tile1& tile, const Instruction& instr);
@@ -80,4 +120,8 @@ void exec_remu(Tile1& tile, const Instruction& instr);
 
 // Custom extension hooks
 void exec_custom0(Tile1& tile, const Instruction& instr);
-void exec_custom1(Tile1& tile, const Instruction& instr); // optional, future
+
+// Packed SIMD: lane-wise rs1 op rs2 over 4x8b (_B) or 2x16b (_H) lanes.  Compares
+// set a lane to all ones when true; PSADD/PSADDU clamp to the signed/unsigned lane range.
+uint32_t simd_lanes(ExecOp op, uint32_t a, uint32_t b); // op in PADD_B..PSADDU_H
+void exec_simd(Tile1& tile, const Instruction& instr, ExecOp op);
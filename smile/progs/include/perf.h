@@ -0,0 +1,80 @@
+// **********************************************************************
+// smile/progs/include/perf.h
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Tiny bare-metal API for Tile1's Zicntr/Zihpm performance counters.
+- perf_cycles() / perf_instret(): 64-bit cycle and instret (user shadows, read-only)
+- perf_select(n, event): point mhpmcounter<n> (3..31) at a PERF_EV_* event
+- perf_hpm(n): read mhpmcounter<n> (64-bit)
+- perf_roi_begin/perf_roi_end: snapshot/diff cycles, instret and counters 3..6
+Event numbers must match Tile1::HpmEvent.  CSR numbers are encoded in the
+instruction, so n must be a compile-time constant.
+Build with -march=rv32i_zicsr (smile_progs already does).
+*/
+#pragma once
+
+#include <stdint.h>
+
+// mhpmevent selectors (Tile1::HpmEvent)
+#define PERF_EV_NONE         0u
+#define PERF_EV_FETCH_STALL  1u // cycles with no instruction to run (fetch issued/outstanding)
+#define PERF_EV_DMEM_STALL   2u // cycles waiting on a data access
+#define PERF_EV_ACCEL_STALL  3u // cycles waiting on a CUSTOM-0 accelerator
+#define PERF_EV_LOAD         4u
+#define PERF_EV_STORE        5u
+#define PERF_EV_BRANCH       6u
+#define PERF_EV_BRANCH_TAKEN 7u
+#define PERF_EV_ARITH        8u
+#define PERF_EV_MUL          9u
+#define PERF_EV_SIMD        10u // retired packed-SIMD ops (simd.h)
+
+#define PERF_STR_(x) #x
+#define PERF_STR(x)  PERF_STR_(x)
+
+// Read a 64-bit counter as {hi, lo} pairs, retrying if lo wrapped between the reads.
+#define PERF_READ64(lo_csr, hi_csr) ({                              \
+  uint32_t perf_hi_, perf_lo_, perf_hi2_;                           \
+  do {                                                              \
+    asm volatile("csrr %0, " PERF_STR(hi_csr) : "=r"(perf_hi_));    \
+    asm volatile("csrr %0, " PERF_STR(lo_csr) : "=r"(perf_lo_));    \
+    asm volatile("csrr %0, " PERF_STR(hi_csr) : "=r"(perf_hi2_));   \
+  } while (perf_hi_ != perf_hi2_);                                  \
+  ((uint64_t)perf_hi_ << 32) | perf_lo_;                            \
+})
+
+static inline uint64_t perf_cycles(void)  { return PERF_READ64(0xc00, 0xc80); }
+static inline uint64_t perf_instret(void) { return PERF_READ64(0xc02, 0xc82); }
+
+// n in 3..31 (compile-time constant)
+#define perf_select(n, event) asm volatile("csrw " PERF_STR(0x320 + n) ", %0" :: "r"((uint32_t)(event)))
+#define perf_hpm(n)           PERF_READ64(0xc00 + n, 0xc80 + n)
+
+// Region-of-interest snapshot: select events on counters 3..6 first, e.g.
+//   perf_select(3, PERF_EV_FETCH_STALL); perf_select(4, PERF_EV_DMEM_STALL); ...
+//   perf_roi_t roi; perf_roi_begin(&roi); kernel(); perf_roi_end(&roi);
+// after which roi holds the deltas over the region.
+typedef struct {
+  uint64_t cycles;
+  uint64_t instret;
+  uint64_t hpm[4]; // mhpmcounter3..6
+} perf_roi_t;
+
+static inline void perf_roi_snapshot(perf_roi_t* s) {
+  s->hpm[0]  = perf_hpm(3);
+  s->hpm[1]  = perf_hpm(4);
+  s->hpm[2]  = perf_hpm(5);
+  s->hpm[3]  = perf_hpm(6);
+  s->instret = perf_instret();
+  s->cycles  = perf_cycles();
+}
+
+static inline void perf_roi_begin(perf_roi_t* roi) { perf_roi_snapshot(roi); }
+
+static inline void perf_roi_end(perf_roi_t* roi) {
+  perf_roi_t now;
+  perf_roi_snapshot(&now);
+  roi->cycles  = now.cycles  - roi->cycles;
+  roi->instret = now.instret - roi->instret;
+  for (int i = 0; i < 4; ++i) roi->hpm[i] = now.hpm[i] - roi->hpm[i];
+}
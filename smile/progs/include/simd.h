@@ -0,0 +1,75 @@
+// **********************************************************************
+// smile/progs/include/simd.h
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Tiny bare-metal API for Tile1's packed-SIMD instructions (CUSTOM-1 opcode).
+- Lanes live in the ordinary 32-bit registers: 4 x 8b (_b) or 2 x 16b (_h),
+  lane 0 in the low bits.
+- funct3 picks the lane width (0 = 8b, 1 = 16b), funct7 the operation
+  (SIMD_OP_* below); every op is R-type rd = rs1 op rs2, one per cycle.
+- Compares set a lane to all ones when true, zero otherwise.
+- psadd saturates to the signed lane range, psaddu to the unsigned one.
+Needs an assembler with .insn (any recent binutils); no other extensions.
+*/
+#pragma once
+
+#include <stdint.h>
+
+#define SIMD_OPCODE 0x2bu
+
+// funct7 values (Tile1 ExecOp PADD_B.. order)
+#define SIMD_OP_ADD    0
+#define SIMD_OP_SUB    1
+#define SIMD_OP_MIN    2  // signed
+#define SIMD_OP_MAX    3
+#define SIMD_OP_MINU   4  // unsigned
+#define SIMD_OP_MAXU   5
+#define SIMD_OP_CMPEQ  6
+#define SIMD_OP_CMPLT  7  // signed rs1 < rs2
+#define SIMD_OP_CMPLTU 8
+#define SIMD_OP_SADD   9  // signed saturating add
+#define SIMD_OP_SADDU  10 // unsigned saturating add
+
+#define SIMD_STR_(x) #x
+#define SIMD_STR(x)  SIMD_STR_(x)
+
+// rd = rs1 op rs2 with funct3/funct7 fixed at compile time
+#define SIMD_R(f3, f7, a, b) ({                                                       \
+  uint32_t simd_rd_;                                                                  \
+  asm(".insn r " SIMD_STR(SIMD_OPCODE) ", " SIMD_STR(f3) ", " SIMD_STR(f7) ", %0, %1, %2" \
+      : "=r"(simd_rd_) : "r"((uint32_t)(a)), "r"((uint32_t)(b)));                     \
+  simd_rd_;                                                                           \
+})
+
+// 4 x 8b lanes
+static inline uint32_t padd_b(uint32_t a, uint32_t b)    { return SIMD_R(0, SIMD_OP_ADD, a, b); }
+static inline uint32_t psub_b(uint32_t a, uint32_t b)    { return SIMD_R(0, SIMD_OP_SUB, a, b); }
+static inline uint32_t pmin_b(uint32_t a, uint32_t b)    { return SIMD_R(0, SIMD_OP_MIN, a, b); }
+static inline uint32_t pmax_b(uint32_t a, uint32_t b)    { return SIMD_R(0, SIMD_OP_MAX, a, b); }
+static inline uint32_t pminu_b(uint32_t a, uint32_t b)   { return SIMD_R(0, SIMD_OP_MINU, a, b); }
+static inline uint32_t pmaxu_b(uint32_t a, uint32_t b)   { return SIMD_R(0, SIMD_OP_MAXU, a, b); }
+static inline uint32_t pcmpeq_b(uint32_t a, uint32_t b)  { return SIMD_R(0, SIMD_OP_CMPEQ, a, b); }
+static inline uint32_t pcmplt_b(uint32_t a, uint32_t b)  { return SIMD_R(0, SIMD_OP_CMPLT, a, b); }
+static inline uint32_t pcmpltu_b(uint32_t a, uint32_t b) { return SIMD_R(0, SIMD_OP_CMPLTU, a, b); }
+static inline uint32_t psadd_b(uint32_t a, uint32_t b)   { return SIMD_R(0, SIMD_OP_SADD, a, b); }
+static inline uint32_t psaddu_b(uint32_t a, uint32_t b)  { return SIMD_R(0, SIMD_OP_SADDU, a, b); }
+
+// 2 x 16b lanes
+static inline uint32_t padd_h(uint32_t a, uint32_t b)    { return SIMD_R(1, SIMD_OP_ADD, a, b); }
+static inline uint32_t psub_h(uint32_t a, uint32_t b)    { return SIMD_R(1, SIMD_OP_SUB, a, b); }
+static inline uint32_t pmin_h(uint32_t a, uint32_t b)    { return SIMD_R(1, SIMD_OP_MIN, a, b); }
+static inline uint32_t pmax_h(uint32_t a, uint32_t b)    { return SIMD_R(1, SIMD_OP_MAX, a, b); }
+static inline uint32_t pminu_h(uint32_t a, uint32_t b)   { return SIMD_R(1, SIMD_OP_MINU, a, b); }
+static inline uint32_t pmaxu_h(uint32_t a, uint32_t b)   { return SIMD_R(1, SIMD_OP_MAXU, a, b); }
+static inline uint32_t pcmpeq_h(uint32_t a, uint32_t b)  { return SIMD_R(1, SIMD_OP_CMPEQ, a, b); }
+static inline uint32_t pcmplt_h(uint32_t a, uint32_t b)  { return SIMD_R(1, SIMD_OP_CMPLT, a, b); }
+static inline uint32_t pcmpltu_h(uint32_t a, uint32_t b) { return SIMD_R(1, SIMD_OP_CMPLTU, a, b); }
+static inline uint32_t psadd_h(uint32_t a, uint32_t b)   { return SIMD_R(1, SIMD_OP_SADD, a, b); }
+static inline uint32_t psaddu_h(uint32_t a, uint32_t b)  { return SIMD_R(1, SIMD_OP_SADDU, a, b); }
+
+// Lane packing helpers (plain RV32I)
+static inline uint32_t simd_splat_b(uint32_t v) { v &= 0xffu; v |= v << 8; return v | (v << 16); }
+static inline uint32_t simd_splat_h(uint32_t v) { v &= 0xffffu; return v | (v << 16); }
+static inline uint32_t simd_pack_h(uint32_t lo, uint32_t hi) { return (lo & 0xffffu) | (hi << 16); }
+static inline uint32_t simd_swap_h(uint32_t v) { return (v >> 16) | (v << 16); }
@@ -0,0 +1,190 @@
+// **********************************************************************
+// smile/progs/sci/hmm_step_simd.c
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Packed-SIMD version of hmm_step.c (same tables, same forward pass, same checksum)
+for measuring what Tile1's 2 x 16b lane ops buy on the trellis kernel.
+
+Changes vs hmm_step.c:
+- Each column is kept as 32 words of 2 x uint16 lanes, word w = states (2w, 2w+1).
+  Every value in this trellis stays below 2^16 (largest is about 48000); the adds
+  saturate (psaddu.h) so an out-of-range input clamps instead of wrapping.
+- The 21-way min-plus recurrence is factored the way the predecessor sets overlap:
+  the 4 step predecessors of state j depend only on j >> 2 and the 16 skip
+  predecessors only on j >> 4, and all members of a group share one -log(tau).
+  So per column we take 16 step minima (pminu.h over 4 words), 4 skip minima
+  (pminu.h over the step minima), and then each state pair needs one stay add,
+  one min, one emission add.  Same minimum as hmm_step.c, far fewer candidates.
+- No backpointer table (hmm_step.c fills it but never reads it).
+- Emissions still use log_em() (__mulsi3): the lane ops have no multiply.
+Result goes to 0x0100 and the low 8 bits are the exit code, as in hmm_step.c.
+*/
+
+#include <stdint.h>
+#include "simd.h"
+
+#define K_MER    3                  // size of DNA k-mer processed
+#define M        (1 << (2 * K_MER)) // 64 states
+#define N        26                 // number of events (matches toy data)
+#define W        (M / 2)            // packed words per column
+
+#define TAU_STAY 18                 // -log(p_stay), -log(p_step), -log(p_skip) (neg_log_ptau in hmm_step.c)
+#define TAU_STEP 12
+#define TAU_SKIP 41
+
+#define OUT_ADDR 0x0100u
+#define OUT      ((volatile uint32_t*)OUT_ADDR)
+
+// The fixed-point values for (level mean/stdv)
+static const int32_t mu_over_stdv[M] = {
+  192,100,158,120, 38,  6, 22, 10,134, 18,138,  0,142,102,110,134,
+  188, 68,176,100,148,156,156,140,150, 20,160, 14,196,140,176,152,
+  160, 60,134, 90, 34, 14, 24, 16,134, 20,144, 12,128, 84, 78,108,
+  214,100,186,134,150,132,146,132,146, 28,154, 24,232,166,188,190
+};
+
+// Event features (mean/stdv) for N = 26 events
+static const int32_t event_over_stdv[N] = {
+  24,142,164,51,63,50,70,75,136,181,101,13,172,137,133,177,191,29,148,79,94,142,200,97,70,126
+};
+
+// Software 32-bit signed multiply (GCC calls it for "a * b" on rv32i); same as hmm_step.c
+int __mulsi3(int a, int b)
+{
+  unsigned ua = (a < 0) ? (unsigned)(-a) : (unsigned)a;
+  unsigned ub = (b < 0) ? (unsigned)(-b) : (unsigned)b;
+  unsigned res = 0;
+
+  while (ub != 0u) {
+    if (ub & 1u) {
+      res += ua;
+    }
+    ua <<= 1;
+    ub >>= 1;
+  }
+
+  if ((a < 0) ^ (b < 0)) {
+    return -(int)res;
+  }
+  return (int)res;
+}
+
+// Simple emission: squared distance in mean/stdv space
+static inline int32_t log_em(int32_t event_mean_over_stdv, int32_t level_mean_over_stdv)
+{
+  int32_t dist = event_mean_over_stdv - level_mean_over_stdv;
+  return dist * dist;
+}
+
+// Emissions of states (2w, 2w+1) for one event, packed
+static inline uint32_t log_em2(int32_t event_mean_over_stdv, int w)
+{
+  return simd_pack_h((uint32_t)log_em(event_mean_over_stdv, mu_over_stdv[2 * w]),
+                     (uint32_t)log_em(event_mean_over_stdv, mu_over_stdv[2 * w + 1]));
+}
+
+static inline uint32_t lane_h(uint32_t v, int hi) { return hi ? v >> 16 : v & 0xffffu; }
+
+static uint32_t log_post2[W];     // normalized previous posteriors, 2 states per word
+static uint32_t cur_log_post2[W]; // current event posteriors
+static uint32_t step2[M / 8];     // step minima, word h = groups (2h, 2h+1)
+static uint32_t trans2[M / 4];    // best non-stay predecessor + tau for group p = j >> 2, both lanes
+
+static uint32_t run_trellis(void)
+{
+  const uint32_t t_stay = simd_splat_h(TAU_STAY);
+  const uint32_t t_step = simd_splat_h(TAU_STEP);
+  const uint32_t t_skip = simd_splat_h(TAU_SKIP);
+  int i, w, h, x, b;
+
+  // Initial probabilities (for event 0)
+  for (w = 0; w < W; w++) {
+    log_post2[w] = log_em2(event_over_stdv[0], w);
+  }
+
+  for (i = 1; i < N; i++) {    // events loop
+    // Step predecessors of group p are the states 16k + p (k = 0..3): for even p the
+    // pair (p, p+1) sits in words 8k + p/2, so one pminu.h tree covers two groups.
+    for (h = 0; h < M / 8; h++) {
+      step2[h] = pminu_h(pminu_h(log_post2[h], log_post2[8 + h]),
+                         pminu_h(log_post2[16 + h], log_post2[24 + h]));
+    }
+    // Skip predecessors of x = j >> 4 are the states 16a + 4b + x, i.e. the step
+    // groups 4b + x; group 4b + x is lane x & 1 of step2[2b + (x >> 1)].
+    const uint32_t skip_lo = pminu_h(pminu_h(step2[0], step2[2]), pminu_h(step2[4], step2[6])); // x = 0, 1
+    const uint32_t skip_hi = pminu_h(pminu_h(step2[1], step2[3]), pminu_h(step2[5], step2[7])); // x = 2, 3
+    for (x = 0; x < 4; x++) {
+      const uint32_t skip = psaddu_h(simd_splat_h(lane_h(x < 2 ? skip_lo : skip_hi, x & 1)), t_skip);
+      for (b = 0; b < 4; b++) {
+        const int p = 4 * x + b;
+        const uint32_t step = psaddu_h(simd_splat_h(lane_h(step2[p >> 1], p & 1)), t_step);
+        trans2[p] = pminu_h(step, skip);
+      }
+    }
+
+    // States loop, two at a time: both states of word w belong to group w >> 1
+    uint32_t col_min2 = 0xffffffffu;
+    for (w = 0; w < W; w++) {
+      const uint32_t best = pminu_h(psaddu_h(log_post2[w], t_stay), trans2[w >> 1]);
+      const uint32_t cur  = psaddu_h(log_em2(event_over_stdv[i], w), best);
+      cur_log_post2[w] = cur;
+      col_min2 = pminu_h(col_min2, cur);
+    }
+
+    // Normalize the posterior probs (avoid overflow)
+    col_min2 = pminu_h(col_min2, simd_swap_h(col_min2)); // column minimum in both lanes
+    for (w = 0; w < W; w++) {
+      log_post2[w] = psub_h(cur_log_post2[w], col_min2);
+    }
+  } // events loop
+
+  // Optimal end state (first minimum, as find_min_location) and checksum, as in hmm_step.c
+  int32_t  sum = 0;
+  uint32_t best_val = 0xffffffffu;
+  int      end_state = -1;
+  for (int j = 0; j < M; j++) {
+    const uint32_t v = lane_h(log_post2[j >> 1], j & 1);
+    sum += (int32_t)v;
+    if (v < best_val) {
+      best_val  = v;
+      end_state = j;
+    }
+  }
+  return (uint32_t)sum ^ ((uint32_t)end_state << 16);
+}
+
+// ---------------------------------------------------------------------
+// Bare-metal entry / exit glue
+// ---------------------------------------------------------------------
+
+// Set a0 = code, a7 = 93, then ECALL.
+static inline void exit_with_code(uint32_t code)
+{
+  __asm__ volatile(
+    "mv a0, %0\n"
+    "li a7, 93\n"
+    "ecall\n"
+    :
+    : "r"(code)
+    : "a0", "a7", "memory"
+  );
+}
+
+// Entry point: set stack pointer and jump to main.
+__attribute__((naked, section(".text.start")))
+void _start(void)
+{
+  __asm__ volatile(
+    "li   sp, 0x00004000\n"
+    "j    main\n"
+  );
+}
+
+int main(void)
+{
+  uint32_t result = run_trellis();
+  *OUT = result;
+  exit_with_code(result & 0xffu);
+  for (;;) { }
+}
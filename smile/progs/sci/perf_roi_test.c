@@ -0,0 +1,73 @@
+// **********************************************************************
+// smile/progs/sci/perf_roi_test.c
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+ * Region-of-interest measurement with the Tile1 counter CSRs (perf.h).
+ * Runs the LPV sum kernel between perf_roi_begin/end and writes
+ *   0x0100: cycles   0x0104: instret   0x0108: fetch-stall   0x010c: dmem-stall
+ *   0x0110: loads    0x0114: stores
+ * (low 32 bits each), then exits via ECALL 93 with 0 if the counts are
+ * self-consistent, or the number of the first failed check.
+ */
+#include <stdint.h>
+#include "perf.h"
+
+#define LPV_BASE ((volatile uint32_t *)0x00000200)
+#define OUT      ((volatile uint32_t *)0x00000100)
+#define N 16
+
+__attribute__((naked, section(".text.start")))
+void _start(void) {
+  __asm__ volatile (
+    "li sp, 0x00004000\n"
+    "j main\n"
+  );
+}
+
+static inline void exit_with_code(uint32_t code) {
+  __asm__ volatile (
+    "mv a0, %0\n"
+    "li a7, 93\n"
+    "ecall\n"
+    :
+    : "r"(code)
+    : "a0", "a7", "memory"
+  );
+  for (;;) {}
+}
+
+int main(void) {
+  uint32_t i;
+  for (i = 0; i < N; ++i) {
+    LPV_BASE[i] = i + 1;
+  }
+
+  perf_select(3, PERF_EV_FETCH_STALL);
+  perf_select(4, PERF_EV_DMEM_STALL);
+  perf_select(5, PERF_EV_LOAD);
+  perf_select(6, PERF_EV_STORE);
+
+  perf_roi_t roi;
+  perf_roi_begin(&roi);
+  uint32_t acc = 0;
+  for (i = 0; i < N; ++i) {
+    acc += LPV_BASE[i];
+  }
+  perf_roi_end(&roi);
+
+  OUT[0] = (uint32_t)roi.cycles;
+  OUT[1] = (uint32_t)roi.instret;
+  OUT[2] = (uint32_t)roi.hpm[0];
+  OUT[3] = (uint32_t)roi.hpm[1];
+  OUT[4] = (uint32_t)roi.hpm[2];
+  OUT[5] = (uint32_t)roi.hpm[3];
+
+  uint32_t code = 0;
+  if (acc != N * (N + 1) / 2)                               code = 1;
+  else if (roi.instret == 0 || roi.cycles < roi.instret)    code = 2; // at most one instr per cycle
+  else if (roi.hpm[2] < N)                                  code = 3; // every LPV element loaded
+  else if (roi.hpm[0] + roi.hpm[1] > roi.cycles)            code = 4; // stalls are a subset of cycles
+  exit_with_code(code);
+  return 0;
+}
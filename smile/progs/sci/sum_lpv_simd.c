@@ -0,0 +1,59 @@
+// **********************************************************************
+// smile/progs/sci/sum_lpv_simd.c
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+ * Packed-SIMD version of sum_lpv.c: same data (1..N), same sum at 0x00000100
+ * and exit code.  The LPV values are stored as 2 x uint16 per word at
+ * 0x00000200 and accumulated with padd.h into two lane sums, added at the end.
+ */
+#include <stdint.h>
+#include "simd.h"
+
+#define LPV_BASE  ((volatile uint32_t *)0x00000200) // 2 x uint16 per word
+#define SUM_ADDR  ((volatile uint32_t *)0x00000100)
+#define N 16                                        // even; lane sums must stay below 2^16
+
+// stack setup and entry point
+__attribute__((naked, section(".text.start")))
+void _start(void) {
+  __asm__ volatile (
+    "li sp, 0x00004000\n"
+    "j main\n"
+  );
+}
+
+// exit via ecall 93 with given code in a0
+static inline void exit_with_code(uint32_t code) {
+  __asm__ volatile (
+    "mv a0, %0\n"
+    "li a7, 93\n"
+    "ecall\n"
+    :
+    : "r"(code)
+    : "a0", "a7", "memory"
+  );
+  for (;;) {}
+}
+
+int main(void) {
+  uint32_t i;
+  // create your array of LPV data, 2 values per word: (1,2), (3,4), ...
+  uint32_t v = simd_pack_h(1u, 2u);
+  for (i = 0; i < N / 2; ++i) {
+    LPV_BASE[i] = v;
+    v = padd_h(v, 0x00020002u);
+  }
+
+  // now sum it up, two lanes at a time
+  uint32_t acc2 = 0;
+  for (i = 0; i < N / 2; ++i) {
+    acc2 = padd_h(acc2, LPV_BASE[i]);
+  }
+  uint32_t acc = (acc2 & 0xffffu) + (acc2 >> 16);
+
+  // write sum result in specified addr and exit with sum as code
+  *SUM_ADDR = acc;
+  exit_with_code(acc);
+  return 0;
+}
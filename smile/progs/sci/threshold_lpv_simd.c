@@ -0,0 +1,63 @@
+// **********************************************************************
+// smile/progs/sci/threshold_lpv_simd.c
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+ * Packed-SIMD version of threshold_lpv.c: same data (1..N), same count of
+ * values > THRESH, same result address and exit code.
+ * The LPV values are stored as int8 lanes, 4 per word at 0x00000200, so one
+ * pcmpltu.b tests 4 values and one psub.b adds the 0/-1 masks into 4 per-lane
+ * counts, which are folded into one number at the end.
+ */
+#include <stdint.h>
+#include "simd.h"
+
+#define LPV_BASE   ((volatile uint32_t *)0x00000200) // base addr of LPV data (4 x uint8 per word)
+#define COUNT_ADDR ((volatile uint32_t *)0x00000104)
+#define N 16                                         // multiple of 4, < 256 per lane
+#define THRESH 8
+
+__attribute__((naked, section(".text.start")))
+void _start(void) {
+  __asm__ volatile (
+    "li sp, 0x00004000\n"
+    "j main\n"
+  );
+}
+
+static inline void exit_with_code(uint32_t code) {
+  __asm__ volatile (
+    "mv a0, %0\n"
+    "li a7, 93\n"
+    "ecall\n"
+    :
+    : "r"(code)
+    : "a0", "a7", "memory"
+  );
+  for (;;) {}
+}
+
+int main(void) {
+  uint32_t i;
+  // create your array of LPV data, 4 values per word: bytes 1,2,3,4 then 5,6,7,8 ...
+  uint32_t v = 0x04030201u;
+  for (i = 0; i < N / 4; ++i) {
+    LPV_BASE[i] = v;
+    v = padd_b(v, 0x04040404u);
+  }
+
+  // count how many values exceed THRESH: lanes with THRESH < value read back as 0xff (-1)
+  const uint32_t thresh = simd_splat_b(THRESH);
+  uint32_t counts = 0;                      // 4 per-lane counts
+  for (i = 0; i < N / 4; ++i) {
+    counts = psub_b(counts, pcmpltu_b(thresh, LPV_BASE[i]));
+  }
+  counts += counts >> 16;                   // fold the lanes (each < 256, so no carries cross)
+  counts += counts >> 8;
+  uint32_t count = counts & 0xffu;
+
+  // write count result in specified addr and exit with count as code
+  *COUNT_ADDR = count;
+  exit_with_code(count);
+  return 0;
+}
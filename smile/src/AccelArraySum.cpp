@@ -22,7 +22,7 @@ extended to support more complex behaviors (e.g., streaming access patterns, non
 #include <iostream>
 
 AccelArraySum::AccelArraySum(smem::MemoryPort& mem)
-  : mem_(mem) {
+  : mem_(mem), mem_direct_(&mem) {
 }
 
 void AccelArraySum::issue(uint32_t raw_inst,
@@ -73,7 +73,7 @@ void AccelArraySum::issue(uint32_t raw_inst,
   uint32_t sum = 0;
   for (uint32_t i = 0; i < len; ++i) {
     const uint32_t addr = base + 4u * i;
-    const uint32_t val  = mem_.read32(addr);
+    const uint32_t val  = mem_direct_.read32(addr);
     sum += val;
   }
 
@@ -91,9 +91,9 @@ uint32_t AccelArraySum::read_response() {
 }
 
 uint32_t AccelArraySum::mem_load32(uint32_t addr) {
-  return mem_.read32(addr);
+  return mem_direct_.read32(addr);
 }
 
 void AccelArraySum::mem_store32(uint32_t addr, uint32_t data) {
-  mem_.write32(addr, data);
+  mem_direct_.write32(addr, data);
 }
@@ -18,7 +18,7 @@ issuing one read request at a time and consuming one response at a time.
 #include "Tile1.hpp"
 
 AccelArraySumMc::AccelArraySumMc(smem::MemoryPort& mem)
-  : mem_(mem) {
+  : mem_(mem), mem_direct_(&mem) {
 }
 
 void AccelArraySumMc::issue(uint32_t raw_inst,
@@ -72,14 +72,15 @@ void AccelArraySumMc::tick() {
   // Phase A: issue one read when the memory port can accept a request.
   if (!waiting_mem_) {
     if (mem_.can_request()) {
-      mem_.request_read32(base_ + 4u * idx_);
+      mem_.request_read32_tagged(base_ + 4u * idx_, kMemTag);
       waiting_mem_ = true;
     }
     return;
   }
 
   // Phase B: consume one read response and advance to the next index.
-  if (mem_.resp_valid()) {
+  // Our requests carry kMemTag; anything else at the head belongs to Tile1.
+  if (mem_.resp_valid() && mem_.resp_tag() == kMemTag) {
     sum_ += mem_.resp_data();
     mem_.resp_consume();
     idx_++;
@@ -97,9 +98,9 @@ uint32_t AccelArraySumMc::read_response() {
 }
 
 uint32_t AccelArraySumMc::mem_load32(uint32_t addr) {
-  return mem_.read32(addr);
+  return mem_direct_.read32(addr);
 }
 
 void AccelArraySumMc::mem_store32(uint32_t addr, uint32_t data) {
-  mem_.write32(addr, data);
+  mem_direct_.write32(addr, data);
 }
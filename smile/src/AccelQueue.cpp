@@ -0,0 +1,59 @@
+// **********************************************************************
+// smile/src/AccelQueue.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Command/response queues around a v1 accelerator (see AccelQueue.hpp).
+*/
+
+#include "AccelQueue.hpp"
+
+#include <cascade/Cascade.hpp>
+
+AccelQueue::AccelQueue(AccelPort& inner, uint32_t depth)
+  : inner_(inner), depth_(depth) {
+  assert_always(depth >= 1u && depth <= kMaxDepth, "AccelQueue depth must be 1..AccelQueue::kMaxDepth");
+}
+
+void AccelQueue::issue(uint32_t raw_inst, uint32_t pc, uint32_t rs1_val, uint32_t rs2_val) {
+  issue_tagged(raw_inst, pc, rs1_val, rs2_val, 0);
+}
+
+void AccelQueue::issue_tagged(uint32_t raw_inst, uint32_t pc, uint32_t rs1_val, uint32_t rs2_val, uint32_t tag) {
+  assert_always(!busy(), "AccelQueue command issued while full");
+  cmds_[(cmd_head_ + cmd_count_) % kMaxDepth] = Cmd{raw_inst, pc, rs1_val, rs2_val, tag};
+  cmd_count_++;
+  start_next(); // an idle accelerator starts in the issue cycle, as it would under v1
+}
+
+void AccelQueue::tick() {
+  inner_.tick();
+  collect();
+  start_next();
+}
+
+uint32_t AccelQueue::read_response() {
+  assert_always(resp_count_ != 0, "AccelQueue response read while empty");
+  const uint32_t data = resps_[resp_head_].data;
+  resp_head_ = (resp_head_ + 1u) % kMaxDepth;
+  resp_count_--;
+  return data;
+}
+
+void AccelQueue::start_next() {
+  if (in_service_ || cmd_count_ == 0 || inner_.busy()) return;
+  const Cmd& c = cmds_[cmd_head_];
+  inner_.issue(c.raw, c.pc, c.rs1, c.rs2);
+  in_service_  = true;
+  service_tag_ = c.tag;
+  cmd_head_ = (cmd_head_ + 1u) % kMaxDepth;
+  cmd_count_--;
+  collect(); // single-cycle accelerators answer inside issue()
+}
+
+void AccelQueue::collect() {
+  if (!in_service_ || !inner_.has_response()) return;
+  resps_[(resp_head_ + resp_count_) % kMaxDepth] = Resp{inner_.read_response(), service_tag_};
+  resp_count_++; // never overflows: busy() counts the command in service
+  in_service_ = false;
+}
@@ -0,0 +1,122 @@
+// **********************************************************************
+// smile/src/BranchPredictor.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Direction tables, BTB and return-address stack behind BranchPredictor.hpp.
+*/
+#include "BranchPredictor.hpp"
+
+#include <cascade/Cascade.hpp>
+
+BranchPredictor::BranchPredictor(const Config& cfg) : cfg_(cfg) {
+  assert_always(cfg.table_bits >= 1 && cfg.table_bits <= 20, "branch predictor table_bits must be 1..20");
+  assert_always((cfg.btb_entries & (cfg.btb_entries - 1)) == 0, "BTB entries must be 0 or a power of two");
+  assert_always(cfg.ras_depth <= 64, "RAS depth must be 0..64");
+  reset();
+}
+
+void BranchPredictor::reset() {
+  table_mask_ = (1u << cfg_.table_bits) - 1u;
+  counters_.assign(cfg_.scheme == Scheme::Btfn ? 0u : table_mask_ + 1u, 1u); // weakly not-taken
+  history_ = 0;
+  btb_.assign(cfg_.btb_entries, BtbEntry{});
+  ras_.assign(cfg_.ras_depth, 0u);
+  ras_top_ = ras_count_ = 0;
+  branches_ = dir_misses_ = target_misses_ = 0;
+  jumps_ = jump_misses_ = returns_ = ras_misses_ = 0;
+  btb_lookups_ = btb_hits_ = 0;
+}
+
+const char* BranchPredictor::scheme_name() const {
+  switch (cfg_.scheme) {
+    case Scheme::Btfn:    return "btfn";
+    case Scheme::Bimodal: return "bimodal";
+    default:              return "gshare";
+  }
+}
+
+uint32_t BranchPredictor::index(uint32_t pc) const {
+  const uint32_t slot = pc >> 2;
+  return (cfg_.scheme == Scheme::Gshare ? slot ^ history_ : slot) & table_mask_;
+}
+
+bool BranchPredictor::btb_lookup(uint32_t pc, uint32_t* target) {
+  btb_lookups_++;
+  const BtbEntry& e = btb_[(pc >> 2) & (cfg_.btb_entries - 1u)];
+  if (!e.valid || e.pc != pc) return false;
+  btb_hits_++;
+  *target = e.target;
+  return true;
+}
+
+void BranchPredictor::btb_update(uint32_t pc, uint32_t target) {
+  btb_[(pc >> 2) & (cfg_.btb_entries - 1u)] = BtbEntry{pc, target, true};
+}
+
+bool BranchPredictor::branch(uint32_t pc, uint32_t target, bool taken) {
+  branches_++;
+  bool pred_taken = target <= pc; // BTFN
+  uint8_t* ctr = nullptr;
+  if (cfg_.scheme != Scheme::Btfn) {
+    ctr = &counters_[index(pc)];
+    pred_taken = *ctr >= 2u;
+  }
+  uint32_t pred_target = target; // ideal targets unless a BTB is modelled
+  bool     have_target = true;
+  if (cfg_.btb_entries != 0 && pred_taken) have_target = btb_lookup(pc, &pred_target);
+  const bool front_taken = pred_taken && have_target; // no target: the front end falls through
+
+  bool miss = false;
+  if (front_taken != taken) {
+    miss = true;
+    if (pred_taken == taken) target_misses_++; // direction was right, the BTB was not
+    else                     dir_misses_++;
+  } else if (taken && pred_target != target) {
+    miss = true;                               // stale BTB target
+    target_misses_++;
+  }
+
+  if (ctr) *ctr = taken ? static_cast<uint8_t>(*ctr + (*ctr < 3u)) : static_cast<uint8_t>(*ctr - (*ctr > 0u));
+  if (cfg_.scheme == Scheme::Gshare) history_ = ((history_ << 1) | (taken ? 1u : 0u)) & table_mask_;
+  if (taken && cfg_.btb_entries != 0) btb_update(pc, target);
+  return miss;
+}
+
+bool BranchPredictor::jump(uint32_t pc, uint32_t target, uint32_t rd, uint32_t rs1, bool indirect) {
+  jumps_++;
+  const bool link_rd  = rd == 1u || rd == 5u;  // ra / t0
+  const bool link_rs1 = rs1 == 1u || rs1 == 5u;
+  bool miss = false;
+  if (indirect && rd == 0u && link_rs1 && cfg_.ras_depth != 0) { // return
+    returns_++;
+    if (ras_count_ == 0) {
+      miss = true;
+    } else {
+      ras_top_ = (ras_top_ + cfg_.ras_depth - 1u) % cfg_.ras_depth;
+      ras_count_--;
+      miss = ras_[ras_top_] != target;
+    }
+    if (miss) ras_misses_++;
+  } else if (cfg_.btb_entries != 0) {
+    uint32_t pred_target = 0;
+    miss = !btb_lookup(pc, &pred_target) || pred_target != target;
+    btb_update(pc, target);
+  } else {
+    miss = indirect; // ideal targets cover direct jumps only
+  }
+  if (link_rd && cfg_.ras_depth != 0) { // call: push the return address
+    ras_[ras_top_] = pc + 4u;
+    ras_top_ = (ras_top_ + 1u) % cfg_.ras_depth;
+    if (ras_count_ < cfg_.ras_depth) ras_count_++;
+  }
+  if (miss) jump_misses_++;
+  return miss;
+}
+
+bool parse_bpred_scheme(const std::string& name, BranchPredictor::Scheme* out) {
+  if (name == "btfn")    { *out = BranchPredictor::Scheme::Btfn;    return true; }
+  if (name == "bimodal") { *out = BranchPredictor::Scheme::Bimodal; return true; }
+  if (name == "gshare")  { *out = BranchPredictor::Scheme::Gshare;  return true; }
+  return false;
+}
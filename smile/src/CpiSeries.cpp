@@ -0,0 +1,61 @@
+// **********************************************************************
+// smile/src/CpiSeries.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+CSV writer behind -cpi_interval: one row of CPI stack deltas per interval.
+*/
+#include "CpiSeries.hpp"
+
+bool CpiSeries::open(const std::string& path, uint64_t interval, const Tile1& tile, std::string* err) {
+  close();
+  if (interval == 0) {
+    if (err) *err = "interval must be > 0";
+    return false;
+  }
+  f_ = fopen(path.c_str(), "w");
+  if (!f_) {
+    if (err) *err = "cannot open " + path;
+    return false;
+  }
+  fprintf(f_, "cycle,inst,cpi");
+  for (size_t i = 0; i < Tile1::kCpiSlots; ++i) {
+    fprintf(f_, ",%s", Tile1::cpi_slot_name(static_cast<Tile1::CpiSlot>(i)));
+  }
+  fprintf(f_, "\n");
+  interval_   = interval;
+  rows_       = 0;
+  last_cycle_ = tile.cycle_count();
+  last_inst_  = tile.inst_count();
+  for (size_t i = 0; i < Tile1::kCpiSlots; ++i) last_[i] = tile.cpi_cycles(static_cast<Tile1::CpiSlot>(i));
+  next_ = last_cycle_ + interval_;
+  return true;
+}
+
+void CpiSeries::close() {
+  if (f_) fclose(f_);
+  f_ = nullptr;
+}
+
+void CpiSeries::sample(const Tile1& tile) {
+  const uint64_t cycle = tile.cycle_count();
+  while (next_ <= cycle) next_ += interval_;
+  if (!f_ || cycle == last_cycle_) return;
+  const uint64_t insts = tile.inst_count() - last_inst_;
+  fprintf(f_, "%llu,%llu,%.4f", (unsigned long long)cycle, (unsigned long long)insts,
+          insts ? static_cast<double>(cycle - last_cycle_) / static_cast<double>(insts) : 0.0);
+  for (size_t i = 0; i < Tile1::kCpiSlots; ++i) {
+    const uint64_t now = tile.cpi_cycles(static_cast<Tile1::CpiSlot>(i));
+    fprintf(f_, ",%llu", (unsigned long long)(now - last_[i]));
+    last_[i] = now;
+  }
+  fprintf(f_, "\n");
+  last_cycle_ = cycle;
+  last_inst_  = tile.inst_count();
+  rows_++;
+}
+
+void CpiSeries::finish(const Tile1& tile) {
+  sample(tile);
+  close();
+}
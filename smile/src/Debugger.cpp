@@ -25,6 +25,7 @@ struct CycleInfo {
   uint32_t instruction = 0;
   uint32_t mcause = 0;
   bool executed = false;
+  int cycles = 0;          // cycles this step accounted for (>1 when Tile1 retired a basic block)
   bool breakpoint_trap_observed = false;
   bool log_breakpoint_snapshot = false;
   bool user_breakpoint_hit = false;
@@ -42,6 +43,26 @@ static bool has_active_threads(const DebuggerState& state) {
   return state.threads[0].active || state.threads[1].active;
 }
 
+// Hardware threads (harts) live in the tile, which switches between them itself; the
+// debugger only observes them.  Thread index t is then hart t.
+static int thread_count(const DebuggerState& state) {
+  return state.tile.hw_threads() > 1 ? static_cast<int>(state.tile.hw_threads()) : 2;
+}
+
+static ThreadContext thread_view(const DebuggerState& state, int t) {
+  if (state.tile.hw_threads() <= 1) return state.threads[t];
+  ThreadContext c;
+  state.tile.hart_context(static_cast<uint32_t>(t), &c);
+  return c;
+}
+
+static bool valid_thread(const DebuggerState& state, int t) {
+  if (t >= 0 && t < thread_count(state)) return true;
+  std::cout << COLOR_ERR << "Invalid thread index (expected 0.." << thread_count(state) - 1 << ")"
+            << COLOR_RESET << std::endl;
+  return false;
+}
+
 static std::string to_lower(std::string value) {
   std::transform(value.begin(), value.end(), value.begin(),
     [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
@@ -91,7 +112,7 @@ static void load_breakpoints_from_file(DebuggerState& state) {
     return;
   }
 
-  state.breakpoints.clear();
+  state.clear_breakpoints();
   std::string line;
   while (std::getline(in, line)) {
     std::string token;
@@ -101,9 +122,7 @@ static void load_breakpoints_from_file(DebuggerState& state) {
     }
     uint32_t addr = 0;
     if (parse_u32(token, &addr)) {
-      if (std::find(state.breakpoints.begin(), state.breakpoints.end(), addr) == state.breakpoints.end()) {
-        state.breakpoints.push_back(addr);
-      }
+      state.add_breakpoint(addr);
     }
   }
 
@@ -127,14 +146,15 @@ static void print_breakpoint_snapshot(DebuggerState& state, int thread_index,
             << " mstatus=0x" << std::setw(8) << state.tile.mstatus()
             << std::dec << COLOR_RESET << std::endl;
 
+  const ThreadContext ctx = thread_view(state, thread_index);
   std::cout << "  regs:";
   for (int reg = 1; reg <= 7; ++reg) {
     std::cout << " x" << reg << "=0x"
-              << std::hex << std::setw(8) << state.threads[thread_index].regs[reg]
+              << std::hex << std::setw(8) << ctx.regs[reg]
               << std::dec;
   }
   std::cout << " a4=0x"
-            << std::hex << std::setw(8) << state.threads[thread_index].regs[14]
+            << std::hex << std::setw(8) << ctx.regs[14]
             << std::dec;
 
   std::cout << std::endl << "  mem:";
@@ -168,14 +188,15 @@ static void print_registers(const DebuggerState& state) {
   std::ios_base::fmtflags old_flags = std::cout.flags();
   char old_fill = std::cout.fill('0');
 
-  for (int t = 0; t < 2; ++t) {
+  for (int t = 0; t < thread_count(state); ++t) {
+    const ThreadContext ctx = thread_view(state, t);
     std::cout << "[T" << t << "] pc=0x"
-              << std::hex << std::setw(8) << state.threads[t].pc
-              << std::dec << " active=" << (state.threads[t].active ? "yes" : "no")
+              << std::hex << std::setw(8) << ctx.pc
+              << std::dec << " active=" << (ctx.active ? "yes" : "no")
               << std::endl;
     for (int r = 0; r < 32; ++r) {
       std::cout << "  x" << std::setw(2) << r << "=0x"
-                << std::hex << std::setw(8) << state.threads[t].regs[r]
+                << std::hex << std::setw(8) << ctx.regs[r]
                 << std::dec;
       if ((r % 4) == 3) {
         std::cout << std::endl;
@@ -191,21 +212,21 @@ static void print_registers(const DebuggerState& state) {
 }
 
 static void print_registers_for_thread(const DebuggerState& state, int t) {
-  if (t < 0 || t > 1) {
-    std::cout << COLOR_ERR << "Invalid thread index (expected 0 or 1)" << COLOR_RESET << std::endl;
+  if (!valid_thread(state, t)) {
     return;
   }
 
   std::ios_base::fmtflags old_flags = std::cout.flags();
   char old_fill = std::cout.fill('0');
 
+  const ThreadContext ctx = thread_view(state, t);
   std::cout << "[T" << t << "] pc=0x"
-            << std::hex << std::setw(8) << state.threads[t].pc
-            << std::dec << " active=" << (state.threads[t].active ? "yes" : "no")
+            << std::hex << std::setw(8) << ctx.pc
+            << std::dec << " active=" << (ctx.active ? "yes" : "no")
             << std::endl;
   for (int r = 0; r < 32; ++r) {
     std::cout << "  x" << std::setw(2) << r << "=0x"
-              << std::hex << std::setw(8) << state.threads[t].regs[r]
+              << std::hex << std::setw(8) << ctx.regs[r]
               << std::dec;
     if ((r % 4) == 3) {
       std::cout << std::endl;
@@ -220,8 +241,7 @@ static void print_registers_for_thread(const DebuggerState& state, int t) {
 }
 
 static void print_single_register(const DebuggerState& state, int t, int r) {
-  if (t < 0 || t > 1) {
-    std::cout << COLOR_ERR << "Invalid thread index (expected 0 or 1)" << COLOR_RESET << std::endl;
+  if (!valid_thread(state, t)) {
     return;
   }
   if (r < 0 || r >= 32) {
@@ -232,11 +252,12 @@ static void print_single_register(const DebuggerState& state, int t, int r) {
   std::ios_base::fmtflags old_flags = std::cout.flags();
   char old_fill = std::cout.fill('0');
 
+  const ThreadContext ctx = thread_view(state, t);
   std::cout << "[T" << t << "] x" << r
-            << "=0x" << std::hex << std::setw(8) << state.threads[t].regs[r]
+            << "=0x" << std::hex << std::setw(8) << ctx.regs[r]
             << std::dec
-            << " (pc=0x" << std::hex << std::setw(8) << state.threads[t].pc
-            << std::dec << " active=" << (state.threads[t].active ? "yes" : "no")
+            << " (pc=0x" << std::hex << std::setw(8) << ctx.pc
+            << std::dec << " active=" << (ctx.active ? "yes" : "no")
             << ")"
             << std::endl;
 
@@ -260,59 +281,11 @@ static void dump_memory(smem::MemoryPort& mem, uint32_t addr, std::size_t count)
   std::cout.flags(old_flags);
 }
 
-static CycleInfo execute_cycle(DebuggerState& state, bool honor_breakpoints) {
-  CycleInfo info;
-  if (!has_active_threads(state)) {
-    return info;
-  }
-
-  // Fast path for the common case:
-  // with -sw_threads=1 we always execute thread 0 and skip round-robin selection.
-  // This avoids extra per-cycle scheduler work and prevents accidental dual-context
-  // execution from inflating instruction/counter totals.
-  if (state.configured_threads == 1) {
-    state.current_thread = 0;
-    if (!state.threads[0].active) {
-      return info;
-    }
-  } else {
-    int attempts = 0;
-    do {
-      state.current_thread = (state.current_thread + 1) & 1;
-      ++attempts;
-      if (state.threads[state.current_thread].active) {
-        break;
-      }
-    } while (attempts < 2);
-
-    if (!state.threads[state.current_thread].active) {
-      return info;
-    }
-  }
-
-  ThreadContext& context = state.threads[state.current_thread];
-
-  if (honor_breakpoints) {
-    if (std::find(state.breakpoints.begin(), state.breakpoints.end(), context.pc) != state.breakpoints.end()) {
-      info.thread = state.current_thread;
-      info.begin_pc = context.pc;
-      info.instruction = state.mem.read32(context.pc);
-      info.user_breakpoint_hit = true;
-      info.mcause = state.tile.mcause();
-      return info;
-    }
-  }
-
-  const uint32_t begin_pc = context.pc;
-  state.tile.load_context(context); // load thread context into tile (sets tile's PC and RF to thread's saved state)
-  Sim::run();                       // run one simulated cycle (executes one instruction and updates tile state, including PC/RF)
-  state.tile.save_context(context); // save context back out
-  state.cycle++;
-
+// Post-cycle bookkeeping shared by execute_cycle() and the single-thread fast path:
+// exit detection plus breakpoint/ecall trap observation for state.current_thread.
+static void observe_cycle(DebuggerState& state, uint32_t begin_pc, CycleInfo& info) {
   info.executed = true;
-  info.thread = state.current_thread;
   info.begin_pc = begin_pc;
-  info.instruction = state.mem.read32(begin_pc);
   info.mcause = state.tile.mcause();
 
   if (state.tile.has_exited()) {
@@ -327,7 +300,7 @@ static CycleInfo execute_cycle(DebuggerState& state, bool honor_breakpoints) {
     state.threads[0].active = false;
     state.threads[1].active = false;
     info.program_exited = true;
-    return info;
+    return;
   }
   
   // if causes says breakpoint…
@@ -358,7 +331,101 @@ static CycleInfo execute_cycle(DebuggerState& state, bool honor_breakpoints) {
     state.saw_ecall_trap[state.current_thread] = true;
     state.ecall_mepc[state.current_thread] = state.tile.mepc();
   }
+}
 
+// Hardware threads: the tile picks the hart each cycle, the debugger just clocks it.  A user
+// breakpoint stops the run before any live hart executes from that pc; trap observation
+// follows whichever hart ran (debugger-side bookkeeping stays on thread 0).
+static CycleInfo execute_hart_cycle(DebuggerState& state, bool honor_breakpoints) {
+  CycleInfo info;
+  if (!state.threads[0].active) {
+    return info;
+  }
+  if (honor_breakpoints) {
+    for (int h = 0; h < thread_count(state); ++h) {
+      const ThreadContext ctx = thread_view(state, h);
+      if (ctx.active && state.breakpoint_set.count(ctx.pc) != 0) {
+        info.thread = h;
+        info.begin_pc = ctx.pc;
+        info.instruction = state.mem.read32(ctx.pc);
+        info.user_breakpoint_hit = true;
+        info.mcause = state.tile.mcause();
+        return info;
+      }
+    }
+  }
+  state.current_thread = 0;
+  state.tile.set_tick_budget(1u);
+  Sim::run();
+  state.tile.save_context(state.threads[0]);
+  info.cycles = 1;
+  state.cycle += 1;
+  info.thread = static_cast<int>(state.tile.current_hart());
+  const uint32_t begin_pc = state.tile.last_pc();
+  info.instruction = state.mem_direct.read32(begin_pc);
+  observe_cycle(state, begin_pc, info);
+  return info;
+}
+
+// max_insts > 1 lets Tile1's block engine retire several instructions in one Sim::run()
+// (single software thread only; with two threads we keep per-instruction interleaving).
+static CycleInfo execute_cycle(DebuggerState& state, bool honor_breakpoints, int max_insts = 1) {
+  if (state.tile.hw_threads() > 1) {
+    return execute_hart_cycle(state, honor_breakpoints);
+  }
+  CycleInfo info;
+  if (!has_active_threads(state)) {
+    return info;
+  }
+
+  // Fast path for the common case:
+  // with -sw_threads=1 we always execute thread 0 and skip round-robin selection.
+  // This avoids extra per-cycle scheduler work and prevents accidental dual-context
+  // execution from inflating instruction/counter totals.
+  if (state.configured_threads == 1) {
+    state.current_thread = 0;
+    if (!state.threads[0].active) {
+      return info;
+    }
+  } else {
+    int attempts = 0;
+    do {
+      state.current_thread = (state.current_thread + 1) & 1;
+      ++attempts;
+      if (state.threads[state.current_thread].active) {
+        break;
+      }
+    } while (attempts < 2);
+
+    if (!state.threads[state.current_thread].active) {
+      return info;
+    }
+  }
+
+  ThreadContext& context = state.threads[state.current_thread];
+
+  if (honor_breakpoints) {
+    if (state.breakpoint_set.count(context.pc) != 0) {
+      info.thread = state.current_thread;
+      info.begin_pc = context.pc;
+      info.instruction = state.mem.read32(context.pc);
+      info.user_breakpoint_hit = true;
+      info.mcause = state.tile.mcause();
+      return info;
+    }
+  }
+
+  const uint32_t begin_pc = context.pc;
+  state.tile.load_context(context); // load thread context into tile (sets tile's PC and RF to thread's saved state)
+  state.tile.set_tick_budget(state.configured_threads == 1 && max_insts > 1 ? static_cast<uint32_t>(max_insts) : 1u);
+  Sim::run();                       // run one simulated cycle (executes one instruction and updates tile state, including PC/RF)
+  state.tile.save_context(context); // save context back out
+  info.cycles = static_cast<int>(state.tile.last_tick_cycles());
+  state.cycle += info.cycles;
+
+  info.thread = state.current_thread;
+  info.instruction = state.mem_direct.read32(begin_pc);
+  observe_cycle(state, begin_pc, info);
   return info;
 }
 
@@ -463,8 +530,7 @@ static bool handle_command_line(DebuggerState& state, const std::string& raw_lin
       std::cout << COLOR_ERR << "Invalid address" << COLOR_RESET << std::endl;
       return true;
     }
-    if (std::find(state.breakpoints.begin(), state.breakpoints.end(), addr) == state.breakpoints.end()) {
-      state.breakpoints.push_back(addr);
+    if (state.add_breakpoint(addr)) {
       save_breakpoints_to_file(state);
       std::cout << "Breakpoint added at 0x"
                 << hex32(addr) << std::endl;
@@ -483,9 +549,7 @@ static bool handle_command_line(DebuggerState& state, const std::string& raw_lin
       std::cout << COLOR_ERR << "Invalid address" << COLOR_RESET << std::endl;
       return true;
     }
-    auto it = std::find(state.breakpoints.begin(), state.breakpoints.end(), addr);
-    if (it != state.breakpoints.end()) {
-      state.breakpoints.erase(it);
+    if (state.remove_breakpoint(addr)) {
       save_breakpoints_to_file(state);
       std::cout << "Breakpoint removed at 0x" << hex32(addr) << std::endl;
     } else {
@@ -493,7 +557,7 @@ static bool handle_command_line(DebuggerState& state, const std::string& raw_lin
     }
   } else if (cmd == "clear") {
     if (!state.breakpoints.empty()) {
-      state.breakpoints.clear();
+      state.clear_breakpoints();
       save_breakpoints_to_file(state);
     }
     std::cout << "All breakpoints cleared" << std::endl;
@@ -579,8 +643,8 @@ static bool handle_command_line(DebuggerState& state, const std::string& raw_lin
               << "  break <addr>       - set breakpoint at PC address\n"
               << "  delete <addr>      - remove breakpoint at PC address\n"
               << "  clear              - remove all breakpoints\n"
-              << "  regs               - dump all registers for both threads\n"
-              << "  regs <t>           - dump registers for thread t (0 or 1)\n"
+              << "  regs               - dump all registers for every thread\n"
+              << "  regs <t>           - dump registers for thread t (0 or 1; hart t with -hw_threads)\n"
               << "  regs <t>:<reg>     - dump register x<reg> for thread t\n"
               << "  mem <addr> [count] - dump memory words\n"
               << "  trace [on|off]     - toggle per-cycle tracing\n"
@@ -618,7 +682,7 @@ static bool handle_command_line(DebuggerState& state, const std::string& raw_lin
 } // namespace
 
 DebuggerState::DebuggerState(Tile1& t, smem::MemoryPort& m, int thread_count)
-  : tile(t), mem(m),
+  : tile(t), mem(m), mem_direct(&m),
     configured_threads((thread_count >= 2) ? 2 : 1) {
   reset();
 }
@@ -643,18 +707,73 @@ void DebuggerState::reset() {
   current_thread = 1;
   cycle = 0;
   trace_enabled = false;
+  clear_breakpoints();
+}
+
+bool DebuggerState::add_breakpoint(uint32_t addr) {
+  if (!breakpoint_set.insert(addr).second) return false;
+  breakpoints.push_back(addr);
+  return true;
+}
+
+bool DebuggerState::remove_breakpoint(uint32_t addr) {
+  if (breakpoint_set.erase(addr) == 0) return false;
+  breakpoints.erase(std::find(breakpoints.begin(), breakpoints.end(), addr));
+  return true;
+}
+
+void DebuggerState::clear_breakpoints() {
   breakpoints.clear();
+  breakpoint_set.clear();
+}
+
+// Single-active-thread fast path for auto_run: the thread's context stays loaded in the
+// tile for the whole batch (load/save once instead of every cycle), so each cycle costs
+// one Sim::run() plus the trap/exit checks execute_cycle() does.
+static void auto_run_single(DebuggerState& state, int thread, int max_cycles) {
+  ThreadContext& context = state.threads[thread];
+  state.current_thread = thread;
+  state.tile.load_context(context);
+  int done = 0;
+  while (done < max_cycles) {
+    const uint32_t begin_pc = state.tile.pc();
+    const int left = max_cycles - done;
+    state.tile.set_tick_budget(state.configured_threads == 1 && left > 1 ? static_cast<uint32_t>(left) : 1u);
+    Sim::run();
+    CycleInfo info;
+    info.thread = thread;
+    info.cycles = static_cast<int>(state.tile.last_tick_cycles());
+    state.cycle += info.cycles;
+    done += info.cycles;
+    observe_cycle(state, begin_pc, info);
+    if (info.log_breakpoint_snapshot) {
+      state.tile.save_context(context); // snapshot prints from the thread context
+      print_breakpoint_snapshot(state, thread, info.begin_pc, info.mcause);
+    }
+    if (info.program_exited) {
+      break;
+    }
+  }
+  state.tile.save_context(context);
 }
 
 void auto_run(DebuggerState& state, int max_cycles) {
-  for (int i = 0; i < max_cycles; ++i) {
+  const bool t0 = state.threads[0].active;
+  const bool t1 = state.threads[1].active && state.configured_threads == 2;
+  if (t0 != t1 && state.tile.hw_threads() == 1) { // exactly one runnable thread: nothing to interleave
+    auto_run_single(state, t0 ? 0 : 1, max_cycles);
+    return;
+  }
+  int done = 0;
+  while (done < max_cycles) {
     if (!has_active_threads(state)) {
       break;
     }
-    CycleInfo info = execute_cycle(state, false);
+    CycleInfo info = execute_cycle(state, false, max_cycles - done);
     if (!info.executed) {
       break;
     }
+    done += info.cycles;
     if (info.log_breakpoint_snapshot) {
       print_breakpoint_snapshot(state, info.thread, info.begin_pc, info.mcause);
     }
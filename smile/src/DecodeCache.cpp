@@ -0,0 +1,49 @@
+// **********************************************************************
+// smile/src/DecodeCache.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Fill/flush side of the Tile1 predecode cache (hot lookups are inline in the header).
+*/
+#include "DecodeCache.hpp"
+#include <cascade/Cascade.hpp>
+
+namespace {
+
+// Registers an instruction touches, for Tile1's load scoreboard.  Anything that may read
+// or write state beyond its encoded registers claims all of them (waits for every load).
+uint32_t reg_mask(ExecOp op, const Instruction& in) {
+  const uint32_t rd = 1u << in.rd, rs1 = 1u << in.rs1, rs2 = 1u << in.rs2;
+  uint32_t m = ~0u;
+  if (op >= ExecOp::ADD && op <= ExecOp::MULW)        m = rd | rs1 | rs2;
+  else if (op >= ExecOp::ADDI && op <= ExecOp::ANDI)  m = rd | rs1;
+  else if (op == ExecOp::LUI || op == ExecOp::AUIPC || op == ExecOp::JAL) m = rd;
+  else if (op >= ExecOp::LB && op <= ExecOp::LHU)     m = rd | rs1;
+  else if (op >= ExecOp::SB && op <= ExecOp::BGEU)    m = rs1 | rs2; // stores, branches
+  else if (op == ExecOp::JALR)                        m = rd | rs1;
+  else if (op >= ExecOp::PADD_B && op <= ExecOp::PSADDU_H) m = rd | rs1 | rs2;
+  return m & ~1u;
+}
+
+} // namespace
+
+DecodeCache::DecodeCache(size_t entries) {
+  assert_always(entries != 0 && (entries & (entries - 1)) == 0, "DecodeCache size must be a power of two");
+  entries_.resize(entries);
+  mask_ = static_cast<uint32_t>(entries - 1);
+}
+
+const DecodeCache::Entry& DecodeCache::fill(uint32_t pc, uint32_t raw) {
+  Entry& e = entries_[(pc >> 2) & mask_];
+  e.pc    = pc;
+  e.raw   = raw;
+  e.instr = Instruction(raw);
+  e.op    = resolve_exec_op(e.instr);
+  e.regs  = reg_mask(e.op, e.instr);
+  e.valid = true;
+  return e;
+}
+
+void DecodeCache::flush() {
+  for (Entry& e : entries_) e.valid = false;
+}
@@ -238,6 +238,16 @@ Instruction::Instruction(uint32_t raw_instr) : raw(raw_instr) { // initializer l
       r.rs2 = rs2;
       break;
     }
+    case 0x2b: { // CUSTOM-1: packed SIMD, funct3 = lane width (0: 4x8b, 1: 2x16b), funct7 = op
+      if ((funct3 == 0x0 || funct3 == 0x1) && funct7 <= 0x0a) {
+        type     = Type::R;
+        category = Category::SIMD;
+        r.rd  = rd;
+        r.rs1 = rs1;
+        r.rs2 = rs2;
+      }
+      break;
+    }
     default:
       break;
   }
@@ -0,0 +1,178 @@
+// **********************************************************************
+// smile/src/JitX64.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+
+#include "JitX64.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__))
+#define SMILE_JIT_X64 1
+#include <sys/mman.h>
+#else
+#define SMILE_JIT_X64 0
+#endif
+
+bool JitX64::supported() { return SMILE_JIT_X64 != 0; }
+
+JitX64::~JitX64() {
+#if SMILE_JIT_X64
+  if (buf_) munmap(buf_, cap_);
+#endif
+}
+
+bool JitX64::reserve(size_t bytes) {
+#if SMILE_JIT_X64
+  if (buf_) return true;
+  void* p = mmap(nullptr, bytes, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return false;
+  buf_  = static_cast<uint8_t*>(p);
+  cap_  = bytes;
+  used_ = 0;
+  return true;
+#else
+  (void)bytes;
+  return false;
+#endif
+}
+
+void JitX64::clear() { used_ = 0; }
+
+void* JitX64::finish() {
+#if SMILE_JIT_X64
+  const size_t n = (code_.size() + 15u) & ~size_t{15}; // keep entries 16-byte aligned
+  if (!buf_ || used_ + n > cap_) return nullptr;
+  uint8_t* at = buf_ + used_;
+  if (mprotect(buf_, cap_, PROT_READ | PROT_WRITE) != 0) return nullptr;
+  std::memcpy(at, code_.data(), code_.size());
+  std::memset(at + code_.size(), 0xcc, n - code_.size()); // int3 padding
+  if (mprotect(buf_, cap_, PROT_READ | PROT_EXEC) != 0) return nullptr;
+  used_ += n;
+  return at;
+#else
+  return nullptr;
+#endif
+}
+
+void JitX64::patch_rel32(size_t at, size_t target) {
+  const int32_t rel = static_cast<int32_t>(static_cast<int64_t>(target) - static_cast<int64_t>(at + 4u));
+  std::memcpy(&code_[at], &rel, sizeof(rel));
+}
+
+void JitX64::u32(uint32_t v) {
+  for (int i = 0; i < 4; ++i) byte(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void JitX64::rex(bool w, Reg reg, Reg index, Reg base) {
+  const uint8_t r = static_cast<uint8_t>(0x40 | (w ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((index & 8) ? 2 : 0) | ((base & 8) ? 1 : 0));
+  if (r != 0x40) byte(r);
+}
+
+void JitX64::modrm_disp(Reg reg, Reg base, int32_t disp) {
+  byte(static_cast<uint8_t>(0x80 | ((reg & 7) << 3) | (base & 7))); // mod=10: disp32
+  if ((base & 7) == RSP) byte(0x24);                                  // SIB: base only
+  u32(static_cast<uint32_t>(disp));
+}
+
+void JitX64::mov_r32_m(Reg dst, Reg base, int32_t disp) {
+  rex(false, dst, RAX, base); byte(0x8b); modrm_disp(dst, base, disp);
+}
+
+void JitX64::mov_m_r32(Reg base, int32_t disp, Reg src) {
+  rex(false, src, RAX, base); byte(0x89); modrm_disp(src, base, disp);
+}
+
+void JitX64::mov_m_imm32(Reg base, int32_t disp, uint32_t imm) {
+  rex(false, RAX, RAX, base); byte(0xc7); modrm_disp(RAX, base, disp); u32(imm);
+}
+
+void JitX64::alu_r32_m(Alu op, Reg dst, Reg base, int32_t disp) {
+  rex(false, dst, RAX, base); byte(static_cast<uint8_t>((op << 3) | 0x03)); modrm_disp(dst, base, disp);
+}
+
+void JitX64::alu_r32_imm(Alu op, Reg dst, int32_t imm) {
+  rex(false, RAX, RAX, dst); byte(0x81); byte(static_cast<uint8_t>(0xc0 | (op << 3) | (dst & 7))); u32(static_cast<uint32_t>(imm));
+}
+
+void JitX64::imul_r32_m(Reg dst, Reg base, int32_t disp) {
+  rex(false, dst, RAX, base); byte(0x0f); byte(0xaf); modrm_disp(dst, base, disp);
+}
+
+void JitX64::mov_r32_r32(Reg dst, Reg src) {
+  rex(false, src, RAX, dst); byte(0x89); byte(static_cast<uint8_t>(0xc0 | ((src & 7) << 3) | (dst & 7)));
+}
+
+void JitX64::mov_r32_imm(Reg dst, uint32_t imm) {
+  rex(false, RAX, RAX, dst); byte(static_cast<uint8_t>(0xb8 | (dst & 7))); u32(imm);
+}
+
+void JitX64::shift_r32_cl(Shift op, Reg dst) {
+  rex(false, RAX, RAX, dst); byte(0xd3); byte(static_cast<uint8_t>(0xc0 | (op << 3) | (dst & 7)));
+}
+
+void JitX64::shift_r32_imm(Shift op, Reg dst, uint8_t n) {
+  rex(false, RAX, RAX, dst); byte(0xc1); byte(static_cast<uint8_t>(0xc0 | (op << 3) | (dst & 7))); byte(n);
+}
+
+void JitX64::setcc_zx(Cond cc, Reg dst) {
+  byte(0x0f); byte(static_cast<uint8_t>(0x90 | cc)); byte(static_cast<uint8_t>(0xc0 | (dst & 7)));  // setcc dst8
+  byte(0x0f); byte(0xb6); byte(static_cast<uint8_t>(0xc0 | ((dst & 7) << 3) | (dst & 7)));        // movzx dst32, dst8
+}
+
+void JitX64::test_r32_imm(Reg r, uint32_t imm) {
+  rex(false, RAX, RAX, r); byte(0xf7); byte(static_cast<uint8_t>(0xc0 | (r & 7))); u32(imm);
+}
+
+void JitX64::movsxd_r64_m(Reg dst, Reg base, int32_t disp) {
+  rex(true, dst, RAX, base); byte(0x63); modrm_disp(dst, base, disp);
+}
+
+void JitX64::imul_r64_r64(Reg dst, Reg src) {
+  rex(true, dst, RAX, src); byte(0x0f); byte(0xaf); byte(static_cast<uint8_t>(0xc0 | ((dst & 7) << 3) | (src & 7)));
+}
+
+void JitX64::shift_r64_imm(Shift op, Reg dst, uint8_t n) {
+  rex(true, RAX, RAX, dst); byte(0xc1); byte(static_cast<uint8_t>(0xc0 | (op << 3) | (dst & 7))); byte(n);
+}
+
+void JitX64::mov_r64_m(Reg dst, Reg base, int32_t disp) {
+  rex(true, dst, RAX, base); byte(0x8b); modrm_disp(dst, base, disp);
+}
+
+void JitX64::mov_r64_r64(Reg dst, Reg src) {
+  rex(true, src, RAX, dst); byte(0x89); byte(static_cast<uint8_t>(0xc0 | ((src & 7) << 3) | (dst & 7)));
+}
+
+void JitX64::mov_r64_imm(Reg dst, uint64_t imm) {
+  rex(true, RAX, RAX, dst); byte(static_cast<uint8_t>(0xb8 | (dst & 7)));
+  u32(static_cast<uint32_t>(imm)); u32(static_cast<uint32_t>(imm >> 32));
+}
+
+void JitX64::load_idx(Ext ext, Reg dst, Reg base, Reg index) {
+  rex(false, dst, index, base); byte(0x0f); byte(ext);
+  byte(static_cast<uint8_t>(0x04 | ((dst & 7) << 3)));                      // mod=00, SIB follows
+  byte(static_cast<uint8_t>(((index & 7) << 3) | (base & 7)));              // scale 1 (base must not be rbp/r13)
+}
+
+void JitX64::load32_idx(Reg dst, Reg base, Reg index) {
+  rex(false, dst, index, base); byte(0x8b);
+  byte(static_cast<uint8_t>(0x04 | ((dst & 7) << 3)));
+  byte(static_cast<uint8_t>(((index & 7) << 3) | (base & 7)));
+}
+
+size_t JitX64::jcc(Cond cc) {
+  byte(0x0f); byte(static_cast<uint8_t>(0x80 | cc));
+  const size_t at = pos(); u32(0);
+  return at;
+}
+
+size_t JitX64::jmp() {
+  byte(0xe9);
+  const size_t at = pos(); u32(0);
+  return at;
+}
+
+void JitX64::call_r64(Reg r) { rex(false, RAX, RAX, r); byte(0xff); byte(static_cast<uint8_t>(0xd0 | (r & 7))); }
+void JitX64::push(Reg r)     { rex(false, RAX, RAX, r); byte(static_cast<uint8_t>(0x50 | (r & 7))); }
+void JitX64::pop(Reg r)      { rex(false, RAX, RAX, r); byte(static_cast<uint8_t>(0x58 | (r & 7))); }
+void JitX64::ret()           { byte(0xc3); }
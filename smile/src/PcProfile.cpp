@@ -0,0 +1,50 @@
+// **********************************************************************
+// smile/src/PcProfile.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Out-of-line parts of the per-PC profile: window setup and call-stack tracking.
+*/
+#include "PcProfile.hpp"
+
+void PcProfile::configure(uint32_t base, uint32_t bytes) {
+  base_  = base & ~0x3u;
+  slots_ = (bytes + 3u) >> 2;
+  insts_.assign(slots_ + 1u, 0);               // +1: overflow slot
+  for (auto& s : stalls_) s.assign(slots_ + 1u, 0);
+  back_count_.assign(slots_ + 1u, 0);
+  back_target_.assign(slots_ + 1u, 0);
+  stack_nodes_.assign(1, StackNode{0, 0});
+  stack_cycles_.assign(1, 0);
+  stack_index_.clear();
+  stack_  = 0;
+  folded_calls_ = 0;
+  rooted_ = false;
+}
+
+void PcProfile::jump(uint32_t from, uint32_t to, uint32_t rd, uint32_t rs1, bool indirect) {
+  const bool link_rd  = rd == 1u || rd == 5u;   // ra / t0 (the RISC-V calling convention's link registers)
+  const bool link_rs1 = rs1 == 1u || rs1 == 5u;
+  if (link_rd) {                                // call (a co-routine swap pops and pushes; treat it as a call)
+    const uint64_t key = (static_cast<uint64_t>(stack_) << 32) | to;
+    auto it = stack_index_.find(key);
+    if (it != stack_index_.end()) {
+      stack_ = it->second;
+    } else if (stack_nodes_.size() < kMaxStackNodes) {
+      const uint32_t node = static_cast<uint32_t>(stack_nodes_.size());
+      stack_nodes_.push_back(StackNode{stack_, to});
+      stack_cycles_.push_back(0);
+      stack_index_.emplace(key, node);
+      stack_ = node;
+    } else {
+      folded_calls_++;                          // table full: stay in the caller until the matching return
+    }
+    return;
+  }
+  if (rd == 0u && link_rs1) {                   // return
+    if (folded_calls_ != 0) { folded_calls_--; return; }
+    stack_ = stack_nodes_[stack_].parent;
+    return;
+  }
+  if (!indirect) branch_taken(from, to);        // plain jump: backward ones close loops
+}
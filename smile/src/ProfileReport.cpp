@@ -0,0 +1,194 @@
+// **********************************************************************
+// smile/src/ProfileReport.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Function profile, hot-loop listing and collapsed-stack output for PcProfile.
+*/
+#include "ProfileReport.hpp"
+#include "Instruction.hpp"
+#include "Tile1_exec.hpp"
+#include "util/ElfSymbols.hpp"
+#include "smem/MemoryPort.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+namespace smile {
+
+namespace {
+
+struct Totals {
+  uint64_t cycles = 0, insts = 0, fetch = 0, dmem = 0, accel = 0;
+  void add(const PcProfile& p, uint32_t s) {
+    cycles += p.cycles(s);
+    insts  += p.insts(s);
+    fetch  += p.stalls(PcProfile::Fetch, s);
+    dmem   += p.stalls(PcProfile::Dmem, s);
+    accel  += p.stalls(PcProfile::Accel, s);
+  }
+};
+
+struct Loop {
+  uint32_t head = 0, tail = 0; // first/last slot (tail holds the back edge)
+  uint64_t iters = 0;
+  Totals   t;
+};
+
+double pct(uint64_t part, uint64_t whole) {
+  return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+
+const char* op_name(ExecOp op) {
+  switch (op) {
+    case ExecOp::ADD:    return "add";    case ExecOp::SUB:   return "sub";
+    case ExecOp::SLL:    return "sll";    case ExecOp::SLT:   return "slt";
+    case ExecOp::SLTU:   return "sltu";   case ExecOp::XOR:   return "xor";
+    case ExecOp::SRL:    return "srl";    case ExecOp::SRA:   return "sra";
+    case ExecOp::OR:     return "or";     case ExecOp::AND:   return "and";
+    case ExecOp::MUL:    return "mul";    case ExecOp::MULH:  return "mulh";
+    case ExecOp::MULHSU: return "mulhsu"; case ExecOp::MULHU: return "mulhu";
+    case ExecOp::DIV:    return "div";    case ExecOp::DIVU:  return "divu";
+    case ExecOp::REM:    return "rem";    case ExecOp::REMU:  return "remu";
+    case ExecOp::MULW:   return "mulw";
+    case ExecOp::ADDI:   return "addi";   case ExecOp::SLLI:  return "slli";
+    case ExecOp::SLTI:   return "slti";   case ExecOp::SLTIU: return "sltiu";
+    case ExecOp::XORI:   return "xori";   case ExecOp::SRLI:  return "srli";
+    case ExecOp::SRAI:   return "srai";   case ExecOp::ORI:   return "ori";
+    case ExecOp::ANDI:   return "andi";   case ExecOp::LUI:   return "lui";
+    case ExecOp::AUIPC:  return "auipc";
+    case ExecOp::LB:     return "lb";     case ExecOp::LH:    return "lh";
+    case ExecOp::LW:     return "lw";     case ExecOp::LBU:   return "lbu";
+    case ExecOp::LHU:    return "lhu";    case ExecOp::SB:    return "sb";
+    case ExecOp::SH:     return "sh";     case ExecOp::SW:    return "sw";
+    case ExecOp::BEQ:    return "beq";    case ExecOp::BNE:   return "bne";
+    case ExecOp::BLT:    return "blt";    case ExecOp::BGE:   return "bge";
+    case ExecOp::BLTU:   return "bltu";   case ExecOp::BGEU:  return "bgeu";
+    case ExecOp::JAL:    return "jal";    case ExecOp::JALR:  return "jalr";
+    case ExecOp::ECALL:  return "ecall";  case ExecOp::EBREAK: return "ebreak";
+    case ExecOp::URET:   return "uret";   case ExecOp::SRET:  return "sret";
+    case ExecOp::MRET:   return "mret";   case ExecOp::SYSTEM_NOP: return "system";
+    case ExecOp::FENCE:  return "fence";  case ExecOp::FENCE_I: return "fence.i";
+    case ExecOp::CSRRW:  return "csrrw";  case ExecOp::CSRRS: return "csrrs";
+    case ExecOp::CSRRC:  return "csrrc";  case ExecOp::CSRRWI: return "csrrwi";
+    case ExecOp::CSRRSI: return "csrrsi"; case ExecOp::CSRRCI: return "csrrci";
+    case ExecOp::CUSTOM0: return "custom0";
+    case ExecOp::PADD_B:  return "padd.b";  case ExecOp::PADD_H:  return "padd.h";
+    case ExecOp::PSUB_B:  return "psub.b";  case ExecOp::PSUB_H:  return "psub.h";
+    case ExecOp::PMIN_B:  return "pmin.b";  case ExecOp::PMIN_H:  return "pmin.h";
+    case ExecOp::PMAX_B:  return "pmax.b";  case ExecOp::PMAX_H:  return "pmax.h";
+    case ExecOp::PMINU_B: return "pminu.b"; case ExecOp::PMINU_H: return "pminu.h";
+    case ExecOp::PMAXU_B: return "pmaxu.b"; case ExecOp::PMAXU_H: return "pmaxu.h";
+    case ExecOp::PCMPEQ_B:  return "pcmpeq.b";  case ExecOp::PCMPEQ_H:  return "pcmpeq.h";
+    case ExecOp::PCMPLT_B:  return "pcmplt.b";  case ExecOp::PCMPLT_H:  return "pcmplt.h";
+    case ExecOp::PCMPLTU_B: return "pcmpltu.b"; case ExecOp::PCMPLTU_H: return "pcmpltu.h";
+    case ExecOp::PSADD_B:   return "psadd.b";   case ExecOp::PSADD_H:   return "psadd.h";
+    case ExecOp::PSADDU_B:  return "psaddu.b";  case ExecOp::PSADDU_H:  return "psaddu.h";
+    default:             return "?";
+  }
+}
+
+std::string symbol_name(const std::vector<ElfSymbol>& syms, uint32_t pc) {
+  if (const ElfSymbol* s = find_elf_symbol(syms, pc)) return s->name;
+  char buf[16];
+  snprintf(buf, sizeof(buf), "0x%08x", pc);
+  return buf;
+}
+
+} // namespace
+
+void print_profile(const PcProfile& prof, const std::vector<ElfSymbol>& syms, smem::MemoryPort& mem, int top_loops) {
+  // Flat function profile
+  Totals all;
+  std::map<const ElfSymbol*, Totals> by_func; // nullptr => no symbol
+  for (uint32_t s = 0; s < prof.slots(); ++s) {
+    if (prof.cycles(s) == 0) continue;
+    by_func[find_elf_symbol(syms, prof.pc_of(s))].add(prof, s);
+    all.add(prof, s);
+  }
+  Totals outside;
+  outside.add(prof, prof.overflow_slot());
+  printf("[PROF] cycles=%llu insts=%llu fetch_stall=%llu dmem_stall=%llu accel_stall=%llu outside_window=%llu\n",
+         (unsigned long long)(all.cycles + outside.cycles),
+         (unsigned long long)(all.insts + outside.insts),
+         (unsigned long long)(all.fetch + outside.fetch),
+         (unsigned long long)(all.dmem + outside.dmem),
+         (unsigned long long)(all.accel + outside.accel),
+         (unsigned long long)outside.cycles);
+  const uint64_t total = all.cycles + outside.cycles;
+  std::vector<std::pair<const ElfSymbol*, Totals>> funcs(by_func.begin(), by_func.end());
+  std::sort(funcs.begin(), funcs.end(), [](const auto& a, const auto& b) { return a.second.cycles > b.second.cycles; });
+  printf("[PROF] %-24s %12s %7s %12s %12s %12s %12s\n", "function", "cycles", "%", "insts", "fetch", "dmem", "accel");
+  for (const auto& f : funcs) {
+    printf("[PROF] %-24s %12llu %6.2f%% %12llu %12llu %12llu %12llu\n",
+           f.first ? f.first->name.c_str() : "?",
+           (unsigned long long)f.second.cycles, pct(f.second.cycles, total),
+           (unsigned long long)f.second.insts,
+           (unsigned long long)f.second.fetch,
+           (unsigned long long)f.second.dmem,
+           (unsigned long long)f.second.accel);
+  }
+
+  // Hot loops: every taken backward edge closes [target, source]
+  std::vector<Loop> loops;
+  for (uint32_t s = 0; s < prof.slots(); ++s) {
+    if (prof.back_count(s) == 0) continue;
+    const uint32_t target = prof.back_target(s);
+    if (target < prof.base()) continue;
+    Loop l;
+    l.head  = (target - prof.base()) >> 2;
+    l.tail  = s;
+    l.iters = prof.back_count(s);
+    for (uint32_t k = l.head; k <= l.tail; ++k) l.t.add(prof, k);
+    loops.push_back(l);
+  }
+  std::sort(loops.begin(), loops.end(), [](const Loop& a, const Loop& b) { return a.t.cycles > b.t.cycles; });
+  if (static_cast<int>(loops.size()) > top_loops) loops.resize(static_cast<size_t>(std::max(top_loops, 0)));
+  int n = 0;
+  for (const Loop& l : loops) {
+    const uint32_t head_pc = prof.pc_of(l.head);
+    printf("[PROF] loop %d: 0x%08x..0x%08x in %s cycles=%llu (%.2f%%) iters=%llu cycles/iter=%.2f\n",
+           ++n, head_pc, prof.pc_of(l.tail), symbol_name(syms, head_pc).c_str(),
+           (unsigned long long)l.t.cycles, pct(l.t.cycles, total),
+           (unsigned long long)l.iters,
+           static_cast<double>(l.t.cycles) / static_cast<double>(l.iters));
+    printf("[PROF]   %-10s %-8s %-8s %10s %10s %10s %10s\n", "pc", "word", "op", "insts", "fetch", "dmem", "accel");
+    for (uint32_t k = l.head; k <= l.tail; ++k) {
+      const uint32_t pc  = prof.pc_of(k);
+      const uint32_t raw = mem.read32(pc);
+      printf("[PROF]   0x%08x %08x %-8s %10llu %10llu %10llu %10llu%s\n",
+             pc, raw, op_name(resolve_exec_op(Instruction(raw))),
+             (unsigned long long)prof.insts(k),
+             (unsigned long long)prof.stalls(PcProfile::Fetch, k),
+             (unsigned long long)prof.stalls(PcProfile::Dmem, k),
+             (unsigned long long)prof.stalls(PcProfile::Accel, k),
+             k == l.tail ? "  <- back edge" : "");
+    }
+  }
+}
+
+bool write_folded_stacks(const std::string& path, const PcProfile& prof, const std::vector<ElfSymbol>& syms,
+                         std::string* err) {
+  std::ofstream f(path, std::ios::trunc);
+  if (!f) {
+    if (err) *err = "cannot open " + path + " for writing";
+    return false;
+  }
+  const auto& nodes  = prof.stack_nodes();
+  const auto& cycles = prof.stack_cycles();
+  std::vector<std::string> names(nodes.size()); // full "a;b;c" path per node; parents always precede children
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const std::string self = symbol_name(syms, nodes[i].entry_pc);
+    names[i] = i == 0 ? self : names[nodes[i].parent] + ";" + self;
+    if (cycles[i] != 0) f << names[i] << ' ' << cycles[i] << '\n';
+  }
+  if (!f) {
+    if (err) *err = "write to " + path + " failed";
+    return false;
+  }
+  return true;
+}
+
+} // namespace smile
@@ -0,0 +1,100 @@
+// **********************************************************************
+// smile/src/Sampler.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Sampled simulation driver: alternates ideal-model fast-forward with timed
+warm-up + measurement windows and extrapolates total cycles from window CPI.
+*/
+#include "Sampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace smile {
+
+// Run until the tile has retired `target` instructions.  Never overshoots: auto_run gets
+// at most `gap` cycles, and every retired instruction is charged at least one of them.  A
+// batched tick (-block_exec, -jit) is capped by the tick budget auto_run sets from the
+// cycles left, and the JIT only runs a block whose whole body fits under it.  Returns false
+// if the program exited, the cycle budget ran out or the threads stopped making progress.
+static bool run_to_inst(DebuggerState& state, uint64_t target, int max_cycles) {
+  while (state.tile.inst_count() < target) {
+    if (state.program_exited || state.cycle >= max_cycles) return false;
+    const int before = state.cycle;
+    const uint64_t gap = target - state.tile.inst_count();
+    auto_run(state, static_cast<int>(std::min<uint64_t>(gap, static_cast<uint64_t>(max_cycles - state.cycle))));
+    if (state.cycle == before) return false; // no active threads left
+  }
+  return !state.program_exited;
+}
+
+SampleReport run_sampled(DebuggerState& state, int max_cycles, const SampleConfig& cfg) {
+  assert_always(cfg.window > 0, "sampling window must be at least one instruction");
+  assert_always(cfg.period >= cfg.warmup + cfg.window, "sampling period must cover warm-up + window");
+  const uint64_t ffwd = cfg.period - cfg.warmup - cfg.window;
+  Tile1& tile = state.tile;
+
+  SampleReport rep;
+  double mean = 0.0, m2 = 0.0; // Welford running mean/variance of window CPI
+  for (;;) {
+    // 1. fast-forward (functional only)
+    tile.set_mem_model(Tile1::MemModel::Ideal);
+    uint64_t mark = tile.inst_count();
+    const bool ff_ok = run_to_inst(state, mark + ffwd, max_cycles);
+    rep.ffwd_insts += tile.inst_count() - mark;
+    tile.set_mem_model(Tile1::MemModel::Timed); // in-flight requests (if any) finish on either model
+    if (!ff_ok) break;
+
+    // 2. warm-up (timed, unmeasured)
+    mark = tile.inst_count();
+    const bool wu_ok = run_to_inst(state, mark + cfg.warmup, max_cycles);
+    rep.timed_insts += tile.inst_count() - mark;
+    if (!wu_ok) break;
+
+    // 3. measured window
+    mark = tile.inst_count();
+    const int cycle0 = state.cycle;
+    const bool win_ok = run_to_inst(state, mark + cfg.window, max_cycles);
+    const uint64_t insts = tile.inst_count() - mark;
+    rep.timed_insts += insts;
+    if (!win_ok || insts != cfg.window) break; // partial windows are not samples
+    const double cpi = static_cast<double>(state.cycle - cycle0) / static_cast<double>(insts);
+    rep.windows++;
+    const double delta = cpi - mean;
+    mean += delta / static_cast<double>(rep.windows);
+    m2   += delta * (cpi - mean);
+  }
+
+  rep.total_insts = tile.inst_count();
+  rep.cpi_mean    = mean;
+  if (rep.windows >= 2) {
+    const double stddev = std::sqrt(m2 / static_cast<double>(rep.windows - 1));
+    rep.cpi_ci95 = 1.96 * stddev / std::sqrt(static_cast<double>(rep.windows));
+  }
+  rep.est_cycles = rep.cpi_mean * static_cast<double>(rep.total_insts);
+  rep.est_ci95   = rep.cpi_ci95 * static_cast<double>(rep.total_insts);
+  return rep;
+}
+
+void print_sample_report(const SampleConfig& cfg, const SampleReport& rep) {
+  printf("[SAMPLE] period=%llu warmup=%llu window=%llu windows=%llu ffwd_insts=%llu timed_insts=%llu\n",
+         (unsigned long long)cfg.period,
+         (unsigned long long)cfg.warmup,
+         (unsigned long long)cfg.window,
+         (unsigned long long)rep.windows,
+         (unsigned long long)rep.ffwd_insts,
+         (unsigned long long)rep.timed_insts);
+  if (rep.windows == 0) {
+    printf("[SAMPLE] no complete windows (program shorter than -sample_period?)\n");
+    return;
+  }
+  printf("[SAMPLE] cpi=%.4f +/- %.4f (95%%) est_cycles=%.0f +/- %.0f over inst=%llu%s\n",
+         rep.cpi_mean, rep.cpi_ci95,
+         rep.est_cycles, rep.est_ci95,
+         (unsigned long long)rep.total_insts,
+         rep.windows < 2 ? " (need >=2 windows for an interval)" : "");
+}
+
+} // namespace smile
@@ -8,6 +8,8 @@ How the tile processes instructions and talks to memory.
 #include "Tile1.hpp"
 #include "Tile1_exec.hpp"
 #include "AccelPort.hpp"
+#include "CpiSeries.hpp"
+#include <algorithm>
 #include <cstdint>
 
 Tile1::Tile1(std::string /*name*/, IMPL_CTOR) {
@@ -18,43 +20,112 @@ Tile1::Tile1(std::string /*name*/, IMPL_CTOR) {
 // Connects external memory to tile
 void Tile1::attach_memory(smem::MemoryPort* mem) {
   mem_port_ = mem; // tile stores pointer (mem_port_) to memory port to fetch instr and read/write data
+  mem_direct_.attach(mem);
+  port_byte_writes_ = mem && mem->supports_byte_writes();
 }                  // will allow us to access a memory port class's methods for mem read/write
 
+void Tile1::attach_accelerator(AccelPort* accel) {
+  assert_always(accel_inflight_ == 0 && !accel_wait_, "accelerator swapped with commands in flight");
+  accel_port_   = accel;
+  accel_queued_ = accel && accel->supports_queue();
+  assert_always(!accel_queued_ || hw_threads_ == 1, "a decoupled accelerator does not combine with hardware threads");
+  check_issue_  = nb_load_slots_ != 0 || hw_threads_ > 1 || accel_queued_;
+}
+
 // Tile's execution sequence, fetch/decode/etc.
 void Tile1::tick() {
 
   // ******************
   // 0. Some checks
   // ******************
+  last_tick_cycles_ = 1;
+  if (hw_threads_ > 1) { // several harts: pick one, run it (Tile1.cpp, tick_harts)
+    tick_harts();
+    return;
+  }
   if (halted_) return; // stop sim if ECALL previously halted the tile
   if (!mem_port_) {    // prevent sim from running w/o memory port
     last_pc_ = pc_;
     last_instr_ = 0;
     return;
   }
+  cycle_count_++; // block ticks add the rest once they know how many cycles they covered
 
   mem_port_->cycle(); // advance mem model by CPU cycle (to simulate latency)
   if (accel_port_) {
     accel_port_->tick(); // accelerator tick each cycle
   }
+  const uint64_t insts = inst_count_;
+  cpi_stall_ = CpiSlot::Other;
+  run_hart();
+  account_cycles(insts);
+}
+
+// Retired instructions fill Base one cycle each; whatever is left of the tick's cycles
+// (a stall, or the terminator of a block that did not retire) goes to cpi_stall_.
+void Tile1::account_cycles(uint64_t insts_before) {
+  const uint64_t cycles  = last_tick_cycles_;
+  const uint64_t retired = std::min<uint64_t>(inst_count_ - insts_before, cycles);
+  cpi_cycles_[static_cast<size_t>(CpiSlot::Base)] += retired;
+  cpi_cycles_[static_cast<size_t>(cpi_stall_)]    += cycles - retired;
+  if (cpi_series_ && cycle_count_ >= cpi_series_->next_cycle()) cpi_series_->sample(*this);
+}
+
+const char* Tile1::cpi_slot_name(CpiSlot s) {
+  switch (s) {
+    case CpiSlot::Base:     return "base";
+    case CpiSlot::Fetch:    return "fetch";
+    case CpiSlot::Branch:   return "branch";
+    case CpiSlot::Load:     return "load";
+    case CpiSlot::Store:    return "store";
+    case CpiSlot::StoreRmw: return "store_rmw";
+    case CpiSlot::LoadUse:  return "load_use";
+    case CpiSlot::PortBusy: return "port_busy";
+    case CpiSlot::Accel:    return "accel";
+    default:                return "other";
+  }
+}
+
+// One cycle of the running hart, after the memory model and accelerator have ticked
+void Tile1::run_hart() {
+  if (accel_inflight_ != 0) drain_accel_responses(); // results that came back write rd and leave the scoreboard
+  if (nb_inflight_ != 0) {
+    nb_busy_cycles_++;
+    nb_inflight_sum_ += nb_inflight_;
+    drain_nb_loads();                                // loads that landed write rd and leave the scoreboard
+    if (nb_inflight_ != 0 && mem_model_ == MemModel::Ideal) { // switched to ideal under in-flight loads: let them land
+      dmem_stall_cycles_++;
+      cpi_stall_ = CpiSlot::Load;
+      return;
+    }
+  }
+  if (fline_wait_ && mem_port_->resp_valid()) absorb_fetch_line(); // fetch line (demand or prefetch) landed
 
   // If we're waiting on an instr fetch response, stall until it arrives
   if (ifetch_wait_) {
-    if (!mem_port_->resp_valid()) return;   // stall until mem has valid instr resp
-    ifetch_word_  = mem_port_->resp_data(); // if it has valid resp: copy resp into ifetch buffer
-    mem_port_->resp_consume();              // tell mem we've consumed response (it can now accept new requests)
+    if (!take_response(&ifetch_word_)) {    // stall until mem has valid instr resp (copied into ifetch buffer and consumed)
+      fetch_stall_cycles_++;
+      cpi_stall_ = CpiSlot::Fetch;
+      if (profile_) profile_->stall(PcProfile::Fetch, pc_);
+      return;
+    }
     ifetch_valid_ = true;                   // mark the ifetch buffer valid
     ifetch_wait_  = false;                  // clear the fetch-wait flag
   }
   // If we're waiting on a data memory access, stall until it completes
   if (dmem_wait_) {
-    if (!mem_port_->resp_valid()) return;  // stall until mem has valid data resp
-    const uint32_t resp = mem_port_->resp_data();
-    mem_port_->resp_consume();
+    dmem_stall_cycles_++;                  // every cycle in here (incl. completion) runs no new instr
+    cpi_stall_ = dmem_slot();
+    if (profile_) profile_->stall(PcProfile::Dmem, last_pc_);
+    uint32_t resp = 0;
+    if (!take_response(&resp)) return;     // stall until mem has valid data resp
     complete_dmem(resp);                   // finishes load/store op and advances PC
     return;
   }
   if (accel_wait_) { // If we're waiting on an accelerator response, stall until it arrives
+    accel_stall_cycles_++;
+    cpi_stall_ = CpiSlot::Accel;
+    if (profile_) profile_->stall(PcProfile::Accel, last_pc_);
     if (!accel_port_) { // defensive missing accelerator check
       if (accel_rd_ != 0) {
         write_reg(accel_rd_, AccelPort::ACCEL_E_UNSUPPORTED);
@@ -79,28 +150,82 @@ void Tile1::tick() {
     return;
   }
 
+  if (bpred_bubble_ != 0) { // a mispredicted branch/jump retired: the front end refetches down the right path
+    bpred_bubble_--;
+    bpred_penalty_cycles_++;
+    fetch_stall_cycles_++;
+    cpi_stall_ = CpiSlot::Branch;
+    if (profile_) profile_->stall(PcProfile::Fetch, pc_);
+    return;
+  }
+
   // ******************
   // 1. FETCH
   // ******************
+  if (mem_model_ == MemModel::Ideal && block_exec_ && tick_budget_ > 1 && hw_threads_ == 1 && accel_inflight_ == 0) {
+    // Block engine: retire the straight-line body at pc_ now, then fall through for its terminator.
+    bool at_terminator = false;
+    const uint32_t retired = run_block_body(tick_budget_ - 1u, &at_terminator);
+    if (!at_terminator) {          // budget exhausted or body patched itself; resume next tick
+      last_tick_cycles_ = retired;
+      cycle_count_ += static_cast<uint64_t>(retired) - 1u; // wraps back by one if nothing retired, which is exact
+      return;
+    }
+    if (retired != 0) {            // the terminator gets its own cycle, as it would unbatched
+      mem_port_->cycle();
+      if (accel_port_) accel_port_->tick();
+    }
+    last_tick_cycles_ = retired + 1u;
+    cycle_count_ += retired;
+  }
   const uint32_t curr_pc = pc_;
   uint32_t instr = 0;
+  const DecodeCache::Entry* entry = nullptr;
   if (mem_model_ == MemModel::Ideal) { // ideal mem…
     // Ideal mem is a functional sanity mode: synchronous read32/write32, no stalls.
     ifetch_wait_ = false;
     ifetch_valid_ = false;
-    instr = mem_port_->read32(curr_pc);
+    entry = decode_cache_.lookup(curr_pc); // predecoded hit skips the fetch read entirely
+    if (!entry) entry = &decode_cache_.fill(curr_pc, mem_direct_.read32(curr_pc));
+    if (check_issue_ && issue_hazard(*entry, curr_pc)) return;
+    instr = entry->raw;
+  } else if (fetch_line_bytes_ != 0) { // …or timed mem through the fetch line buffer
+    if (!fetch_from_line(curr_pc, &instr)) {
+      last_pc_ = curr_pc;
+      last_instr_ = 0;
+      return;
+    }
+    entry = &decode_cache_.lookup_or_fill(curr_pc, instr);
+    const bool mem_op = (entry->op >= ExecOp::LB && entry->op <= ExecOp::SW) ||
+                        entry->op == ExecOp::CUSTOM0;                         // accelerators share the port untagged
+    const bool nb_load = nb_load_slots_ != 0 && entry->op >= ExecOp::LB && entry->op <= ExecOp::LHU; // tagged: may queue behind the line
+    if (mem_op && fline_wait_ && !nb_load) { // port busy with a prefetch: hold the access until the line lands
+      dmem_stall_cycles_++;
+      cpi_stall_ = CpiSlot::PortBusy;
+      if (profile_) profile_->stall(PcProfile::Dmem, curr_pc);
+      last_pc_ = curr_pc;
+      return;
+    }
+    if (check_issue_ && issue_hazard(*entry, curr_pc)) return;
+    fetch_line_hits_++;
+    if (!mem_op) prefetch_next_line(); // keep the port free for the access otherwise
   } else {                             // …or timed mem (default), sims realistic mem latency with req/resp and stalling
     // Timed mem is the cycle-accurate mode using request/resp.
     // If no buffered instruction is available, request one from memory.
     if (!ifetch_valid_) {
+      fetch_stall_cycles_++;                 // issue cycle (or blocked issue) retires nothing
+      cpi_stall_ = CpiSlot::Fetch;
+      if (profile_) profile_->stall(PcProfile::Fetch, curr_pc);
       if (!mem_port_->can_request()) return; // check can_request() before requesting to avoid overwriting pending requests
-      mem_port_->request_read32(curr_pc);
+      mem_port_->request_read32_tagged(curr_pc, hart_tag_);
       ifetch_wait_ = true;
       last_pc_ = curr_pc;
       last_instr_ = 0;
       return;                                // return right after request issue, so core consumes resp in next cycle
     }
     instr = ifetch_word_;
+    entry = &decode_cache_.lookup_or_fill(curr_pc, instr); // fetch timing unchanged, decode reused
+    if (check_issue_ && issue_hazard(*entry, curr_pc)) return; // fetched word stays buffered
     ifetch_valid_ = false;
   }
   last_pc_    = curr_pc;
@@ -111,388 +236,209 @@ void Tile1::tick() {
 
   // ******************
   // 2. DECODE
-  // ******************  
-  Instruction decoded(instr); // construct a new Instruction object called decoded by passing in instr
+  // ******************
+  const Instruction& decoded = entry->instr; // predecoded on first visit to this pc (see DecodeCache)
 
   // ******************
   // 3. EXECUTE
   // ******************
   inst_count_++;
-  switch (decoded.category) { // determine what kind of instruction you're dealing with
-    // ALU
-    case Instruction::Category::ALU:
-      arith_count_++; // increment arithmetic (ALU category) count
-      if (decoded.type == Instruction::Type::I) {
-        if (decoded.opcode == 0x13) {
-          if (decoded.funct3 == 0x1) {
-            exec_slli(*this, decoded);
-          } else if (decoded.funct3 == 0x2) {
-            exec_slti(*this, decoded);
-          } else if (decoded.funct3 == 0x3) {
-            exec_sltiu(*this, decoded);
-          } else if (decoded.funct3 == 0x4) {
-            exec_xori(*this, decoded);
-          } else if (decoded.funct3 == 0x6) {
-            exec_ori(*this, decoded);
-          } else if (decoded.funct3 == 0x7) {
-            exec_andi(*this, decoded);
-          } else if (decoded.funct3 == 0x5) {
-            if (decoded.funct7 == 0x00) {
-              exec_srli(*this, decoded);
-            } else if (decoded.funct7 == 0x20) {
-              exec_srai(*this, decoded);
-            } else {
-              exec_addi(*this, decoded);
-            }
-          } else {
-            exec_addi(*this, decoded);
-          }
-        } else {
-          exec_addi(*this, decoded);
-        }
-      } else if (decoded.type == Instruction::Type::R) {
-        if (decoded.opcode == 0x33) {
-          switch (decoded.funct3) {
-            case 0x0:
-              if (decoded.funct7 == 0x00) {
-                add_count_++;
-                exec_add(*this, decoded);
-              } else if (decoded.funct7 == 0x20) {
-                add_count_++; // count subs as adds
-                exec_sub(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                mul_count_++;
-                exec_mul(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            case 0x1:
-              if (decoded.funct7 == 0x00) {
-                exec_sll(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                exec_mulh(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            case 0x2:
-              if (decoded.funct7 == 0x00) {
-                exec_slt(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                exec_mulhsu(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            case 0x3:
-              if (decoded.funct7 == 0x00) {
-                exec_sltu(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                exec_mulhu(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            case 0x4:
-              if (decoded.funct7 == 0x00) {
-                exec_xor(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                exec_div(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            case 0x5:
-              if (decoded.funct7 == 0x00) {
-                exec_srl(*this, decoded);
-              } else if (decoded.funct7 == 0x20) {
-                exec_sra(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                exec_divu(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            case 0x6:
-              if (decoded.funct7 == 0x00) {
-                exec_or(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                exec_rem(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            case 0x7:
-              if (decoded.funct7 == 0x00) {
-                exec_and(*this, decoded);
-              } else if (decoded.funct7 == 0x01) {
-                exec_remu(*this, decoded);
-              } else {
-                exec_add(*this, decoded);
-              }
-              break;
-            default:
-              exec_add(*this, decoded);
-              break;
-          }
-        } else if (decoded.opcode == 0x3b) {
-          if (decoded.funct3 == 0x0 && decoded.funct7 == 0x01) {
-            exec_mulw(*this, decoded);
-          } else {
-            exec_add(*this, decoded);
-          }
-        } else {
-          exec_add(*this, decoded);
-        }
-      } else if (decoded.type == Instruction::Type::U) {
-        if (decoded.opcode == 0x37) {
-          exec_lui(*this, decoded);
-        } else if (decoded.opcode == 0x17) {
-          exec_auipc(*this, decoded, curr_pc);
-        }
-      }
-      break;
+  if (profile_) profile_->retire(curr_pc);
+  if (trace_out_) trace_retire(curr_pc, entry->op, decoded);
+  if (const ExecHandler fn = kExecTable[static_cast<size_t>(entry->op)]) {
+    fn(*this, decoded, curr_pc); // ALU/M/U-type/SIMD: counters + execution in one table call (Tile1_dispatch.cpp)
+  } else switch (entry->op) {    // ops with pc, memory, trap or accelerator effects
     // SYSTEM
-    case Instruction::Category::SYSTEM:
-      if (decoded.type == Instruction::Type::I) {
-        if (decoded.opcode == 0x73) {
-          switch (decoded.i.imm) {
-            case 0x000: exec_ecall(*this, decoded); break;
-            case 0x001: exec_ebreak(*this, decoded); break;
-            case 0x002: exec_uret(*this, decoded); break;
-            case 0x102: exec_sret(*this, decoded); break;
-            case 0x302: exec_mret(*this, decoded); break;
-            default: break;
-          }
-          advance_pc = false;
-        } else if (decoded.opcode == 0x0f) {
-          if (decoded.funct3 == 0x0) {
-            exec_fence(*this, decoded);
-          } else if (decoded.funct3 == 0x1) {
-            exec_fence_i(*this, decoded);
-          }
-        }
-      }
-      break;
+    case ExecOp::ECALL:      exec_ecall(*this, decoded);  advance_pc = false; break;
+    case ExecOp::EBREAK:     exec_ebreak(*this, decoded); advance_pc = false; break;
+    case ExecOp::URET:       exec_uret(*this, decoded);   advance_pc = false; break;
+    case ExecOp::SRET:       exec_sret(*this, decoded);   advance_pc = false; break;
+    case ExecOp::MRET:       exec_mret(*this, decoded);   advance_pc = false; break;
+    case ExecOp::SYSTEM_NOP: advance_pc = false; break;
+    case ExecOp::FENCE:      exec_fence(*this, decoded);   break;
+    case ExecOp::FENCE_I:    exec_fence_i(*this, decoded); break;
     // MEMORY
-    case Instruction::Category::LOAD:
-      if (decoded.type == Instruction::Type::I) {
-        load_count_++;
-        const auto& op = decoded.i;
-        const int32_t base = static_cast<int32_t>(read_reg(op.rs1));
-        const uint32_t addr = static_cast<uint32_t>(base + op.imm);
-        // Ideal mem is a functional sanity mode: synchronous read32/write32, no stalls.
-        if (mem_model_ == MemModel::Ideal) { // if ideal mem…
-          const uint32_t word = mem_port_->read32(addr & ~0x3u);
-          uint32_t value = 0;
-          switch (decoded.funct3) {
-            case 0x0: {
-              const uint32_t shift = (addr & 0x3u) * 8u;
-              const int8_t byte = static_cast<int8_t>((word >> shift) & 0xffu);
-              value = static_cast<uint32_t>(byte);
-              break;
-            }
-            case 0x1: {
-              assert_always((addr & 0x1u) == 0u, "LH requires 2-byte alignment");
-              const uint32_t shift = (addr & 0x2u) * 8u;
-              const int16_t half = static_cast<int16_t>((word >> shift) & 0xffffu);
-              value = static_cast<uint32_t>(half);
-              break;
-            }
-            case 0x2:
-              assert_always((addr & 0x3u) == 0u, "LW requires 4-byte alignment");
-              value = word;
-              break;
-            case 0x4: {
-              const uint32_t shift = (addr & 0x3u) * 8u;
-              value = (word >> shift) & 0xffu;
-              break;
-            }
-            case 0x5: {
-              assert_always((addr & 0x1u) == 0u, "LHU requires 2-byte alignment");
-              const uint32_t shift = (addr & 0x2u) * 8u;
-              value = (word >> shift) & 0xffffu;
-              break;
-            }
-            default:
-              assert_always(false, "Unsupported load funct3 in ideal data path");
-              break;
-          }
-          if (op.rd != 0) write_reg(op.rd, value);
-        } else {                             // …or timed mem (default), sims realistic mem latency with req/resp and stalling
-          // Timed mem is the cycle-accurate mode using request/resp.
-          DmemOp dmem_op = DmemOp::None;
-          switch (decoded.funct3) {
-            case 0x0: dmem_op = DmemOp::LB; break;
-            case 0x1:
-              assert_always((addr & 0x1u) == 0u, "LH requires 2-byte alignment");
-              dmem_op = DmemOp::LH;
-              break;
-            case 0x2:
-              assert_always((addr & 0x3u) == 0u, "LW requires 4-byte alignment");
-              dmem_op = DmemOp::LW;
-              break;
-            case 0x4: dmem_op = DmemOp::LBU; break;
-            case 0x5:
-              assert_always((addr & 0x1u) == 0u, "LHU requires 2-byte alignment");
-              dmem_op = DmemOp::LHU;
-              break;
-            default:
-              assert_always(false, "Unsupported load funct3 in timed data path");
-              break;
-          }
-          if (!mem_port_->can_request()) return;   // before issue, check that we can make new request
-          mem_port_->request_read32(addr & ~0x3u); // if we can, issue load request
-          dmem_wait_ = true;                       // we're no waiting on data mem
-          dmem_op_ = dmem_op;                      // load flavour
-          dmem_rmw_write_issued_ = false;
-          dmem_rd_ = op.rd;                        // which reg to write
-          dmem_addr_ = addr;                       // bookkeeping/debug
-          dmem_store_data_ = 0;
-          dmem_store_mask_ = 0;
-          dmem_store_shift_ = 0;
-          dmem_next_pc_ = next_pc;
-          return;                                  // jump out of Tile1::tick()
+    case ExecOp::LB:
+    case ExecOp::LH:
+    case ExecOp::LW:
+    case ExecOp::LBU:
+    case ExecOp::LHU: {
+      load_count_++;
+      const auto& op = decoded.i;
+      const int32_t base = static_cast<int32_t>(read_reg(op.rs1));
+      const uint32_t addr = static_cast<uint32_t>(base + op.imm);
+      // Ideal mem is a functional sanity mode: synchronous read32/write32, no stalls.
+      if (mem_model_ == MemModel::Ideal) { // if ideal mem…
+        load_ideal(decoded);
+      } else {                             // …or timed mem (default), sims realistic mem latency with req/resp and stalling
+        // Timed mem is the cycle-accurate mode using request/resp.
+        DmemOp dmem_op = DmemOp::None;
+        switch (decoded.funct3) {
+          case 0x0: dmem_op = DmemOp::LB; break;
+          case 0x1:
+            assert_always((addr & 0x1u) == 0u, "LH requires 2-byte alignment");
+            dmem_op = DmemOp::LH;
+            break;
+          case 0x2:
+            assert_always((addr & 0x3u) == 0u, "LW requires 4-byte alignment");
+            dmem_op = DmemOp::LW;
+            break;
+          case 0x4: dmem_op = DmemOp::LBU; break;
+          case 0x5:
+            assert_always((addr & 0x1u) == 0u, "LHU requires 2-byte alignment");
+            dmem_op = DmemOp::LHU;
+            break;
+          default:
+            assert_always(false, "Unsupported load funct3 in timed data path");
+            break;
+        }
+        if (nb_load_slots_ != 0) {               // non-blocking: retire now, rd joins the scoreboard (issue_hazard freed a slot)
+          uint32_t slot = 0;
+          while (!(nb_free_ & (1u << slot))) ++slot;
+          nb_free_ &= ~(1u << slot);
+          nb_inflight_++;
+          nb_loads_issued_++;
+          nb_loads_[slot] = PendingLoad{dmem_op, op.rd, addr, cycle_count_};
+          load_sb_ |= (1u << op.rd) & ~1u;
+          mem_port_->request_read32_tagged(addr & ~0x3u, slot + 1u);
+          break;
         }
+        if (!mem_port_->can_request()) return;   // before issue, check that we can make new request
+        mem_port_->request_read32_tagged(addr & ~0x3u, hart_tag_); // if we can, issue load request
+        dmem_wait_ = true;                       // we're no waiting on data mem
+        dmem_op_ = dmem_op;                      // load flavour
+        dmem_rmw_write_issued_ = false;
+        dmem_rd_ = op.rd;                        // which reg to write
+        dmem_addr_ = addr;                       // bookkeeping/debug
+        dmem_store_data_ = 0;
+        dmem_store_mask_ = 0;
+        dmem_store_shift_ = 0;
+        dmem_next_pc_ = next_pc;
+        return;                                  // jump out of Tile1::tick()
       }
       break;
-    case Instruction::Category::STORE:
-      if (decoded.type == Instruction::Type::S) {
-        store_count_++;
-        const auto& op = decoded.s;
-        const int32_t base = static_cast<int32_t>(read_reg(op.rs1));
-        const uint32_t addr = static_cast<uint32_t>(base + op.imm);
-        const uint32_t data = read_reg(op.rs2);
-        const uint32_t aligned = addr & ~0x3u;
-        // Ideal mem is a functional sanity mode: synchronous read32/write32, no stalls.
-        if (mem_model_ == MemModel::Ideal) { // if ideal mem…
-          switch (decoded.funct3) {
-            case 0x0: {
-              const uint32_t shift = (addr & 0x3u) * 8u;
-              const uint32_t mask = 0xffu << shift;
-              const uint32_t prior = mem_port_->read32(aligned);
-              const uint32_t merged = (prior & ~mask) | ((data << shift) & mask);
-              mem_port_->write32(aligned, merged);
-              break;
-            }
-            case 0x1: {
-              assert_always((addr & 0x1u) == 0u, "SH requires 2-byte alignment");
-              const uint32_t shift = (addr & 0x2u) * 8u;
-              const uint32_t mask = 0xffffu << shift;
-              const uint32_t prior = mem_port_->read32(aligned);
-              const uint32_t merged = (prior & ~mask) | ((data << shift) & mask);
-              mem_port_->write32(aligned, merged);
-              break;
+    }
+    case ExecOp::SB:
+    case ExecOp::SH:
+    case ExecOp::SW: {
+      store_count_++;
+      const auto& op = decoded.s;
+      const int32_t base = static_cast<int32_t>(read_reg(op.rs1));
+      const uint32_t addr = static_cast<uint32_t>(base + op.imm);
+      const uint32_t data = read_reg(op.rs2);
+      const uint32_t aligned = addr & ~0x3u;
+      // Ideal mem is a functional sanity mode: synchronous read32/write32, no stalls.
+      if (mem_model_ == MemModel::Ideal) { // if ideal mem…
+        store_ideal(decoded);
+      } else {                             // …or timed mem (default), sims realistic mem latency with req/resp and stalling
+        // Timed mem is the cycle-accurate mode using request/resp.
+        note_code_store(aligned); // self-modifying code: drop any predecoded copy of this word
+        if (!mem_port_->can_request()) return;
+
+        dmem_wait_ = true;
+        dmem_rd_ = 0;
+        dmem_addr_ = addr;
+        dmem_next_pc_ = next_pc;
+        dmem_rmw_write_issued_ = false;
+
+        switch (decoded.funct3) {
+          case 0x0: {
+            dmem_op_ = DmemOp::SB;
+            dmem_store_data_ = data & 0xffu;
+            dmem_store_shift_ = (addr & 0x3u) * 8u;
+            dmem_store_mask_ = 0xffu << dmem_store_shift_;
+            if (port_byte_writes_) {                              // byte-enable port: one masked WRITE
+              dmem_rmw_write_issued_ = true;
+              mem_port_->request_write_bytes_tagged(addr, dmem_store_data_, 1u, hart_tag_);
+              return;
             }
-            case 0x2:
-              assert_always((addr & 0x3u) == 0u, "SW requires 4-byte alignment");
-              mem_port_->write32(aligned, data);
-              break;
-            default:
-              assert_always(false, "Unsupported store funct3 in ideal data path");
-              break;
+            // Word-only memory port: SB is implemented as timed read-modify-write (2 requests).
+            mem_port_->request_read32_tagged(aligned, hart_tag_); // transaction 1: READ in what you want to modify
+            return;                                               // jump out of Tile1::tick()
           }
-        } else {                             // …or timed mem (default), sims realistic mem latency with req/resp and stalling
-          // Timed mem is the cycle-accurate mode using request/resp.
-          if (!mem_port_->can_request()) return;
-
-          dmem_wait_ = true;
-          dmem_rd_ = 0;
-          dmem_addr_ = addr;
-          dmem_next_pc_ = next_pc;
-          dmem_rmw_write_issued_ = false;
-
-          switch (decoded.funct3) {
-            case 0x0: {
-              // Word-only memory port: SB is implemented as timed read-modify-write (2 requests).
-              dmem_op_ = DmemOp::SB;
-              dmem_store_data_ = data & 0xffu;
-              dmem_store_shift_ = (addr & 0x3u) * 8u;
-              dmem_store_mask_ = 0xffu << dmem_store_shift_;
-              mem_port_->request_read32(aligned); // transaction 1: READ in what you want to modify
-              return;                             // jump out of Tile1::tick()
-            }
-            case 0x1: {
-              assert_always((addr & 0x1u) == 0u, "SH requires 2-byte alignment");
-              // Word-only memory port: SH is implemented as timed read-modify-write (2 requests).
-              // Transaction 1: READ request
-              dmem_op_ = DmemOp::SH;
-              dmem_store_data_ = data & 0xffffu;
-              dmem_store_shift_ = (addr & 0x2u) * 8u;
-              dmem_store_mask_ = 0xffffu << dmem_store_shift_;
-              mem_port_->request_read32(aligned); // transaction 1: READ in what you want to modify
-              return;                             // jump out of Tile1::tick()
+          case 0x1: {
+            assert_always((addr & 0x1u) == 0u, "SH requires 2-byte alignment");
+            dmem_op_ = DmemOp::SH;
+            dmem_store_data_ = data & 0xffffu;
+            dmem_store_shift_ = (addr & 0x2u) * 8u;
+            dmem_store_mask_ = 0xffffu << dmem_store_shift_;
+            if (port_byte_writes_) {                              // byte-enable port: one masked WRITE
+              dmem_rmw_write_issued_ = true;
+              mem_port_->request_write_bytes_tagged(addr, dmem_store_data_, 2u, hart_tag_);
+              return;
             }
-            case 0x2:
-              assert_always((addr & 0x3u) == 0u, "SW requires 4-byte alignment");
-              dmem_op_ = DmemOp::SW;
-              dmem_store_data_ = data;
-              dmem_store_shift_ = 0;
-              dmem_store_mask_ = 0xffffffffu;
-              mem_port_->request_write32(aligned, data); // WRITE in what you want to modify
-              return;                                    // jump out of Tile1::tick()
-            default:
-              assert_always(false, "Unsupported store funct3 in timed data path");
-              break;
+            // Word-only memory port: SH is implemented as timed read-modify-write (2 requests).
+            mem_port_->request_read32_tagged(aligned, hart_tag_); // transaction 1: READ in what you want to modify
+            return;                                               // jump out of Tile1::tick()
           }
+          case 0x2:
+            assert_always((addr & 0x3u) == 0u, "SW requires 4-byte alignment");
+            dmem_op_ = DmemOp::SW;
+            dmem_store_data_ = data;
+            dmem_store_shift_ = 0;
+            dmem_store_mask_ = 0xffffffffu;
+            mem_port_->request_write32_tagged(aligned, data, hart_tag_); // WRITE in what you want to modify
+            return;                                                      // jump out of Tile1::tick()
+          default:
+            assert_always(false, "Unsupported store funct3 in timed data path");
+            break;
         }
       }
       break;
+    }
     // JUMP
-    case Instruction::Category::JUMP:
-      if (decoded.type == Instruction::Type::J) {
-        next_pc = exec_jal(*this, decoded, curr_pc);
-      } else if (decoded.type == Instruction::Type::I) {
-        next_pc = exec_jalr(*this, decoded, curr_pc);
-      }
+    case ExecOp::JAL:
+      next_pc = exec_jal(*this, decoded, curr_pc);
+      if (profile_) profile_->jump(curr_pc, next_pc, decoded.j.rd, 0u, false);
+      if (bpred_ && bpred_->jump(curr_pc, next_pc, decoded.j.rd, 0u, false)) bpred_bubble_ = bpred_->penalty();
       break;
-    // CSR
-    case Instruction::Category::CSR:
-      if (decoded.type == Instruction::Type::CSR) {
-        switch (decoded.funct3) {
-          case 0x1: exec_csrrw(*this, decoded); break;
-          case 0x2: exec_csrrs(*this, decoded); break;
-          case 0x3: exec_csrrc(*this, decoded); break;
-          default: break;
-        }
-      }
-      break;
-    case Instruction::Category::CSR_IMM:
-      if (decoded.type == Instruction::Type::CSR) {
-        switch (decoded.funct3) {
-          case 0x5: exec_csrrwi(*this, decoded); break;
-          case 0x6: exec_csrrsi(*this, decoded); break;
-          case 0x7: exec_csrrci(*this, decoded); break;
-          default: break;
-        }
-      }
+    case ExecOp::JALR:
+      next_pc = exec_jalr(*this, decoded, curr_pc);
+      if (profile_) profile_->jump(curr_pc, next_pc, decoded.i.rd, decoded.i.rs1, true);
+      if (bpred_ && bpred_->jump(curr_pc, next_pc, decoded.i.rd, decoded.i.rs1, true)) bpred_bubble_ = bpred_->penalty();
       break;
+    // CSR
+    case ExecOp::CSRRW:  exec_csrrw(*this, decoded);  break;
+    case ExecOp::CSRRS:  exec_csrrs(*this, decoded);  break;
+    case ExecOp::CSRRC:  exec_csrrc(*this, decoded);  break;
+    case ExecOp::CSRRWI: exec_csrrwi(*this, decoded); break;
+    case ExecOp::CSRRSI: exec_csrrsi(*this, decoded); break;
+    case ExecOp::CSRRCI: exec_csrrci(*this, decoded); break;
     // BRANCH
-    case Instruction::Category::BRANCH:
-      if (decoded.type == Instruction::Type::B) {
-        branch_count_++;
-        bool taken = false;
-        switch (decoded.funct3) {
-          case 0x0: taken = exec_beq(*this, decoded); break; // BEQ
-          case 0x1: taken = exec_bne(*this, decoded); break; // BNE
-          case 0x4: taken = exec_blt(*this, decoded); break; // BLT
-          case 0x5: taken = exec_bge(*this, decoded); break; // BGE
-          case 0x6: taken = exec_bltu(*this, decoded); break; // BLTU
-          case 0x7: taken = exec_bgeu(*this, decoded); break; // BGEU
-          default: break;
-        }
-        if (taken) {
-          branch_taken_count_++;
-          const int32_t offset = decoded.b.imm;
-          next_pc = static_cast<uint32_t>(static_cast<int32_t>(curr_pc) + offset);
-        }
+    case ExecOp::BEQ:
+    case ExecOp::BNE:
+    case ExecOp::BLT:
+    case ExecOp::BGE:
+    case ExecOp::BLTU:
+    case ExecOp::BGEU: {
+      branch_count_++;
+      bool taken = false;
+      switch (entry->op) {
+        case ExecOp::BEQ:  taken = exec_beq(*this, decoded);  break;
+        case ExecOp::BNE:  taken = exec_bne(*this, decoded);  break;
+        case ExecOp::BLT:  taken = exec_blt(*this, decoded);  break;
+        case ExecOp::BGE:  taken = exec_bge(*this, decoded);  break;
+        case ExecOp::BLTU: taken = exec_bltu(*this, decoded); break;
+        default:           taken = exec_bgeu(*this, decoded); break;
+      }
+      const uint32_t target = static_cast<uint32_t>(static_cast<int32_t>(curr_pc) + decoded.b.imm);
+      if (taken) {
+        branch_taken_count_++;
+        next_pc = target;
+        if (profile_) profile_->branch_taken(curr_pc, next_pc);
       }
+      if (bpred_ && bpred_->branch(curr_pc, target, taken)) bpred_bubble_ = bpred_->penalty();
       break;
+    }
     // CUSTOM
-    case Instruction::Category::CUSTOM:
+    case ExecOp::CUSTOM0:
+      if (accel_queued_) {            // v2: queue it and keep going (issue_hazard checked for room)
+        issue_accel_cmd(decoded, curr_pc);
+        break;
+      }
       exec_custom0(*this, decoded); // execute custom instr (Tile1_exec.cpp)
       break;
+    case ExecOp::Unknown:
     default:
       break;
   }
@@ -528,9 +474,32 @@ void Tile1::reset() {
   ifetch_wait_         = false;
   ifetch_valid_        = false;
   ifetch_word_         = 0;
+  fline_               = FetchLine{};
+  fline_next_          = FetchLine{};
+  fline_wait_          = false;
+  fline_req_prefetch_  = false;
+  fline_req_tag_       = 0;
+  fetch_line_hits_     = 0;
+  fetch_line_misses_   = 0;
+  fetch_prefetches_    = 0;
+  fetch_prefetch_hits_ = 0;
   dmem_wait_           = false;
   dmem_op_             = DmemOp::None;
   dmem_rmw_write_issued_ = false;
+  nb_inflight_         = 0;
+  nb_free_             = (1u << nb_load_slots_) - 1u;
+  load_sb_             = 0;
+  nb_loads_issued_     = 0;
+  nb_latency_cycles_   = 0;
+  nb_use_stalls_       = 0;
+  nb_slot_stalls_      = 0;
+  nb_busy_cycles_      = 0;
+  nb_inflight_sum_     = 0;
+  accel_sb_            = 0;
+  accel_inflight_      = 0;
+  accel_cmds_          = 0;
+  accel_full_stalls_   = 0;
+  accel_empty_stalls_  = 0;
   dmem_rd_             = 0;
   dmem_addr_           = 0;
   dmem_store_data_     = 0;
@@ -547,15 +516,36 @@ void Tile1::reset() {
   arith_count_         = 0;
   add_count_           = 0;
   mul_count_           = 0;
+  simd_count_          = 0;
   load_count_          = 0;
   store_count_         = 0;
   branch_count_        = 0;
   branch_taken_count_  = 0;
+  cycle_count_         = 0;
+  fetch_stall_cycles_  = 0;
+  dmem_stall_cycles_   = 0;
+  accel_stall_cycles_  = 0;
+  cpi_cycles_.fill(0);
+  bpred_bubble_        = 0;
+  bpred_penalty_cycles_ = 0;
+  counter_offset_.fill(0);
+  hpm_event_.fill(0);
+  decode_cache_.flush();
+  decode_cache_.reset_stats();
+  flush_blocks();
+  block_smc_           = false;
+  block_dispatches_    = 0;
+  block_insts_         = 0;
+  jit_blocks_          = 0;
+  jit_dispatches_      = 0;
+  jit_insts_           = 0;
+  jit_flushes_         = 0;
   trap_pending_        = false;
   pc_override_pending_ = false;
   priv_mode_           = PrivMode::Machine; // init priv_mode_ to M
   reset_trap_csrs();
   csrs_.clear();
+  reset_harts();
 }
 
 // Helper for completing a data memory access after a stall: 
@@ -563,32 +553,12 @@ void Tile1::reset() {
 void Tile1::complete_dmem(uint32_t resp_data) {
   switch (dmem_op_) {
     case DmemOp::LW:
-      if (dmem_rd_ != 0) write_reg(dmem_rd_, resp_data);
-      break;
-    case DmemOp::LB: {
-      const uint32_t shift = (dmem_addr_ & 0x3u) * 8u;
-      const int8_t byte = static_cast<int8_t>((resp_data >> shift) & 0xffu);
-      if (dmem_rd_ != 0) write_reg(dmem_rd_, static_cast<uint32_t>(byte));
-      break;
-    }
-    case DmemOp::LBU: {
-      const uint32_t shift = (dmem_addr_ & 0x3u) * 8u;
-      const uint32_t byte = (resp_data >> shift) & 0xffu;
-      if (dmem_rd_ != 0) write_reg(dmem_rd_, byte);
-      break;
-    }
-    case DmemOp::LH: {
-      const uint32_t shift = (dmem_addr_ & 0x2u) * 8u;
-      const int16_t half = static_cast<int16_t>((resp_data >> shift) & 0xffffu);
-      if (dmem_rd_ != 0) write_reg(dmem_rd_, static_cast<uint32_t>(half));
-      break;
-    }
-    case DmemOp::LHU: {
-      const uint32_t shift = (dmem_addr_ & 0x2u) * 8u;
-      const uint32_t half = (resp_data >> shift) & 0xffffu;
-      if (dmem_rd_ != 0) write_reg(dmem_rd_, half);
+    case DmemOp::LB:
+    case DmemOp::LBU:
+    case DmemOp::LH:
+    case DmemOp::LHU:
+      if (dmem_rd_ != 0) write_reg(dmem_rd_, load_value(dmem_op_, dmem_addr_, resp_data));
       break;
-    }
     case DmemOp::SW:
       break;
     // Transaction 2: WRITE request
@@ -598,7 +568,8 @@ void Tile1::complete_dmem(uint32_t resp_data) {
         const uint32_t merged = (resp_data & ~dmem_store_mask_) |
           ((dmem_store_data_ << dmem_store_shift_) & dmem_store_mask_);
         assert_always(mem_port_->can_request(), "Timed SB/SH RMW write phase requires request slot");
-        mem_port_->request_write32(dmem_addr_ & ~0x3u, merged); // transaction 2: WRITE in what you want to modify
+        mem_port_->request_write32_tagged(dmem_addr_ & ~0x3u, merged, hart_tag_); // transaction 2: WRITE in what you want to modify
+        note_code_store(dmem_addr_ & ~0x3u);
         dmem_rmw_write_issued_ = true; // read-modify-write (RMW) for sub-word stores
         dmem_store_data_ = merged;
         return;                        // jump out of Tile1::tick() 
@@ -622,6 +593,497 @@ void Tile1::complete_dmem(uint32_t resp_data) {
   regs_[0] = 0;
 }
 
+// Sign/zero-extend the addressed byte/half/word of an aligned load response
+uint32_t Tile1::load_value(DmemOp op, uint32_t addr, uint32_t word) const {
+  switch (op) {
+    case DmemOp::LB:  return static_cast<uint32_t>(static_cast<int8_t>((word >> ((addr & 0x3u) * 8u)) & 0xffu));
+    case DmemOp::LBU: return (word >> ((addr & 0x3u) * 8u)) & 0xffu;
+    case DmemOp::LH:  return static_cast<uint32_t>(static_cast<int16_t>((word >> ((addr & 0x2u) * 8u)) & 0xffffu));
+    case DmemOp::LHU: return (word >> ((addr & 0x2u) * 8u)) & 0xffffu;
+    default:          return word;
+  }
+}
+
+void Tile1::set_nonblocking_loads(uint32_t slots) {
+  assert_always(slots <= kMaxNbLoads, "non-blocking loads: at most Tile1::kMaxNbLoads in flight");
+  assert_always(slots == 0 || !mem_port_ || mem_port_->supports_tags(), "non-blocking loads need a port with tagged reads");
+  assert_always(nb_inflight_ == 0, "non-blocking load slots changed with loads in flight");
+  assert_always(slots == 0 || hw_threads_ == 1, "non-blocking loads do not combine with hardware threads");
+  nb_load_slots_ = slots;
+  nb_free_       = (1u << slots) - 1u;
+  check_issue_   = nb_load_slots_ != 0 || hw_threads_ > 1 || accel_queued_;
+}
+
+// Hold an instruction that touches a register a load is still filling (RAW and WAW alike),
+// a timed load/store with no request slot to go to, or (harts) a CUSTOM-0 while another
+// hart owns the accelerator.  Stall cycles count as dmem (accel) stalls.
+bool Tile1::issue_hazard(const DecodeCache::Entry& e, uint32_t pc) {
+  if (accel_queued_ && accel_hazard(e)) {
+    accel_stall_cycles_++;
+    cpi_stall_ = CpiSlot::Accel;
+    if (profile_) profile_->stall(PcProfile::Accel, pc);
+    last_pc_ = pc;
+    return true;
+  }
+  if (load_sb_ & e.regs) {
+    nb_use_stalls_++;
+    cpi_stall_ = CpiSlot::LoadUse;
+  } else if (e.op >= ExecOp::LB && e.op <= ExecOp::SW && mem_model_ == MemModel::Timed &&
+             (!mem_port_->can_request() || (nb_load_slots_ != 0 && e.op <= ExecOp::LHU && nb_free_ == 0))) {
+    if (nb_load_slots_ != 0) nb_slot_stalls_++;
+    cpi_stall_ = CpiSlot::PortBusy;
+  } else if (e.op == ExecOp::CUSTOM0 && hw_threads_ > 1 && accel_owned_elsewhere()) {
+    accel_stall_cycles_++;
+    cpi_stall_ = CpiSlot::Accel;
+    if (profile_) profile_->stall(PcProfile::Accel, pc);
+    last_pc_ = pc;
+    hart_held_ = true;
+    return true;
+  } else {
+    return false;
+  }
+  hart_held_ = true;
+  dmem_stall_cycles_++;
+  if (profile_) profile_->stall(PcProfile::Dmem, pc);
+  last_pc_ = pc;
+  return true;
+}
+
+// A CUSTOM-0 needs a free queue slot and none of its registers pending (results come back
+// tagged by rd, so a second command to the same rd waits for the first).  Anything else
+// waits only if it touches a pending rd; CSR/SYSTEM/FENCE (all registers) drain the queue.
+bool Tile1::accel_hazard(const DecodeCache::Entry& e) {
+  if (e.op == ExecOp::CUSTOM0) {
+    const auto& op = e.instr.r;
+    if (accel_sb_ & ((1u << op.rd) | (1u << op.rs1) | (1u << op.rs2))) {
+      accel_empty_stalls_++;
+      return true;
+    }
+    if (accel_port_->busy()) {
+      accel_full_stalls_++;
+      return true;
+    }
+    return false;
+  }
+  if ((accel_sb_ & e.regs) || (e.regs == ~1u && accel_inflight_ != 0)) {
+    accel_empty_stalls_++;
+    return true;
+  }
+  return false;
+}
+
+void Tile1::issue_accel_cmd(const Instruction& decoded, uint32_t pc) {
+  const auto& op = decoded.r;
+  accel_port_->issue_tagged(decoded.raw, pc, read_reg(op.rs1), read_reg(op.rs2), op.rd);
+  accel_sb_ |= (1u << op.rd) & ~1u;
+  accel_inflight_++;
+  accel_cmds_++;
+}
+
+void Tile1::drain_accel_responses() {
+  while (accel_port_->has_response()) {
+    const uint32_t rd = accel_port_->resp_tag();
+    const uint32_t value = accel_port_->read_response();
+    if (rd != 0) write_reg(rd, value);
+    accel_sb_ &= ~(1u << rd);
+    accel_inflight_--;
+  }
+}
+
+// Responses come back tagged: 1..kMaxNbLoads are load slots, 0 is everything else
+// (a fetch line is absorbed here so loads queued behind it are not held up).
+void Tile1::drain_nb_loads() {
+  while (mem_port_->resp_valid()) {
+    const uint32_t tag = mem_port_->resp_tag();
+    if (tag == 0u) {
+      if (!fline_wait_) return;   // fetch word or store ack: its own wait handles it
+      absorb_fetch_line();
+      continue;
+    }
+    if (tag > kMaxNbLoads) return; // accelerator's (AccelPort::kMemTag)
+    const uint32_t slot = tag - 1u;
+    const PendingLoad& ld = nb_loads_[slot];
+    if (ld.rd != 0) write_reg(ld.rd, load_value(ld.op, ld.addr, mem_port_->resp_data()));
+    mem_port_->resp_consume();
+    load_sb_ &= ~(1u << ld.rd);     // WAW stalls keep a second load to the same rd out of flight
+    nb_latency_cycles_ += cycle_count_ - ld.issued;
+    nb_free_ |= 1u << slot;
+    nb_inflight_--;
+  }
+}
+
+void Tile1::set_hw_threads(uint32_t n, HartSwitch policy) {
+  assert_always(n >= 1u && n <= kMaxHarts, "hardware threads: 1..Tile1::kMaxHarts");
+  assert_always(n == 1u || (nb_load_slots_ == 0 && fetch_line_bytes_ == 0 && !accel_queued_),
+                "hardware threads do not combine with non-blocking loads, the fetch line buffer or a decoupled accelerator");
+  assert_always(n == 1u || !mem_port_ || mem_model_ == MemModel::Ideal ||
+                (mem_port_->supports_tags() && mem_port_->max_outstanding() > n),
+                "hardware threads need a tagged port with more than one slot per hart (one is the accelerator's)");
+  assert_always(quiescent(), "hardware threads changed with requests in flight");
+  if (hw_threads_ > 1) switch_hart(0);
+  hw_threads_  = n;
+  hart_switch_ = policy;
+  check_issue_ = nb_load_slots_ != 0 || hw_threads_ > 1 || accel_queued_;
+  reset_harts();
+}
+
+void Tile1::hart_context(uint32_t h, ThreadContext* out) const {
+  if (h == hart_) {
+    save_context(*out);
+    out->active = !halted_;
+    return;
+  }
+  const Hart& src = harts_[h];
+  out->pc = src.pc;
+  std::copy(src.regs.begin(), src.regs.end(), out->regs);
+  out->active = !src.halted;
+}
+
+// Every hart starts as a copy of the running one (same pc and registers; mhartid tells them apart)
+void Tile1::reset_harts() {
+  hart_       = 0;
+  hart_tag_   = hw_threads_ > 1 ? kHartTag : 0u;
+  live_harts_ = hw_threads_;
+  mail_valid_ = false;
+  mail_data_  = 0;
+  hart_held_  = false;
+  for (Hart& h : harts_) park_hart(h);
+  hart_stats_.fill(HartStats{});
+  hart_switches_ = 0;
+}
+
+void Tile1::park_hart(Hart& h) const {
+  h.pc = pc_;
+  h.last_pc = last_pc_;
+  h.last_instr = last_instr_;
+  h.regs = regs_;
+  h.ifetch_wait = ifetch_wait_;
+  h.ifetch_valid = ifetch_valid_;
+  h.ifetch_word = ifetch_word_;
+  h.dmem_wait = dmem_wait_;
+  h.dmem_op = dmem_op_;
+  h.dmem_rmw_write_issued = dmem_rmw_write_issued_;
+  h.dmem_rd = dmem_rd_;
+  h.dmem_addr = dmem_addr_;
+  h.dmem_store_data = dmem_store_data_;
+  h.dmem_store_mask = dmem_store_mask_;
+  h.dmem_store_shift = dmem_store_shift_;
+  h.dmem_next_pc = dmem_next_pc_;
+  h.accel_wait = accel_wait_;
+  h.accel_rd = accel_rd_;
+  h.accel_next_pc = accel_next_pc_;
+  h.halted = halted_;
+  h.exited = exited_;
+  h.exit_code = exit_code_;
+  h.trap_csrs = trap_csrs_;
+  h.trap_pending = trap_pending_;
+  h.pending_trap = pending_trap_;
+  h.pc_override_pending = pc_override_pending_;
+  h.pc_override_value = pc_override_value_;
+  h.priv = priv_mode_;
+  h.mail_valid = mail_valid_;
+  h.mail_data = mail_data_;
+  h.bpred_bubble = bpred_bubble_;
+}
+
+void Tile1::unpark_hart(const Hart& h) {
+  pc_ = h.pc;
+  last_pc_ = h.last_pc;
+  last_instr_ = h.last_instr;
+  regs_ = h.regs;
+  ifetch_wait_ = h.ifetch_wait;
+  ifetch_valid_ = h.ifetch_valid;
+  ifetch_word_ = h.ifetch_word;
+  dmem_wait_ = h.dmem_wait;
+  dmem_op_ = h.dmem_op;
+  dmem_rmw_write_issued_ = h.dmem_rmw_write_issued;
+  dmem_rd_ = h.dmem_rd;
+  dmem_addr_ = h.dmem_addr;
+  dmem_store_data_ = h.dmem_store_data;
+  dmem_store_mask_ = h.dmem_store_mask;
+  dmem_store_shift_ = h.dmem_store_shift;
+  dmem_next_pc_ = h.dmem_next_pc;
+  accel_wait_ = h.accel_wait;
+  accel_rd_ = h.accel_rd;
+  accel_next_pc_ = h.accel_next_pc;
+  halted_ = h.halted;
+  exited_ = h.exited;
+  exit_code_ = h.exit_code;
+  trap_csrs_ = h.trap_csrs;
+  trap_pending_ = h.trap_pending;
+  pending_trap_ = h.pending_trap;
+  pc_override_pending_ = h.pc_override_pending;
+  pc_override_value_ = h.pc_override_value;
+  priv_mode_ = h.priv;
+  mail_valid_ = h.mail_valid;
+  mail_data_ = h.mail_data;
+  bpred_bubble_ = h.bpred_bubble;
+}
+
+void Tile1::switch_hart(uint32_t h) {
+  if (h == hart_) return;
+  park_hart(harts_[hart_]);
+  unpark_hart(harts_[h]);
+  hart_     = h;
+  hart_tag_ = kHartTag + h;
+  hart_stats_[h].switches_in++;
+  hart_switches_++;
+}
+
+bool Tile1::hart_blocked(const Hart& h) const {
+  return h.halted || ((h.ifetch_wait || h.dmem_wait) && !h.mail_valid) ||
+         (h.accel_wait && !(accel_port_ && accel_port_->has_response()));
+}
+
+bool Tile1::active_blocked() const {
+  return ((ifetch_wait_ || dmem_wait_) && !mail_valid_) || (accel_wait_ && !(accel_port_ && accel_port_->has_response()));
+}
+
+bool Tile1::accel_owned_elsewhere() const {
+  for (uint32_t h = 0; h < hw_threads_; ++h) {
+    if (h != hart_ && harts_[h].accel_wait) return true;
+  }
+  return false;
+}
+
+bool Tile1::parked_harts_idle() const {
+  for (uint32_t h = 0; h < hw_threads_; ++h) {
+    const Hart& p = harts_[h];
+    if (h != hart_ && (p.ifetch_wait || p.dmem_wait || p.accel_wait)) return false;
+  }
+  return true;
+}
+
+// Responses tagged kHartTag + h go to hart h's mailbox; stop at anything else (the accelerator's)
+void Tile1::route_hart_responses() {
+  while (mem_port_->resp_valid()) {
+    const uint32_t tag = mem_port_->resp_tag();
+    if (tag < kHartTag) return;
+    const uint32_t h = tag - kHartTag;
+    bool&     valid = h == hart_ ? mail_valid_ : harts_[h].mail_valid;
+    uint32_t& data  = h == hart_ ? mail_data_  : harts_[h].mail_data;
+    assert_always(h < hw_threads_ && !valid, "hart response with no request outstanding");
+    valid = true;
+    data  = mem_port_->resp_data();
+    mem_port_->resp_consume();
+  }
+}
+
+// OnStall: keep the running hart until it waits on a fetch, data access or the accelerator.
+// RoundRobin: rotate every cycle.  Either way, skip harts that cannot make progress.
+void Tile1::select_hart() {
+  const bool held = hart_held_; // issue_hazard held it last cycle
+  hart_held_ = false;
+  if (hart_switch_ == HartSwitch::OnStall && !held && !active_blocked()) return;
+  for (uint32_t i = 1; i < hw_threads_; ++i) {
+    const uint32_t h = (hart_ + i) % hw_threads_;
+    if (!hart_blocked(harts_[h])) {
+      switch_hart(h);
+      return;
+    }
+  }
+}
+
+void Tile1::hart_stopped() {
+  live_harts_--;
+  if (live_harts_ == 0) {      // tile stops; it shows hart 0 (and its exit code) from here on
+    switch_hart(0);
+    return;
+  }
+  for (uint32_t i = 1; i < hw_threads_; ++i) {
+    const uint32_t h = (hart_ + i) % hw_threads_;
+    if (!harts_[h].halted) {
+      switch_hart(h);
+      return;
+    }
+  }
+}
+
+// One cycle with hw_threads_ > 1: memory and accelerator advance, responses are routed
+// to their harts, then one hart runs (the block engine stays off: one instruction per tick).
+void Tile1::tick_harts() {
+  if (halted_) return;   // only once every hart has stopped
+  if (!mem_port_) {
+    last_pc_ = pc_;
+    last_instr_ = 0;
+    return;
+  }
+  cycle_count_++;
+  mem_port_->cycle();
+  if (accel_port_) accel_port_->tick();
+  route_hart_responses();
+  select_hart();
+  const uint32_t h = hart_;
+  const uint64_t insts = inst_count_;
+  cpi_stall_ = CpiSlot::Other;
+  run_hart();
+  account_cycles(insts);
+  hart_stats_[h].cycles++;
+  hart_stats_[h].insts += inst_count_ - insts;
+  if (halted_) hart_stopped();
+}
+
+void Tile1::set_fetch_line(uint32_t bytes, bool prefetch) {
+  assert_always(bytes == 0 || hw_threads_ == 1, "the fetch line buffer does not combine with hardware threads");
+  assert_always(bytes == 0 || (bytes >= 4u && bytes <= smem::MemoryPort::kMaxLineBytes && (bytes & (bytes - 1u)) == 0u),
+                "fetch line must be 0 or a power of two from 4 to MemoryPort::kMaxLineBytes");
+  assert_always(bytes == 0 || !mem_port_ || mem_port_->supports_line_reads(), "fetch line buffer needs a port with line reads");
+  fetch_line_bytes_ = bytes;
+  fetch_prefetch_   = prefetch;
+  fline_.valid = fline_next_.valid = false;
+}
+
+// Serve pc from the current line, promoting the prefetched line if pc has moved onto it.
+// On a miss, request the line (unless a line is already on its way) and stall.
+bool Tile1::fetch_from_line(uint32_t pc, uint32_t* word) {
+  const uint32_t tag = pc & ~(fetch_line_bytes_ - 1u);
+  if (!fline_.valid || fline_.tag != tag) {
+    if (fline_next_.valid && fline_next_.tag == tag) {
+      std::swap(fline_, fline_next_);
+      fline_next_.valid = false;
+      fetch_prefetch_hits_++;
+    } else {
+      fetch_stall_cycles_++;
+      cpi_stall_ = CpiSlot::Fetch;
+      if (profile_) profile_->stall(PcProfile::Fetch, pc);
+      if (!fline_wait_ && mem_port_->can_request()) {
+        mem_port_->request_read_line(tag, fetch_line_bytes_);
+        fline_wait_         = true;
+        fline_req_prefetch_ = false;
+        fline_req_tag_      = tag;
+        fetch_line_misses_++;
+      }
+      return false;
+    }
+  }
+  *word = fline_.words[(pc - tag) >> 2];
+  return true;
+}
+
+void Tile1::prefetch_next_line() {
+  if (!fetch_prefetch_ || fline_wait_ || !mem_port_->can_request()) return;
+  const uint32_t next = fline_.tag + fetch_line_bytes_;
+  if (fline_next_.valid && fline_next_.tag == next) return;
+  mem_port_->request_read_line(next, fetch_line_bytes_);
+  fline_wait_         = true;
+  fline_req_prefetch_ = true;
+  fline_req_tag_      = next;
+  fetch_prefetches_++;
+}
+
+void Tile1::absorb_fetch_line() {
+  FetchLine& dst = fline_req_prefetch_ ? fline_next_ : fline_;
+  const uint32_t* src = mem_port_->resp_line();
+  std::copy(src, src + fetch_line_bytes_ / 4u, dst.words.begin());
+  dst.tag   = fline_req_tag_;
+  dst.valid = true;
+  mem_port_->resp_consume();
+  fline_wait_ = false;
+}
+
+// -trace_out: classify a retiring instruction; loads/stores also carry their effective address
+void Tile1::trace_retire(uint32_t pc, ExecOp op, const Instruction& decoded) {
+  using Kind = smem::MemTrace::Kind;
+  if (op >= ExecOp::LB && op <= ExecOp::LHU) {
+    const uint32_t addr = static_cast<uint32_t>(static_cast<int32_t>(read_reg(decoded.i.rs1)) + decoded.i.imm);
+    trace_out_->record(pc, Kind::Load, addr, static_cast<uint8_t>(1u << (decoded.funct3 & 0x3u)));
+    return;
+  }
+  if (op >= ExecOp::SB && op <= ExecOp::SW) {
+    const uint32_t addr = static_cast<uint32_t>(static_cast<int32_t>(read_reg(decoded.s.rs1)) + decoded.s.imm);
+    trace_out_->record(pc, Kind::Store, addr, static_cast<uint8_t>(1u << (decoded.funct3 & 0x3u)));
+    return;
+  }
+  Kind kind = Kind::Other;
+  if      (op >= ExecOp::MUL && op <= ExecOp::MULW)       kind = Kind::Mul;
+  else if (op >= ExecOp::ADD && op <= ExecOp::AUIPC)      kind = Kind::Alu;
+  else if (op >= ExecOp::BEQ && op <= ExecOp::BGEU)       kind = Kind::Branch;
+  else if (op == ExecOp::JAL || op == ExecOp::JALR)       kind = Kind::Jump;
+  else if (op >= ExecOp::ECALL && op <= ExecOp::CSRRCI)   kind = Kind::System;
+  else if (op == ExecOp::CUSTOM0)                         kind = Kind::Custom;
+  else if (op >= ExecOp::PADD_B && op <= ExecOp::PSADDU_H) kind = Kind::Simd;
+  trace_out_->record(pc, kind);
+}
+
+// Ideal (synchronous) load: shared by the per-instruction path and the block engine
+void Tile1::load_ideal(const Instruction& decoded) {
+  const auto& op = decoded.i;
+  const int32_t base = static_cast<int32_t>(read_reg(op.rs1));
+  const uint32_t addr = static_cast<uint32_t>(base + op.imm);
+  const uint32_t word = mem_direct_.read32(addr & ~0x3u);
+  uint32_t value = 0;
+  switch (decoded.funct3) {
+    case 0x0: {
+      const uint32_t shift = (addr & 0x3u) * 8u;
+      const int8_t byte = static_cast<int8_t>((word >> shift) & 0xffu);
+      value = static_cast<uint32_t>(byte);
+      break;
+    }
+    case 0x1: {
+      assert_always((addr & 0x1u) == 0u, "LH requires 2-byte alignment");
+      const uint32_t shift = (addr & 0x2u) * 8u;
+      const int16_t half = static_cast<int16_t>((word >> shift) & 0xffffu);
+      value = static_cast<uint32_t>(half);
+      break;
+    }
+    case 0x2:
+      assert_always((addr & 0x3u) == 0u, "LW requires 4-byte alignment");
+      value = word;
+      break;
+    case 0x4: {
+      const uint32_t shift = (addr & 0x3u) * 8u;
+      value = (word >> shift) & 0xffu;
+      break;
+    }
+    case 0x5: {
+      assert_always((addr & 0x1u) == 0u, "LHU requires 2-byte alignment");
+      const uint32_t shift = (addr & 0x2u) * 8u;
+      value = (word >> shift) & 0xffffu;
+      break;
+    }
+    default:
+      assert_always(false, "Unsupported load funct3 in ideal data path");
+      break;
+  }
+  if (op.rd != 0) write_reg(op.rd, value);
+}
+
+// Ideal (synchronous) store: shared by the per-instruction path and the block engine
+void Tile1::store_ideal(const Instruction& decoded) {
+  const auto& op = decoded.s;
+  const int32_t base = static_cast<int32_t>(read_reg(op.rs1));
+  const uint32_t addr = static_cast<uint32_t>(base + op.imm);
+  const uint32_t data = read_reg(op.rs2);
+  const uint32_t aligned = addr & ~0x3u;
+  note_code_store(aligned);
+  switch (decoded.funct3) {
+    case 0x0: {
+      const uint32_t shift = (addr & 0x3u) * 8u;
+      const uint32_t mask = 0xffu << shift;
+      const uint32_t prior = mem_direct_.read32(aligned);
+      const uint32_t merged = (prior & ~mask) | ((data << shift) & mask);
+      mem_direct_.write32(aligned, merged);
+      break;
+    }
+    case 0x1: {
+      assert_always((addr & 0x1u) == 0u, "SH requires 2-byte alignment");
+      const uint32_t shift = (addr & 0x2u) * 8u;
+      const uint32_t mask = 0xffffu << shift;
+      const uint32_t prior = mem_direct_.read32(aligned);
+      const uint32_t merged = (prior & ~mask) | ((data << shift) & mask);
+      mem_direct_.write32(aligned, merged);
+      break;
+    }
+    case 0x2:
+      assert_always((addr & 0x3u) == 0u, "SW requires 4-byte alignment");
+      mem_direct_.write32(aligned, data);
+      break;
+    default:
+      assert_always(false, "Unsupported store funct3 in ideal data path");
+      break;
+  }
+}
+
 void Tile1::write_reg(uint32_t idx, uint32_t value) {
   if (idx == 0 || idx >= regs_.size()) return;
   regs_[idx] = value;
@@ -636,6 +1098,93 @@ void Tile1::halt() {
 void Tile1::set_pc(uint32_t pc) { // a way to set your PC
   pc_ = pc;
   pc_override_pending_ = false;
+  for (Hart& h : harts_) { // every hart boots here
+    h.pc = pc;
+    h.pc_override_pending = false;
+  }
+}
+
+Tile1::ArchState Tile1::save_arch_state() const {
+  ArchState s;
+  s.pc = pc_;
+  for (size_t i = 0; i < regs_.size(); ++i) s.regs[i] = regs_[i];
+  s.mstatus = trap_csrs_.mstatus;
+  s.mtvec   = trap_csrs_.mtvec;
+  s.mepc    = trap_csrs_.mepc;
+  s.mcause  = trap_csrs_.mcause;
+  s.priv                = priv_mode_;
+  s.trap_pending        = trap_pending_;
+  s.pending_trap        = pending_trap_;
+  s.pc_override_pending = pc_override_pending_;
+  s.pc_override_value   = pc_override_value_;
+  s.halted    = halted_;
+  s.exited    = exited_;
+  s.exit_code = exit_code_;
+  const uint64_t counters[9] = {inst_count_, arith_count_, add_count_, mul_count_,
+                                load_count_, store_count_, branch_count_, branch_taken_count_, simd_count_};
+  for (int i = 0; i < 9; ++i) s.counters[i] = counters[i];
+  s.cycles    = cycle_count_;
+  s.stalls[0] = fetch_stall_cycles_;
+  s.stalls[1] = dmem_stall_cycles_;
+  s.stalls[2] = accel_stall_cycles_;
+  std::copy(cpi_cycles_.begin(), cpi_cycles_.end(), s.cpi);
+  std::copy(counter_offset_.begin(), counter_offset_.end(), s.counter_offset);
+  std::copy(hpm_event_.begin(), hpm_event_.end(), s.hpm_event);
+  s.csrs.assign(csrs_.begin(), csrs_.end());
+  std::sort(s.csrs.begin(), s.csrs.end()); // deterministic checkpoint bytes
+  return s;
+}
+
+void Tile1::load_arch_state(const ArchState& s) {
+  pc_ = s.pc;
+  for (size_t i = 0; i < regs_.size(); ++i) regs_[i] = s.regs[i];
+  regs_[0] = 0;
+  trap_csrs_.mstatus = s.mstatus;
+  trap_csrs_.mtvec   = s.mtvec;
+  trap_csrs_.mepc    = s.mepc;
+  trap_csrs_.mcause  = s.mcause;
+  priv_mode_           = s.priv;
+  trap_pending_        = s.trap_pending;
+  pending_trap_        = s.pending_trap;
+  pc_override_pending_ = s.pc_override_pending;
+  pc_override_value_   = s.pc_override_value;
+  halted_    = s.halted;
+  exited_    = s.exited;
+  exit_code_ = s.exit_code;
+  inst_count_         = s.counters[0];
+  arith_count_        = s.counters[1];
+  add_count_          = s.counters[2];
+  mul_count_          = s.counters[3];
+  load_count_         = s.counters[4];
+  store_count_        = s.counters[5];
+  branch_count_       = s.counters[6];
+  branch_taken_count_ = s.counters[7];
+  simd_count_         = s.counters[8];
+  cycle_count_        = s.cycles;
+  fetch_stall_cycles_ = s.stalls[0];
+  dmem_stall_cycles_  = s.stalls[1];
+  accel_stall_cycles_ = s.stalls[2];
+  std::copy(s.cpi, s.cpi + cpi_cycles_.size(), cpi_cycles_.begin());
+  std::copy(s.counter_offset, s.counter_offset + counter_offset_.size(), counter_offset_.begin());
+  std::copy(s.hpm_event, s.hpm_event + hpm_event_.size(), hpm_event_.begin());
+  csrs_.clear();
+  for (const auto& kv : s.csrs) csrs_[kv.first] = kv.second;
+  // A checkpoint is taken between requests: nothing buffered or in flight
+  ifetch_wait_  = false;
+  ifetch_valid_ = false;
+  fline_wait_   = false;
+  dmem_wait_    = false;
+  nb_inflight_  = 0;
+  nb_free_      = (1u << nb_load_slots_) - 1u;
+  load_sb_      = 0;
+  accel_sb_     = 0;
+  accel_inflight_ = 0;
+  dmem_op_      = DmemOp::None;
+  accel_wait_   = false;
+  // Memory was replaced underneath us
+  flush_decode_cache();
+  block_smc_ = false;
+  mem_direct_.reset();
 }
 
 uint32_t Tile1::read_csr(uint32_t addr) const {
@@ -644,8 +1193,11 @@ uint32_t Tile1::read_csr(uint32_t addr) const {
     case CSR_MTVEC:   return trap_csrs_.mtvec;
     case CSR_MEPC:    return trap_csrs_.mepc;
     case CSR_MCAUSE:  return trap_csrs_.mcause;
+    case CSR_MHARTID: return hart_;
     default: break;
   }
+  uint32_t value = 0;
+  if (read_counter_csr(addr, &value)) return value;
   auto it = csrs_.find(addr);
   return (it == csrs_.end()) ? 0u : it->second;
 }
@@ -658,7 +1210,7 @@ void Tile1::write_csr(uint32_t addr, uint32_t value) {
     case CSR_MEPC:    trap_csrs_.mepc    = value; break;
     case CSR_MCAUSE:  trap_csrs_.mcause  = value; break;
     default:
-      handled = false;
+      handled = write_counter_csr(addr, value);
       break;
   }
   if (!handled) {
@@ -667,6 +1219,75 @@ void Tile1::write_csr(uint32_t addr, uint32_t value) {
   trace("csr[0x%x] <= 0x%x\n", addr, value);
 }
 
+uint64_t Tile1::event_count(HpmEvent e) const {
+  switch (e) {
+    case HpmEvent::FetchStall:  return fetch_stall_cycles_;
+    case HpmEvent::DmemStall:   return dmem_stall_cycles_;
+    case HpmEvent::AccelStall:  return accel_stall_cycles_;
+    case HpmEvent::Load:        return load_count_;
+    case HpmEvent::Store:       return store_count_;
+    case HpmEvent::Branch:      return branch_count_;
+    case HpmEvent::BranchTaken: return branch_taken_count_;
+    case HpmEvent::Arith:       return arith_count_;
+    case HpmEvent::Mul:         return mul_count_;
+    case HpmEvent::Simd:        return simd_count_;
+    default:                    return 0;
+  }
+}
+
+uint64_t Tile1::counter_source(uint32_t slot) const {
+  if (slot == 0) return cycle_count_;
+  if (slot == 1) return inst_count_;
+  return event_count(static_cast<HpmEvent>(hpm_event_[slot - 2u]));
+}
+
+// Counter CSRs: mcycle/minstret/mhpmcounterN (+h), their user shadows and mhpmevent selectors.
+// Slot = address offset from the bank base: 0 mcycle, 1 time (user only), 2 instret, 3..31 hpm.
+bool Tile1::read_counter_csr(uint32_t addr, uint32_t* value) const {
+  if (addr >= CSR_MHPMEVENT3 && addr < CSR_MHPMEVENT3 + kHpmCounters) {
+    *value = hpm_event_[addr - CSR_MHPMEVENT3];
+    return true;
+  }
+  const uint32_t hi_off = addr & CSR_COUNTER_HI;
+  const uint32_t base   = addr & ~(CSR_COUNTER_HI | 0x1fu);
+  if (base != CSR_MCYCLE && base != CSR_CYCLE) return false;
+  uint32_t idx = addr & 0x1fu;
+  if (idx == 1u) {
+    if (base != CSR_CYCLE) return false; // 0xb01 is not a CSR
+    idx = 0u;                            // time == cycle
+  }
+  const uint32_t slot = idx == 0u ? 0u : idx - 1u; // 0 mcycle, 1 minstret, 2.. hpm3..
+  const uint64_t v = counter_source(slot) - counter_offset_[slot];
+  *value = static_cast<uint32_t>(hi_off ? (v >> 32) : v);
+  return true;
+}
+
+bool Tile1::write_counter_csr(uint32_t addr, uint32_t value) {
+  if (addr >= CSR_MHPMEVENT3 && addr < CSR_MHPMEVENT3 + kHpmCounters) {
+    const uint32_t i    = addr - CSR_MHPMEVENT3;
+    const uint32_t slot = 2u + i;
+    const uint64_t keep = counter_source(slot) - counter_offset_[slot]; // counter value survives a reselect
+    hpm_event_[i] = value < static_cast<uint32_t>(HpmEvent::Count) ? value : 0u;
+    counter_offset_[slot] = counter_source(slot) - keep;
+    return true;
+  }
+  const uint32_t base = addr & ~(CSR_COUNTER_HI | 0x1fu);
+  if (base == CSR_CYCLE) { // user shadows are read-only
+    request_illegal_instruction();
+    return true;
+  }
+  if (base != CSR_MCYCLE || (addr & 0x1fu) == 1u) return false;
+  const uint32_t idx  = addr & 0x1fu;
+  const uint32_t slot = idx == 0u ? 0u : idx - 1u;
+  const uint64_t src  = counter_source(slot);
+  const uint64_t cur  = src - counter_offset_[slot];
+  const uint64_t next = (addr & CSR_COUNTER_HI)
+      ? (cur & 0xffffffffull) | (static_cast<uint64_t>(value) << 32)
+      : (cur & ~0xffffffffull) | value;
+  counter_offset_[slot] = src - next;
+  return true;
+}
+
 void Tile1::reset_trap_csrs() {
   trap_csrs_ = TrapCsrState{};
   pending_trap_ = TrapCause::EnvironmentCallFromUMode;
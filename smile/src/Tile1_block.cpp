@@ -0,0 +1,93 @@
+// **********************************************************************
+// smile/src/Tile1_block.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Basic-block engine for Tile1 in ideal-memory mode.  A block is the straight-line
+run of ALU/SIMD/LOAD/STORE instructions starting at some pc; it ends at the first
+branch, jump, CUSTOM-0, SYSTEM or CSR instruction (the terminator).  Bodies are
+cached as arrays of pre-bound handlers (kBlockTable in Tile1_dispatch.cpp) and
+retired in one tick; the terminator is left to the normal per-instruction path
+so traps, accelerator waits and PC redirects behave exactly as before.  Every
+handler bumps the same counters the per-instruction switch does, so [STATS] is
+unchanged.  With -jit, hot bodies run as native code instead (Tile1_jit.cpp).
+*/
+#include "Tile1.hpp"
+#include "Tile1_exec.hpp"
+#include "AccelPort.hpp"
+#include <algorithm>
+
+// Find (or discover and cache) the block starting at pc
+Tile1::Block& Tile1::lookup_block(uint32_t pc) {
+  auto it = blocks_.find(pc);
+  if (it != blocks_.end()) return it->second;
+
+  Block& blk = blocks_[pc];
+  uint32_t at = pc;
+  for (;;) {
+    const Instruction instr(mem_direct_.read32(at));
+    block_code_words_.insert(at); // terminator word too: patching it can change where the block ends
+    const BlockHandler fn = kBlockTable[static_cast<size_t>(resolve_exec_op(instr))];
+    if (!fn || blk.body.size() >= kMaxBlockBody) break;
+    blk.body.push_back(BlockInsn{fn, at, instr});
+    at += 4u;
+  }
+  block_code_lo_ = std::min(block_code_lo_, pc);
+  block_code_hi_ = std::max(block_code_hi_, at);
+  return blk;
+}
+
+// Retire up to max_insts body instructions of the block at pc_.  Each one after the
+// first gets its own memory/accelerator cycle, exactly as a separate tick would.
+uint32_t Tile1::run_block_body(uint32_t max_insts, bool* at_terminator) {
+  if (block_smc_) { // a store outside any body hit block code since the last dispatch
+    flush_blocks();
+    block_smc_ = false;
+  }
+  Block& blk = lookup_block(pc_);
+  const size_t n = std::min<size_t>(blk.body.size(), max_insts);
+  uint32_t retired = (jit_on_ && n == blk.body.size() && n != 0) ? jit_dispatch(blk) : 0; // 0 => interpret
+  if (retired != 0) { // ran natively: give the port/accelerator the cycles it covered
+    for (uint32_t k = 1; k < retired; ++k) {
+      mem_port_->cycle();
+      if (accel_port_) accel_port_->tick();
+    }
+    last_pc_    = blk.body[retired - 1].pc;
+    last_instr_ = blk.body[retired - 1].instr.raw;
+  } else {
+    for (size_t k = 0; k < n; ++k) {
+      const BlockInsn& bi = blk.body[k];
+      if (k != 0) {
+        mem_port_->cycle();
+        if (accel_port_) accel_port_->tick();
+      }
+      last_pc_    = bi.pc;
+      last_instr_ = bi.instr.raw;
+      trace("pc=0x%08x instr=0x%08x\n", bi.pc, bi.instr.raw);
+      bi.fn(*this, bi);
+      ++retired;
+      if (block_smc_) break; // body patched cached code: stop before running anything stale
+    }
+  }
+  regs_[0] = 0;
+  if (retired != 0) {
+    pc_ = blk.body[retired - 1].pc + 4u;
+    block_dispatches_++;
+    block_insts_ += retired;
+  }
+  *at_terminator = !block_smc_ && retired == blk.body.size();
+  if (block_smc_) {
+    flush_blocks(); // blk is dead past this point
+    block_smc_ = false;
+  }
+  return retired;
+}
+
+void Tile1::flush_blocks() {
+  blocks_.clear();
+  block_code_words_.clear();
+  block_code_lo_ = 0xffffffffu;
+  block_code_hi_ = 0;
+  jit_code_.clear();       // native bodies went with their blocks
+  jit_region_ = JitRegion{};
+}
@@ -0,0 +1,107 @@
+// **********************************************************************
+// smile/src/Tile1_dispatch.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+Compile-time dispatch tables for Tile1, indexed by the ExecOp that DecodeCache
+resolved once per instruction word (so the opcode/funct3/funct7 ladder is
+already off the per-instruction path).
+- kExecTable: one handler per is_compute_op() op (ALU, M, LUI/AUIPC, packed
+  SIMD) doing its counter increments and exec_* call; run_hart makes one
+  indirect call for these and keeps its switch only for ops with pc, memory,
+  trap or accelerator effects.
+- kBlockTable: the basic-block engine's per-instruction handlers (compute ops
+  plus ideal loads/stores), with the retire bookkeeping the switch path does.
+Both are built by pack expansion over every ExecOp value, so adding an op to
+is_compute_op() or the enum updates them without a hand-kept case list.
+*/
+#include "Tile1.hpp"
+#include "Tile1_exec.hpp"
+
+// Counters + execution of one compute op (op fixed at compile time, switches fold away)
+template <ExecOp Op>
+void Tile1::exec_op(Tile1& tile, const Instruction& d, uint32_t pc) {
+  if constexpr (Op >= ExecOp::PADD_B && Op <= ExecOp::PSADDU_H) {
+    tile.simd_count_++;
+    exec_simd(tile, d, Op);
+    return;
+  }
+  tile.arith_count_++;
+  switch (Op) {
+    case ExecOp::ADD:    tile.add_count_++; exec_add(tile, d); break;
+    case ExecOp::SUB:    tile.add_count_++; exec_sub(tile, d); break; // count subs as adds
+    case ExecOp::SLL:    exec_sll(tile, d);    break;
+    case ExecOp::SLT:    exec_slt(tile, d);    break;
+    case ExecOp::SLTU:   exec_sltu(tile, d);   break;
+    case ExecOp::XOR:    exec_xor(tile, d);    break;
+    case ExecOp::SRL:    exec_srl(tile, d);    break;
+    case ExecOp::SRA:    exec_sra(tile, d);    break;
+    case ExecOp::OR:     exec_or(tile, d);     break;
+    case ExecOp::AND:    exec_and(tile, d);    break;
+    case ExecOp::MUL:    tile.mul_count_++; exec_mul(tile, d); break;
+    case ExecOp::MULH:   exec_mulh(tile, d);   break;
+    case ExecOp::MULHSU: exec_mulhsu(tile, d); break;
+    case ExecOp::MULHU:  exec_mulhu(tile, d);  break;
+    case ExecOp::DIV:    exec_div(tile, d);    break;
+    case ExecOp::DIVU:   exec_divu(tile, d);   break;
+    case ExecOp::REM:    exec_rem(tile, d);    break;
+    case ExecOp::REMU:   exec_remu(tile, d);   break;
+    case ExecOp::MULW:   exec_mulw(tile, d);   break;
+    case ExecOp::ADDI:   exec_addi(tile, d);   break;
+    case ExecOp::SLLI:   exec_slli(tile, d);   break;
+    case ExecOp::SLTI:   exec_slti(tile, d);   break;
+    case ExecOp::SLTIU:  exec_sltiu(tile, d);  break;
+    case ExecOp::XORI:   exec_xori(tile, d);   break;
+    case ExecOp::SRLI:   exec_srli(tile, d);   break;
+    case ExecOp::SRAI:   exec_srai(tile, d);   break;
+    case ExecOp::ORI:    exec_ori(tile, d);    break;
+    case ExecOp::ANDI:   exec_andi(tile, d);   break;
+    case ExecOp::LUI:    exec_lui(tile, d);    break;
+    case ExecOp::AUIPC:  exec_auipc(tile, d, pc); break;
+    default: break;
+  }
+}
+
+// One block body instruction: the retire bookkeeping of run_hart, then the op itself
+template <ExecOp Op>
+void Tile1::block_op(Tile1& tile, const BlockInsn& bi) {
+  const Instruction& d = bi.instr;
+  tile.inst_count_++;
+  if (tile.profile_) tile.profile_->retire(bi.pc);
+  if (tile.trace_out_) tile.trace_retire(bi.pc, Op, d);
+  if constexpr (Op >= ExecOp::LB && Op <= ExecOp::LHU) {
+    tile.load_count_++;
+    tile.load_ideal(d);
+  } else if constexpr (Op >= ExecOp::SB && Op <= ExecOp::SW) {
+    tile.store_count_++;
+    tile.store_ideal(d);
+  } else {
+    exec_op<Op>(tile, d, bi.pc);
+  }
+}
+
+// Table entries; ops without a handler are never instantiated
+template <ExecOp Op>
+constexpr Tile1::ExecHandler Tile1::exec_entry() {
+  if constexpr (is_compute_op(Op)) return &exec_op<Op>;
+  else return nullptr;
+}
+
+template <ExecOp Op>
+constexpr Tile1::BlockHandler Tile1::block_entry() {
+  if constexpr (is_compute_op(Op) || (Op >= ExecOp::LB && Op <= ExecOp::SW)) return &block_op<Op>;
+  else return nullptr; // branch/jump/CUSTOM-0/SYSTEM/CSR/unknown end the block
+}
+
+template <size_t... I>
+constexpr std::array<Tile1::ExecHandler, sizeof...(I)> Tile1::make_exec_table(std::index_sequence<I...>) {
+  return {{exec_entry<static_cast<ExecOp>(I)>()...}};
+}
+
+template <size_t... I>
+constexpr std::array<Tile1::BlockHandler, sizeof...(I)> Tile1::make_block_table(std::index_sequence<I...>) {
+  return {{block_entry<static_cast<ExecOp>(I)>()...}};
+}
+
+constexpr std::array<Tile1::ExecHandler, kNumExecOps>  Tile1::kExecTable  = make_exec_table(std::make_index_sequence<kNumExecOps>{});
+constexpr std::array<Tile1::BlockHandler, kNumExecOps> Tile1::kBlockTable = make_block_table(std::make_index_sequence<kNumExecOps>{});
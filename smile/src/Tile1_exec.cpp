@@ -11,6 +11,128 @@ How to execute RISC-V commands.
 #include "AccelPort.hpp"
 #include <cstdint>
 
+// Resolve the handler once per instruction word; same selection the original tick() ladder made.
+ExecOp resolve_exec_op(const Instruction& instr) {
+  using Cat = Instruction::Category;
+  using Ty  = Instruction::Type;
+  switch (instr.category) {
+    case Cat::ALU:
+      if (instr.type == Ty::I) {
+        if (instr.opcode != 0x13) return ExecOp::ADDI;
+        switch (instr.funct3) {
+          case 0x1: return ExecOp::SLLI;
+          case 0x2: return ExecOp::SLTI;
+          case 0x3: return ExecOp::SLTIU;
+          case 0x4: return ExecOp::XORI;
+          case 0x5:
+            if (instr.funct7 == 0x00) return ExecOp::SRLI;
+            if (instr.funct7 == 0x20) return ExecOp::SRAI;
+            return ExecOp::ADDI;
+          case 0x6: return ExecOp::ORI;
+          case 0x7: return ExecOp::ANDI;
+          default:  return ExecOp::ADDI;
+        }
+      }
+      if (instr.type == Ty::R) {
+        if (instr.opcode == 0x3b) {
+          return (instr.funct3 == 0x0 && instr.funct7 == 0x01) ? ExecOp::MULW : ExecOp::ADD;
+        }
+        if (instr.opcode != 0x33) return ExecOp::ADD;
+        const bool base = instr.funct7 == 0x00;
+        const bool alt  = instr.funct7 == 0x20;
+        const bool mext = instr.funct7 == 0x01;
+        switch (instr.funct3) {
+          case 0x0: return base ? ExecOp::ADD : alt ? ExecOp::SUB : mext ? ExecOp::MUL : ExecOp::ADD;
+          case 0x1: return base ? ExecOp::SLL  : mext ? ExecOp::MULH   : ExecOp::ADD;
+          case 0x2: return base ? ExecOp::SLT  : mext ? ExecOp::MULHSU : ExecOp::ADD;
+          case 0x3: return base ? ExecOp::SLTU : mext ? ExecOp::MULHU  : ExecOp::ADD;
+          case 0x4: return base ? ExecOp::XOR  : mext ? ExecOp::DIV    : ExecOp::ADD;
+          case 0x5: return base ? ExecOp::SRL : alt ? ExecOp::SRA : mext ? ExecOp::DIVU : ExecOp::ADD;
+          case 0x6: return base ? ExecOp::OR   : mext ? ExecOp::REM    : ExecOp::ADD;
+          case 0x7: return base ? ExecOp::AND  : mext ? ExecOp::REMU   : ExecOp::ADD;
+          default:  return ExecOp::ADD;
+        }
+      }
+      if (instr.type == Ty::U) {
+        if (instr.opcode == 0x37) return ExecOp::LUI;
+        if (instr.opcode == 0x17) return ExecOp::AUIPC;
+      }
+      return ExecOp::Unknown;
+    case Cat::SYSTEM:
+      if (instr.type != Ty::I) return ExecOp::Unknown;
+      if (instr.opcode == 0x73) {
+        switch (instr.i.imm) {
+          case 0x000: return ExecOp::ECALL;
+          case 0x001: return ExecOp::EBREAK;
+          case 0x002: return ExecOp::URET;
+          case 0x102: return ExecOp::SRET;
+          case 0x302: return ExecOp::MRET;
+          default:    return ExecOp::SYSTEM_NOP;
+        }
+      }
+      if (instr.opcode == 0x0f) {
+        if (instr.funct3 == 0x0) return ExecOp::FENCE;
+        if (instr.funct3 == 0x1) return ExecOp::FENCE_I;
+      }
+      return ExecOp::Unknown;
+    case Cat::LOAD:
+      if (instr.type != Ty::I) return ExecOp::Unknown;
+      switch (instr.funct3) {
+        case 0x0: return ExecOp::LB;
+        case 0x1: return ExecOp::LH;
+        case 0x2: return ExecOp::LW;
+        case 0x4: return ExecOp::LBU;
+        case 0x5: return ExecOp::LHU;
+        default:  return ExecOp::Unknown;
+      }
+    case Cat::STORE:
+      if (instr.type != Ty::S) return ExecOp::Unknown;
+      switch (instr.funct3) {
+        case 0x0: return ExecOp::SB;
+        case 0x1: return ExecOp::SH;
+        case 0x2: return ExecOp::SW;
+        default:  return ExecOp::Unknown;
+      }
+    case Cat::BRANCH:
+      if (instr.type != Ty::B) return ExecOp::Unknown;
+      switch (instr.funct3) {
+        case 0x0: return ExecOp::BEQ;
+        case 0x1: return ExecOp::BNE;
+        case 0x4: return ExecOp::BLT;
+        case 0x5: return ExecOp::BGE;
+        case 0x6: return ExecOp::BLTU;
+        case 0x7: return ExecOp::BGEU;
+        default:  return ExecOp::Unknown;
+      }
+    case Cat::JUMP:
+      if (instr.type == Ty::J) return ExecOp::JAL;
+      if (instr.type == Ty::I) return ExecOp::JALR;
+      return ExecOp::Unknown;
+    case Cat::CSR:
+      if (instr.type != Ty::CSR) return ExecOp::Unknown;
+      switch (instr.funct3) {
+        case 0x1: return ExecOp::CSRRW;
+        case 0x2: return ExecOp::CSRRS;
+        case 0x3: return ExecOp::CSRRC;
+        default:  return ExecOp::Unknown;
+      }
+    case Cat::CSR_IMM:
+      if (instr.type != Ty::CSR) return ExecOp::Unknown;
+      switch (instr.funct3) {
+        case 0x5: return ExecOp::CSRRWI;
+        case 0x6: return ExecOp::CSRRSI;
+        case 0x7: return ExecOp::CSRRCI;
+        default:  return ExecOp::Unknown;
+      }
+    case Cat::CUSTOM:
+      return ExecOp::CUSTOM0;
+    case Cat::SIMD: // decoder only lets funct3 0/1 and funct7 0..10 through
+      return static_cast<ExecOp>(static_cast<uint8_t>(instr.funct3 == 0x0 ? ExecOp::PADD_B : ExecOp::PADD_H) + instr.funct7);
+    default:
+      return ExecOp::Unknown;
+  }
+}
+
 // RV32I base - R-type
 void exec_add(Tile1& tile, const Instruction& instr) {
   const auto& op = instr.r; // alias for R-type decoded fields
@@ -325,8 +447,9 @@ void exec_fence(Tile1& /*tile*/, const Instruction& /*instr*/) {
   // No-op in this single-core, in-order Tile1 model.
 }
 
-void exec_fence_i(Tile1& /*tile*/, const Instruction& /*instr*/) {
-  // No-op in this single-core, in-order Tile1 model.
+void exec_fence_i(Tile1& tile, const Instruction& /*instr*/) {
+  // Instruction stream sync: drop predecoded entries so modified code is re-decoded.
+  tile.flush_decode_cache();
 }
 
 // M extension
@@ -452,6 +575,47 @@ void exec_custom0(Tile1& tile, const Instruction& instr) {
   tile.accel_next_pc_ = tile.pc() + 4u;
 }
 
-void exec_custom1(Tile1& tile, const Instruction& /*instr*/) { // stubbed to trap for now
-  tile.request_illegal_instruction();
+// Packed SIMD
+namespace {
+// One lane: a/b hold the lane's bits zero-extended, Bits is the lane width
+template <unsigned Bits>
+uint32_t simd_lane(unsigned fn, uint32_t a, uint32_t b) {
+  constexpr uint32_t mask  = (1u << Bits) - 1u;
+  constexpr int32_t  s_max = static_cast<int32_t>(mask >> 1), s_min = -s_max - 1;
+  const int32_t sa = static_cast<int32_t>(a << (32u - Bits)) >> (32u - Bits); // sign-extended lanes
+  const int32_t sb = static_cast<int32_t>(b << (32u - Bits)) >> (32u - Bits);
+  switch (fn) { // funct7
+    case 0:  return a + b;
+    case 1:  return a - b;
+    case 2:  return static_cast<uint32_t>(sa < sb ? sa : sb);
+    case 3:  return static_cast<uint32_t>(sa > sb ? sa : sb);
+    case 4:  return a < b ? a : b;
+    case 5:  return a > b ? a : b;
+    case 6:  return a == b ? mask : 0u;
+    case 7:  return sa < sb ? mask : 0u;
+    case 8:  return a < b ? mask : 0u;
+    case 9:  { const int32_t r = sa + sb; return static_cast<uint32_t>(r > s_max ? s_max : r < s_min ? s_min : r); }
+    default: { const uint32_t r = a + b; return r > mask ? mask : r; }
+  }
+}
+
+template <unsigned Bits>
+uint32_t simd_word(unsigned fn, uint32_t a, uint32_t b) {
+  constexpr uint32_t mask = (1u << Bits) - 1u;
+  uint32_t result = 0;
+  for (unsigned sh = 0; sh < 32u; sh += Bits) {
+    result |= (simd_lane<Bits>(fn, (a >> sh) & mask, (b >> sh) & mask) & mask) << sh;
+  }
+  return result;
+}
+} // namespace
+
+uint32_t simd_lanes(ExecOp op, uint32_t a, uint32_t b) {
+  const unsigned k = static_cast<unsigned>(op) - static_cast<unsigned>(ExecOp::PADD_B);
+  return k < 11u ? simd_word<8>(k, a, b) : simd_word<16>(k - 11u, a, b);
+}
+
+void exec_simd(Tile1& tile, const Instruction& instr, ExecOp op) {
+  const auto& r = instr.r;
+  tile.write_reg(r.rd, simd_lanes(op, tile.read_reg(r.rs1), tile.read_reg(r.rs2)));
 }
@@ -0,0 +1,308 @@
+// **********************************************************************
+// smile/src/Tile1_jit.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+JIT tier for Tile1 (-jit, ideal mem, x86-64 hosts).  Sits on top of the
+basic-block engine: once a block body has been dispatched jit_threshold times
+it is translated into native code and run from then on.  The terminator
+(branch, jump, CUSTOM-0, SYSTEM, CSR) still goes through the interpreter, so
+traps, the accelerator and PC redirects are untouched.
+
+Native code keeps no RISC-V state in host registers:
+- rbx = &regs_[0], every source is read from and every rd written back to it
+  (x0 is never written);
+- r12 = jit_region_, the last data page granted by get_direct(): loads that land
+  in it read host memory inline, anything else (other page, misaligned,
+  refused region) calls jit_load_slow, which runs load_ideal and refills it;
+- r13 = the tile, for helper calls.  Stores always call jit_store (store_ideal),
+  so decode-cache invalidation and self-modifying-code detection are exactly
+  the interpreter's; a store that hits block code ends the body early.
+DIV/REM and packed SIMD call their block handler.  Counters of the inline
+instructions are added per run from Block::jit_counts, so [STATS] and
+inst_count_ match the interpreter.  -jit_check runs every native body, rolls
+registers, counters and stored words back, reruns it on the interpreter and
+asserts both agree.
+*/
+#include "Tile1.hpp"
+#include "Tile1_exec.hpp"
+#include "AccelPort.hpp"
+#include <cstdio>
+
+namespace {
+constexpr size_t kJitCodeBytes = 16u << 20; // a full 256-instruction body needs well under 32 KB
+using X = JitX64;
+} // namespace
+
+void Tile1::set_jit(bool on, uint32_t threshold, bool check) {
+  if (on) {
+    assert_always(jit_supported(), "-jit needs an x86-64 host");
+    assert_always(jit_code_.reserve(kJitCodeBytes), "JIT: cannot map the code buffer");
+  }
+  jit_on_        = on;
+  jit_check_     = on && check;
+  jit_threshold_ = threshold ? threshold : 1u;
+  flush_blocks();
+}
+
+bool Tile1::jit_native(ExecOp op) {
+  return (op >= ExecOp::ADD && op <= ExecOp::MULHU) || op == ExecOp::MULW ||
+         (op >= ExecOp::ADDI && op <= ExecOp::SW);
+}
+
+// Same increments exec_op/block_op make, for the instructions translated inline
+void Tile1::jit_count(const BlockInsn* body, size_t n, JitCounts* out) {
+  *out = JitCounts{};
+  for (size_t k = 0; k < n; ++k) {
+    const ExecOp op = resolve_exec_op(body[k].instr);
+    if (!jit_native(op)) continue; // its handler counts itself
+    out->inst++;
+    if (op >= ExecOp::LB && op <= ExecOp::LHU)      out->load++;
+    else if (op >= ExecOp::SB && op <= ExecOp::SW)  out->store++;
+    else {
+      out->arith++;
+      if (op == ExecOp::ADD || op == ExecOp::SUB) out->add++;
+      if (op == ExecOp::MUL) out->mul++;
+    }
+  }
+}
+
+bool Tile1::jit_translate(Block& blk) {
+  X& x = jit_code_;
+  const auto reg = [](uint32_t r) { return static_cast<int32_t>(4u * r); };
+  const auto call = [&x](const void* fn, const BlockInsn& bi) { // fn(tile, &bi); clobbers caller-saved regs
+    x.mov_r64_r64(X::RDI, X::R13);
+    x.mov_r64_imm(X::RSI, reinterpret_cast<uintptr_t>(&bi));
+    x.mov_r64_imm(X::RAX, reinterpret_cast<uintptr_t>(fn));
+    x.call_r64(X::RAX);
+  };
+  const auto leave = [&x](uint32_t retired) {
+    x.mov_r32_imm(X::RAX, retired);
+    x.pop(X::R13);
+    x.pop(X::R12);
+    x.pop(X::RBX);
+    x.ret();
+  };
+
+  x.begin();
+  x.push(X::RBX); // three pushes keep rsp 16-byte aligned for the helper calls
+  x.push(X::R12);
+  x.push(X::R13);
+  x.mov_r64_r64(X::R13, X::RDI);
+  x.mov_r64_r64(X::RBX, X::RSI);
+  x.mov_r64_r64(X::R12, X::RDX);
+  std::vector<std::pair<size_t, uint32_t>> exits; // (jnz to patch, insts retired when taken)
+
+  for (size_t k = 0; k < blk.body.size(); ++k) {
+    const BlockInsn& bi = blk.body[k];
+    const Instruction& d = bi.instr;
+    const ExecOp op = resolve_exec_op(d);
+    const uint32_t rd = (d.raw >> 7) & 0x1fu; // R/I/U-type rd field
+    if (jit_native(op) && !(op >= ExecOp::LB && op <= ExecOp::SW) && rd == 0) continue; // writes x0 only
+    switch (op) {
+      case ExecOp::ADD: case ExecOp::SUB: case ExecOp::XOR: case ExecOp::OR: case ExecOp::AND: {
+        const X::Alu alu = op == ExecOp::ADD ? X::ADD : op == ExecOp::SUB ? X::SUB :
+                           op == ExecOp::XOR ? X::XOR : op == ExecOp::OR  ? X::OR  : X::AND;
+        x.mov_r32_m(X::RAX, X::RBX, reg(d.r.rs1));
+        x.alu_r32_m(alu, X::RAX, X::RBX, reg(d.r.rs2));
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      }
+      case ExecOp::SLL: case ExecOp::SRL: case ExecOp::SRA:
+        x.mov_r32_m(X::RAX, X::RBX, reg(d.r.rs1));
+        x.mov_r32_m(X::RCX, X::RBX, reg(d.r.rs2));
+        x.shift_r32_cl(op == ExecOp::SLL ? X::SHL : op == ExecOp::SRL ? X::SHR : X::SAR, X::RAX); // x86 masks cl to 5 bits too
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      case ExecOp::SLT: case ExecOp::SLTU:
+        x.mov_r32_m(X::RCX, X::RBX, reg(d.r.rs1));
+        x.alu_r32_m(X::CMP, X::RCX, X::RBX, reg(d.r.rs2));
+        x.setcc_zx(op == ExecOp::SLT ? X::L : X::B, X::RAX);
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      case ExecOp::MUL: case ExecOp::MULW:
+        x.mov_r32_m(X::RAX, X::RBX, reg(d.r.rs1));
+        x.imul_r32_m(X::RAX, X::RBX, reg(d.r.rs2));
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      case ExecOp::MULH: case ExecOp::MULHSU: case ExecOp::MULHU: // 64-bit product, keep the high word
+        if (op == ExecOp::MULHU) x.mov_r32_m(X::RAX, X::RBX, reg(d.r.rs1));
+        else                     x.movsxd_r64_m(X::RAX, X::RBX, reg(d.r.rs1));
+        if (op == ExecOp::MULH)  x.movsxd_r64_m(X::RCX, X::RBX, reg(d.r.rs2));
+        else                     x.mov_r32_m(X::RCX, X::RBX, reg(d.r.rs2));
+        x.imul_r64_r64(X::RAX, X::RCX);
+        x.shift_r64_imm(X::SHR, X::RAX, 32);
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      case ExecOp::ADDI: case ExecOp::XORI: case ExecOp::ORI: case ExecOp::ANDI: {
+        const X::Alu alu = op == ExecOp::ADDI ? X::ADD : op == ExecOp::XORI ? X::XOR :
+                           op == ExecOp::ORI  ? X::OR  : X::AND;
+        x.mov_r32_m(X::RAX, X::RBX, reg(d.i.rs1));
+        x.alu_r32_imm(alu, X::RAX, d.i.imm);
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      }
+      case ExecOp::SLTI: case ExecOp::SLTIU:
+        x.mov_r32_m(X::RCX, X::RBX, reg(d.i.rs1));
+        x.alu_r32_imm(X::CMP, X::RCX, d.i.imm);
+        x.setcc_zx(op == ExecOp::SLTI ? X::L : X::B, X::RAX);
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      case ExecOp::SLLI: case ExecOp::SRLI: case ExecOp::SRAI:
+        x.mov_r32_m(X::RAX, X::RBX, reg(d.i.rs1));
+        x.shift_r32_imm(op == ExecOp::SLLI ? X::SHL : op == ExecOp::SRLI ? X::SHR : X::SAR, X::RAX,
+                        static_cast<uint8_t>(static_cast<uint32_t>(d.i.imm) & 0x1fu));
+        x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        break;
+      case ExecOp::LUI:
+        x.mov_m_imm32(X::RBX, reg(rd), static_cast<uint32_t>(d.u.imm));
+        break;
+      case ExecOp::AUIPC:
+        x.mov_m_imm32(X::RBX, reg(rd), bi.pc + static_cast<uint32_t>(d.u.imm));
+        break;
+      case ExecOp::LB: case ExecOp::LH: case ExecOp::LW: case ExecOp::LBU: case ExecOp::LHU: {
+        x.mov_r32_m(X::RAX, X::RBX, reg(d.i.rs1));
+        x.alu_r32_imm(X::ADD, X::RAX, d.i.imm);  // eax = addr
+        x.mov_r32_r32(X::RDX, X::RAX);
+        x.alu_r32_m(X::SUB, X::RDX, X::R12, 8);  // edx = addr - region.lo
+        x.mov_r32_r32(X::RCX, X::RDX);
+        x.alu_r32_imm(X::AND, X::RCX, -4);
+        x.alu_r32_m(X::CMP, X::RCX, X::R12, 12); // word outside the region?
+        std::vector<size_t> slow{x.jcc(X::AE)};
+        if (op == ExecOp::LH || op == ExecOp::LHU || op == ExecOp::LW) { // misaligned: load_ideal asserts
+          x.test_r32_imm(X::RAX, op == ExecOp::LW ? 3u : 1u);
+          slow.push_back(x.jcc(X::NE));
+        }
+        x.mov_r64_m(X::RSI, X::R12, 0);          // region.host
+        switch (op) {
+          case ExecOp::LB:  x.load_idx(X::MOVSX8,  X::RAX, X::RSI, X::RDX); break;
+          case ExecOp::LH:  x.load_idx(X::MOVSX16, X::RAX, X::RSI, X::RDX); break;
+          case ExecOp::LBU: x.load_idx(X::MOVZX8,  X::RAX, X::RSI, X::RDX); break;
+          case ExecOp::LHU: x.load_idx(X::MOVZX16, X::RAX, X::RSI, X::RDX); break;
+          default:          x.load32_idx(X::RAX, X::RSI, X::RDX);           break;
+        }
+        if (rd != 0) x.mov_m_r32(X::RBX, reg(rd), X::RAX);
+        const size_t done = x.jmp();
+        for (size_t at : slow) x.patch_rel32(at, x.pos());
+        call(reinterpret_cast<const void*>(&Tile1::jit_load_slow), bi);
+        x.patch_rel32(done, x.pos());
+        break;
+      }
+      case ExecOp::SB: case ExecOp::SH: case ExecOp::SW:
+        call(reinterpret_cast<const void*>(&Tile1::jit_store), bi);
+        x.test_r32_imm(X::RAX, 0xffffffffu);
+        exits.emplace_back(x.jcc(X::NE), static_cast<uint32_t>(k + 1));
+        break;
+      default: // DIV/REM, packed SIMD: the block handler (counts itself)
+        call(reinterpret_cast<const void*>(bi.fn), bi);
+        break;
+    }
+  }
+  leave(static_cast<uint32_t>(blk.body.size()));
+  for (const auto& e : exits) {
+    x.patch_rel32(e.first, x.pos());
+    leave(e.second);
+  }
+
+  void* entry = x.finish();
+  if (!entry) return false;
+  blk.jit = reinterpret_cast<JitFn>(entry);
+  jit_count(blk.body.data(), blk.body.size(), &blk.jit_counts);
+  jit_blocks_++;
+  return true;
+}
+
+uint32_t Tile1::jit_dispatch(Block& blk) {
+  if (profile_ || trace_out_) return 0; // per-instruction hooks: interpret
+  if (!blk.jit) {
+    if (++blk.execs < jit_threshold_) return 0;
+    if (!jit_translate(blk)) { // buffer full: drop every native body and start over
+      for (auto& kv : blocks_) kv.second.jit = nullptr;
+      jit_code_.clear();
+      jit_flushes_++;
+      assert_always(jit_translate(blk), "JIT: block body does not fit the code buffer");
+    }
+  }
+  uint32_t retired = 0;
+  if (jit_check_) {
+    retired = jit_run_checked(blk);
+  } else {
+    retired = blk.jit(this, regs_.data(), &jit_region_);
+    JitCounts c = blk.jit_counts;
+    if (retired != blk.body.size()) jit_count(blk.body.data(), retired, &c); // left early (patched code)
+    inst_count_  += c.inst;
+    arith_count_ += c.arith;
+    add_count_   += c.add;
+    mul_count_   += c.mul;
+    load_count_  += c.load;
+    store_count_ += c.store;
+  }
+  jit_dispatches_++;
+  jit_insts_ += retired;
+  return retired;
+}
+
+uint32_t Tile1::jit_run_checked(Block& blk) {
+  const std::array<uint32_t, 32> regs0 = regs_;
+  const uint64_t saved[] = {inst_count_, arith_count_, add_count_, mul_count_, simd_count_, load_count_, store_count_};
+
+  jit_undo_.clear();
+  jit_undo_on_ = true;
+  const uint32_t n_jit = blk.jit(this, regs_.data(), &jit_region_);
+  jit_undo_on_ = false;
+  const std::array<uint32_t, 32> regs_jit = regs_;
+  std::vector<std::pair<uint32_t, uint32_t>> mem_jit;
+  for (const auto& u : jit_undo_) mem_jit.emplace_back(u.first, mem_direct_.read32(u.first));
+
+  for (auto it = jit_undo_.rbegin(); it != jit_undo_.rend(); ++it) mem_direct_.write32(it->first, it->second);
+  regs_ = regs0;
+  inst_count_ = saved[0]; arith_count_ = saved[1]; add_count_ = saved[2]; mul_count_ = saved[3];
+  simd_count_ = saved[4]; load_count_ = saved[5]; store_count_ = saved[6];
+  block_smc_ = false;
+
+  uint32_t n_ref = 0; // reference: the block engine's interpreter loop (counters come from here)
+  for (const BlockInsn& bi : blk.body) {
+    bi.fn(*this, bi);
+    ++n_ref;
+    if (block_smc_) break;
+  }
+
+  const uint32_t pc = blk.body.front().pc;
+  bool ok = n_jit == n_ref;
+  if (!ok) printf("[JIT] mismatch in block 0x%08x: retired jit=%u interp=%u\n", pc, n_jit, n_ref);
+  for (uint32_t r = 1; r < 32; ++r) {
+    if (regs_jit[r] == regs_[r]) continue;
+    printf("[JIT] mismatch in block 0x%08x: x%u jit=0x%08x interp=0x%08x\n", pc, r, regs_jit[r], regs_[r]);
+    ok = false;
+  }
+  for (const auto& m : mem_jit) {
+    const uint32_t ref = mem_direct_.read32(m.first);
+    if (m.second == ref) continue;
+    printf("[JIT] mismatch in block 0x%08x: mem[0x%08x] jit=0x%08x interp=0x%08x\n", pc, m.first, m.second, ref);
+    ok = false;
+  }
+  if (!ok) fflush(stdout);
+  assert_always(ok, "JIT result differs from the interpreter");
+  return n_ref;
+}
+
+uint32_t Tile1::jit_load_slow(Tile1* tile, const BlockInsn* bi) {
+  const Instruction& d = bi->instr;
+  const uint32_t aligned = static_cast<uint32_t>(static_cast<int32_t>(tile->read_reg(d.i.rs1)) + d.i.imm) & ~0x3u;
+  tile->load_ideal(d); // rd may be rs1: address taken first
+  smem::DirectRegion r;
+  if (tile->mem_port_->get_direct(aligned, &r) && r.host && r.covers(aligned, 4u)) {
+    tile->jit_region_ = JitRegion{r.host, r.lo, r.hi - r.lo - 2u}; // last aligned offset is hi - lo - 3
+  }
+  return 0;
+}
+
+uint32_t Tile1::jit_store(Tile1* tile, const BlockInsn* bi) {
+  if (tile->jit_undo_on_) {
+    const Instruction& d = bi->instr;
+    const uint32_t aligned = static_cast<uint32_t>(static_cast<int32_t>(tile->read_reg(d.s.rs1)) + d.s.imm) & ~0x3u;
+    tile->jit_undo_.emplace_back(aligned, tile->mem_direct_.read32(aligned));
+  }
+  tile->store_ideal(bi->instr);
+  return tile->block_smc_ ? 1u : 0u;
+}
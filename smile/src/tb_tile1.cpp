@@ -11,26 +11,43 @@ Testbench for a RV tile.
 #include "Tile1.hpp"
 #include "Debugger.hpp"
 #include "Diagnostics.hpp"
+#include "Sampler.hpp"
+#include "PcProfile.hpp"
+#include "CpiSeries.hpp"
+#include "ProfileReport.hpp"
 #include "util/FlatBinLoader.hpp"
+#include "util/Checkpoint.hpp"
+#include "util/ElfSymbols.hpp"
 #include "smem/MemCtrlTimedPort.hpp"
 #include "smem/Dram.hpp"
+#include "smem/MemCtrl.hpp"
+#include "smem/MemTrace.hpp"
+#include "smem/TraceReplay.hpp"
 #include "AccelPort.hpp"
 #include "AccelArraySum.hpp"
 #include "AccelArraySumMc.hpp"
 #include "AccelDemoAdd.hpp"
+#include "AccelQueue.hpp"
 #include "smem/DramMemoryPort.hpp"  // interface to DRAM
 
 #include <cascade/Clock.hpp>
 #include <cascade/SimDefs.hpp>
 #include <cascade/SimGlobals.hpp>
 
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <sstream>
 #include <string>
 #include <algorithm>
 #include <cctype>
 #include <memory>
 #include <vector>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 // **************
 // Parameters (CLI flags): name, default value, help text
 // **************
@@ -39,12 +56,55 @@ StringParameter(prog, "", "Path to flat binary file (.bin) to load");
 IntParameter(load_addr, 0x0, "Physical load address for the flat binary");
 IntParameter(start_pc, 0x0, "Initial PC (set core's PC before run)");
 IntParameter(mem_latency, 0, "Fixed memory latency (cycles) for MemCtrlTimedPort");
+StringParameter(dram_timing, "", "Bank/row-buffer DRAM timing behind the memory controller: on, or key=value,... (ch, rank, bank, row_bits, page, burst, policy=open|closed, map=row:bank:col, trcd, tcas, trp, tras, twr, tburst); empty = fixed -mem_latency only");
+IntParameter(dram_mb, 256, "DRAM window size in MB (sparse: host pages are allocated on first write)");
 BoolParameter(ideal_mem, false, "Use ideal memory model in Tile1 (sync read32/write32, no stalls)");
 StringParameter(mem_model, "timed", "Tile1 memory model: timed|ideal");
+IntParameter(fetch_line, 0, "Timed mem: instruction fetch line buffer in bytes (power of two, 4..64); 0 = one word request per instruction");
+BoolParameter(fetch_prefetch, true, "-fetch_line: prefetch the next sequential line while executing from the current one");
+IntParameter(nb_loads, 0, "Timed mem: loads in flight at once (non-blocking loads with a register scoreboard, 1..8); 0 = blocking loads");
+IntParameter(mem_outstanding, 0, "Requests MemCtrlTimedPort keeps in flight (1..16); 0 = 1, or -nb_loads + 1 (-hw_threads + 1) when those are on");
+IntParameter(accel_queue, 0, "Decoupled accelerator: commands in flight (1..16) behind an AccelQueue, CUSTOM-0 retires once queued; 0 = blocking v1");
+IntParameter(hw_threads, 1, "Hardware threads (harts) in Tile1, 1..8; each starts at the entry pc and reads its index from mhartid");
+StringParameter(bpred, "none", "Branch predictor: none (free branches) | btfn | bimodal | gshare; mispredicts cost -bpred_penalty bubbles");
+IntParameter(bpred_bits, 10, "-bpred bimodal/gshare: log2 of the 2-bit counter table (1..20)");
+IntParameter(bpred_penalty, 2, "-bpred: bubble cycles per mispredicted branch/jump");
+IntParameter(btb, 0, "-bpred: BTB entries (power of two); taken branches/jumps need a BTB hit. 0 = ideal targets");
+IntParameter(ras, 0, "-bpred: return-address stack depth (0..64); 0 = returns predicted via the BTB (or missed)");
+StringParameter(trace_out, "", "Record every retired instruction (pc, class, load/store address+size) to this compressed trace file");
+StringParameter(replay, "", "Replay this -trace_out file through MemCtrl -> Dram (-mem_latency) instead of running a core, then exit");
+IntParameter(replay_outstanding, 1, "-replay: requests in flight without a response (>= 1)");
+StringParameter(replay_sched, "fifo", "-replay: MemCtrl scheduler: fifo, or frfcfs[,depth=N][,accept=N][,wr_hi=N][,wr_lo=N][,turnaround=N]");
+BoolParameter(replay_wc, false, "-replay: MemCtrl write combining (merge posted stores to the same 64-byte block)");
+BoolParameter(replay_paced, false, "-replay: one trace record per cycle (1 IPC) instead of memory ops back to back");
+StringParameter(hw_switch, "stall", "-hw_threads: when to switch harts: stall (on a data/accelerator wait) | rr (round-robin every cycle)");
+IntParameter(sample_period, 0, "Sampled mode (timed mem, -steps>0): instructions per sampling unit; 0=off");
+IntParameter(sample_warmup, 2000, "Sampled mode: timed warm-up instructions before each measured window");
+IntParameter(sample_window, 1000, "Sampled mode: measured timed instructions per sampling unit");
+BoolParameter(block_exec, true, "Ideal mem only: retire straight-line basic blocks per tick during auto-run");
+BoolParameter(jit, false, "Ideal mem + -block_exec (x86-64 hosts): translate hot block bodies to native code");
+IntParameter(jit_threshold, 16, "-jit: dispatches before a block body is translated");
+BoolParameter(jit_check, false, "-jit: redo every native body on the interpreter and assert the results agree");
 StringParameter(accel, "array_sum", "Accelerator: none|demo_add|array_sum|array_sum_mc");
 StringParameter(suite, "proto_accel_sum", "Built-in suite when -prog is empty: proto_accel_sum|proto_accel_sum_altaddr|proto_accel_sum_badarg|proto_accel_sum_unsupported|proto_accel_sum_twice");
 BoolParameter(selfcheck, false, "Run regression matrix (accel/suite/mem_latency) and exit");
+StringParameter(sweep_progs, "", "Run a matrix over these comma-separated .bin files (x -sweep_accel x -sweep_lat) and exit");
+StringParameter(sweep_accel, "", "Sweep: comma-separated accelerator list (default: -accel)");
+StringParameter(sweep_lat, "", "Sweep: comma-separated mem_latency list (default: -mem_latency)");
+IntParameter(jobs, 1, "Selfcheck/sweep: parallel worker processes; 0 = one per online CPU");
+StringParameter(report, "", "Selfcheck/sweep: write per-case results to this file (.csv => CSV, otherwise JSON)");
 IntParameter(steps, 0, "Cycles to auto-run; <=0 enters interactive debugger");
+BoolParameter(bench, false, "Auto-run: print host wall time and simulated MIPS of the run ([BENCH])");
+StringParameter(checkpoint_at, "", "Auto-run: write a checkpoint at cycle N or on reaching pc:ADDR (e.g. pc:0x1a4), then keep running");
+StringParameter(checkpoint, "tile1.ckpt", "Checkpoint file written by -checkpoint_at");
+StringParameter(restore, "", "Start from this checkpoint instead of loading -prog or a suite");
+BoolParameter(profile, false, "Per-PC profile: print cycles per function and the hottest loops after the run");
+StringParameter(profile_elf, "", "-profile: ELF to take symbols from (default: -prog with .bin replaced by .elf)");
+StringParameter(profile_folded, "", "-profile: also write collapsed stacks (flame graph input) to this file");
+IntParameter(profile_loops, 5, "-profile: number of hot loops to list");
+IntParameter(profile_bytes, 0x10000, "-profile: code window size in bytes from -load_addr when the program size is unknown");
+IntParameter(cpi_interval, 0, "Write the CPI stack every N cycles as a CSV row to -cpi_csv; 0 = off");
+StringParameter(cpi_csv, "cpi.csv", "-cpi_interval: CSV file for the CPI stack time series");
 IntParameter(sw_threads, 1, "Software thread contexts to schedule (1 or 2). Default: 1");
 BoolParameter(ignore_bpfile, false,
   "Do not load .smile_dbg breakpoint file on startup");
@@ -76,6 +136,15 @@ static std::unique_ptr<AccelPort> make_accel_for_flag(const std::string& accel_f
   return nullptr;
 }
 
+// -accel_queue=<n>: put the accelerator behind a v2 (decoupled) command/response queue
+static AccelPort* decouple_accel(AccelPort* inner, std::unique_ptr<AccelQueue>* queue) {
+  assert_always(accel_queue >= 0 && accel_queue <= static_cast<int>(AccelQueue::kMaxDepth), "-accel_queue must be 0..16");
+  if (!inner || accel_queue == 0) return inner;
+  assert_always(sw_threads <= 1 && hw_threads <= 1, "-accel_queue needs -sw_threads=1 and -hw_threads=1");
+  *queue = std::make_unique<AccelQueue>(*inner, static_cast<uint32_t>(accel_queue));
+  return queue->get();
+}
+
 static bool inject_suite_program(smem::DramMemoryPort& dram_port,
                                  Tile1& tile,
                                  uint32_t load_addr_value,
@@ -207,35 +276,389 @@ static bool inject_suite_program(smem::DramMemoryPort& dram_port,
   return true;
 }
 
-static int run_one_case(const std::string& accel_flag,
-                        const std::string& suite_flag,
-                        int mem_lat,
-                        int steps_override) {
+// -dram_timing: false when off
+static bool dram_timing_config(smem::DramTiming::Config* cfg) {
+  const std::string spec = std::string(dram_timing);
+  if (spec.empty()) return false;
+  std::string err;
+  assert_always(smem::DramTiming::parse_config(spec, cfg, &err), err.c_str());
+  return true;
+}
+
+// Timed-model core/port options shared by the single run and matrix cases
+static void configure_timed(Tile1& tile, smem::MemCtrlTimedPort& memctrl) {
+  assert_always(nb_loads >= 0 && nb_loads <= static_cast<int>(Tile1::kMaxNbLoads), "-nb_loads must be 0..8");
+  assert_always(nb_loads == 0 || sw_threads <= 1, "-nb_loads needs -sw_threads=1");
+  assert_always(hw_threads <= 1 || (nb_loads == 0 && fetch_line == 0), "-hw_threads>1 does not combine with -nb_loads or -fetch_line");
+  const int outstanding = mem_outstanding > 0 ? static_cast<int>(mem_outstanding)
+                        : nb_loads > 0        ? static_cast<int>(nb_loads) + 1
+                        : hw_threads > 1      ? static_cast<int>(hw_threads) + 1 // one per hart plus the accelerator
+                                              : 1;
+  memctrl.set_max_outstanding(static_cast<uint32_t>(outstanding));
+  smem::DramTiming::Config dcfg;
+  if (dram_timing_config(&dcfg)) memctrl.set_dram_timing(dcfg);
+  tile.set_fetch_line(static_cast<uint32_t>(fetch_line), fetch_prefetch);
+  tile.set_nonblocking_loads(static_cast<uint32_t>(nb_loads));
+}
+
+// -jit/-jit_threshold/-jit_check: compile hot blocks (the tier only acts on ideal-mem block bodies)
+static void configure_jit(Tile1& tile) {
+  if (!jit) return;
+  assert_always(block_exec, "-jit needs -block_exec=1");
+  assert_always(jit_threshold >= 1, "-jit_threshold must be >= 1");
+  tile.set_jit(true, static_cast<uint32_t>(jit_threshold), jit_check);
+}
+
+// Hardware threads, after the memory model (and its port options) are in place
+static void configure_harts(Tile1& tile) {
+  assert_always(hw_threads >= 1 && hw_threads <= static_cast<int>(Tile1::kMaxHarts), "-hw_threads must be 1..8");
+  const std::string policy = to_lower_copy(std::string(hw_switch));
+  assert_always(policy == "stall" || policy == "rr", "-hw_switch must be 'stall' or 'rr'");
+  if (hw_threads > 1) {
+    assert_always(sw_threads <= 1, "-hw_threads>1 needs -sw_threads=1");
+    assert_always(std::string(checkpoint_at).empty() && std::string(restore).empty() && sample_period == 0,
+                  "-hw_threads>1 does not combine with checkpoints or sampling");
+  }
+  tile.set_hw_threads(static_cast<uint32_t>(hw_threads),
+                      policy == "rr" ? Tile1::HartSwitch::RoundRobin : Tile1::HartSwitch::OnStall);
+}
+
+// -bpred: the predictor outlives the tile's run (run_case/main own it); nullptr = off
+static std::unique_ptr<BranchPredictor> make_branch_predictor() {
+  const std::string scheme = to_lower_copy(std::string(bpred));
+  if (scheme == "none") {
+    assert_always(btb == 0 && ras == 0, "-btb/-ras need -bpred=btfn|bimodal|gshare");
+    return nullptr;
+  }
+  BranchPredictor::Config cfg;
+  assert_always(parse_bpred_scheme(scheme, &cfg.scheme), "-bpred must be 'none', 'btfn', 'bimodal' or 'gshare'");
+  assert_always(bpred_bits >= 1 && bpred_bits <= 20 && bpred_penalty >= 0 && btb >= 0 && ras >= 0,
+                "-bpred_bits must be 1..20, -bpred_penalty/-btb/-ras >= 0");
+  cfg.table_bits  = static_cast<uint32_t>(bpred_bits);
+  cfg.btb_entries = static_cast<uint32_t>(btb);
+  cfg.ras_depth   = static_cast<uint32_t>(ras);
+  cfg.penalty     = static_cast<uint32_t>(bpred_penalty);
+  return std::make_unique<BranchPredictor>(cfg);
+}
+
+// Host throughput of the auto-run (-bench): simulated instructions per wall-clock second
+static void report_bench(const Tile1& tile, double wall) {
+  const double mips = wall > 0.0 ? static_cast<double>(tile.inst_count()) / wall / 1e6 : 0.0;
+  printf("[BENCH] inst=%llu cycles=%llu wall=%.3fs mips=%.1f mode=%s\n",
+         (unsigned long long)tile.inst_count(), (unsigned long long)tile.cycle_count(), wall, mips,
+         tile.mem_model() != Tile1::MemModel::Ideal ? "timed" :
+         !tile.block_exec() ? "ideal" : (tile.jit() ? "ideal+jit" : "ideal+block"));
+}
+
+// -trace_out: finish the stream and report how well it packed
+static void report_trace(smem::MemTraceWriter& tw) {
+  tw.close();
+  printf("[TRACE] records=%llu mem=%llu raw_bytes=%llu file_bytes=%llu bits_per_record=%.2f\n",
+         (unsigned long long)tw.records(),
+         (unsigned long long)tw.mem_records(),
+         (unsigned long long)tw.raw_bytes(),
+         (unsigned long long)tw.file_bytes(),
+         tw.records() ? 8.0 * static_cast<double>(tw.file_bytes()) / static_cast<double>(tw.records()) : 0.0);
+}
+
+// -replay: drive MemCtrl -> Dram from a trace, no core; returns the process exit code
+static int run_replay(const std::string& path) {
+  assert_always(replay_outstanding >= 1, "-replay_outstanding must be >= 1");
+  smem::TraceReplay rp("replay");
+  smem::MemCtrl mc("memctrl");
+  smem::Dram dram("dram", 0);
+  assert_always(dram_mb > 0, "-dram_mb must be positive");
+  dram.set_size(static_cast<uint64_t>(dram_mb) << 20);
+  std::string err;
+  if (!rp.open(path, &err)) {
+    printf("[REPLAY] %s\n", err.c_str());
+    return 1;
+  }
+  rp.set_base(dram.get_base()); // trace addresses are tile addresses, i.e. DRAM offsets
+  rp.set_max_outstanding(static_cast<uint32_t>(replay_outstanding));
+  rp.set_paced(replay_paced);
+  mc.set_latency(static_cast<int>(mem_latency));
+  smem::DramTiming::Config dcfg;
+  if (dram_timing_config(&dcfg)) mc.set_dram_timing(dcfg);
+  smem::MemCtrl::SchedConfig scfg;
+  assert_always(smem::MemCtrl::parse_sched(std::string(replay_sched), &scfg, &err), err.c_str());
+  mc.set_scheduler(scfg);
+  mc.set_write_combining(replay_wc);
+
+  mc.in_core_req << rp.m_req;     // replay -> mem ctrl
+  rp.m_resp      << mc.out_core_resp;
+  dram.s_req     << mc.s_req;     // mem ctrl -> dram
+  mc.s_resp      << dram.s_resp;
+
+  Clock clk;
+  rp.clk << clk;
+  mc.clk << clk;
+  dram.clk << clk;
+  clk.generateClock();
+  Sim::init();
+  Sim::reset();
+
+  const auto t0 = std::chrono::steady_clock::now();
+  const uint64_t cap = steps > 0 ? static_cast<uint64_t>(steps) : 0; // 0 = until the trace is played
+  while (!rp.done() && (cap == 0 || rp.cycles() < cap)) Sim::run();
+  const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  printf("[REPLAY] %s records=%llu loads=%llu stores=%llu cycles=%llu latency=%d outstanding=%d paced=%d "
+         "load_lat_avg=%.2f load_lat_max=%llu blocked=%llu wall=%.3fs\n",
+         rp.done() ? "done" : "stopped",
+         (unsigned long long)rp.records(),
+         (unsigned long long)rp.loads(),
+         (unsigned long long)rp.stores(),
+         (unsigned long long)rp.cycles(),
+         static_cast<int>(mem_latency), static_cast<int>(replay_outstanding), replay_paced ? 1 : 0,
+         rp.loads() ? static_cast<double>(rp.load_lat_sum()) / static_cast<double>(rp.loads()) : 0.0,
+         (unsigned long long)rp.load_lat_max(),
+         (unsigned long long)rp.blocked(),
+         wall);
+  mc.print_sched_stats();
+  mc.print_store_stats();
+  if (const smem::DramTiming* dt = mc.dram_timing()) dt->print_stats(rp.cycles());
+  return rp.done() ? 0 : 1;
+}
+
+// CPI stack: cycles per retired instruction split by Tile1::CpiSlot (the slots add up to cpi=);
+// mem= is the share of cycles spent on memory (fetch, loads, stores, port slots)
+static void print_cpi_stack(const Tile1& tile) {
+  using Slot = Tile1::CpiSlot;
+  const double insts = tile.inst_count() ? static_cast<double>(tile.inst_count()) : 1.0;
+  printf("[CPI] cpi=%.3f", static_cast<double>(tile.cycle_count()) / insts);
+  for (size_t i = 0; i < Tile1::kCpiSlots; ++i) {
+    const Slot s = static_cast<Slot>(i);
+    printf(" %s=%.3f", Tile1::cpi_slot_name(s), static_cast<double>(tile.cpi_cycles(s)) / insts);
+  }
+  const uint64_t mem = tile.cpi_cycles(Slot::Fetch) + tile.cpi_cycles(Slot::Load) + tile.cpi_cycles(Slot::Store) +
+                       tile.cpi_cycles(Slot::StoreRmw) + tile.cpi_cycles(Slot::LoadUse) + tile.cpi_cycles(Slot::PortBusy);
+  printf(" mem=%.1f%%\n", tile.cycle_count() ? 100.0 * static_cast<double>(mem) / static_cast<double>(tile.cycle_count()) : 0.0);
+}
+
+static void print_stats(const smile::DebuggerState& dbg, const Tile1& tile, const smem::Dram& dram) {
+  printf("[STATS] cycles=%llu inst=%llu alu=%llu add=%llu mul=%llu loads=%llu stores=%llu branches=%llu taken=%llu simd=%llu\n",
+         (unsigned long long)dbg.cycle,
+         (unsigned long long)tile.inst_count(),
+         (unsigned long long)tile.arith_count(),
+         (unsigned long long)tile.add_count(),
+         (unsigned long long)tile.mul_count(),
+         (unsigned long long)tile.load_count(),
+         (unsigned long long)tile.store_count(),
+         (unsigned long long)tile.branch_count(),
+         (unsigned long long)tile.branch_taken_count(),
+         (unsigned long long)tile.simd_count());
+  print_cpi_stack(tile);
+  printf("[DECODE] hits=%llu misses=%llu invalidates=%llu\n", // predecode cache effectiveness
+         (unsigned long long)tile.decode_hits(),
+         (unsigned long long)tile.decode_misses(),
+         (unsigned long long)tile.decode_invalidates());
+  if (const BranchPredictor* bp = tile.branch_predictor()) {
+    printf("[BPRED] scheme=%s branches=%llu mispredicts=%llu dir=%llu target=%llu jumps=%llu jump_misses=%llu"
+           " returns=%llu ras_misses=%llu btb_hits=%llu/%llu penalty_cycles=%llu\n",
+           bp->scheme_name(),
+           (unsigned long long)bp->branches(),
+           (unsigned long long)bp->branch_misses(),
+           (unsigned long long)bp->dir_misses(),
+           (unsigned long long)bp->target_misses(),
+           (unsigned long long)bp->jumps(),
+           (unsigned long long)bp->jump_misses(),
+           (unsigned long long)bp->returns(),
+           (unsigned long long)bp->ras_misses(),
+           (unsigned long long)bp->btb_hits(),
+           (unsigned long long)bp->btb_lookups(),
+           (unsigned long long)tile.bpred_penalty_cycles());
+  }
+  if (tile.fetch_line_bytes() != 0) {
+    printf("[FETCH] line=%u hits=%llu misses=%llu prefetches=%llu prefetch_hits=%llu\n",
+           tile.fetch_line_bytes(),
+           (unsigned long long)tile.fetch_line_hits(),
+           (unsigned long long)tile.fetch_line_misses(),
+           (unsigned long long)tile.fetch_prefetches(),
+           (unsigned long long)tile.fetch_prefetch_hits());
+  }
+  if (tile.nonblocking_loads() != 0) {
+    const uint64_t held  = tile.nb_use_stalls() + tile.nb_slot_stalls();
+    const uint64_t lat   = tile.nb_load_latency_cycles();
+    printf("[MLP] slots=%u loads=%llu latency_cycles=%llu use_stalls=%llu slot_stalls=%llu saved=%lld mlp=%.2f\n",
+           tile.nonblocking_loads(),
+           (unsigned long long)tile.nb_loads(),
+           (unsigned long long)lat,
+           (unsigned long long)tile.nb_use_stalls(),
+           (unsigned long long)tile.nb_slot_stalls(),
+           (long long)lat - (long long)held, // load stall cycles a blocking core would have spent, minus those still paid
+           tile.nb_busy_cycles() ? static_cast<double>(tile.nb_inflight_sum()) / static_cast<double>(tile.nb_busy_cycles()) : 0.0);
+  }
+  if (tile.accel_queued()) {
+    printf("[ACCQ] cmds=%llu full_stalls=%llu empty_stalls=%llu accel_stall=%llu\n",
+           (unsigned long long)tile.accel_cmds(),
+           (unsigned long long)tile.accel_full_stalls(),
+           (unsigned long long)tile.accel_empty_stalls(),
+           (unsigned long long)tile.accel_stall_cycles());
+  }
+  if (tile.hw_threads() > 1) {
+    for (uint32_t h = 0; h < tile.hw_threads(); ++h) {
+      const Tile1::HartStats& hs = tile.hart_stats(h);
+      printf("[HART] h=%u insts=%llu cycles=%llu switches_in=%llu\n", h,
+             (unsigned long long)hs.insts,
+             (unsigned long long)hs.cycles,
+             (unsigned long long)hs.switches_in);
+    }
+    printf("[HART] policy=%s switches=%llu\n",
+           tile.hart_switch() == Tile1::HartSwitch::RoundRobin ? "rr" : "stall",
+           (unsigned long long)tile.hart_switches());
+  }
+  if (tile.block_exec() && tile.mem_model() == Tile1::MemModel::Ideal) {
+    printf("[BLOCK] dispatches=%llu body_insts=%llu\n",
+           (unsigned long long)tile.block_dispatches(),
+           (unsigned long long)tile.block_insts());
+  }
+  if (tile.jit()) {
+    printf("[JIT] blocks=%llu dispatches=%llu insts=%llu code_bytes=%llu flushes=%llu%s\n",
+           (unsigned long long)tile.jit_blocks(),
+           (unsigned long long)tile.jit_dispatches(),
+           (unsigned long long)tile.jit_insts(),
+           (unsigned long long)tile.jit_code_bytes(),
+           (unsigned long long)tile.jit_flushes(),
+           tile.jit_check() ? " checked" : "");
+  }
+  printf("[DRAM] resident_pages=%llu (%llu KB of %llu MB)\n", // host memory actually committed
+         (unsigned long long)dram.resident_pages(),
+         (unsigned long long)(dram.resident_pages() * smem::Dram::kPageBytes >> 10),
+         (unsigned long long)(dram.get_size() >> 20));
+}
+
+// -profile: symbols + reports after the run
+static void report_profile(const PcProfile& prof, smem::MemoryPort& mem, const std::string& prog_path) {
+  std::string elf = std::string(profile_elf);
+  if (elf.empty() && prog_path.size() > 4 && prog_path.compare(prog_path.size() - 4, 4, ".bin") == 0) {
+    elf = prog_path.substr(0, prog_path.size() - 4) + ".elf";
+  }
+  std::vector<ElfSymbol> syms;
+  std::string err;
+  if (elf.empty()) {
+    printf("[PROF] no ELF for symbols (use -profile_elf)\n");
+  } else if (!load_elf_symbols(elf, &syms, &err)) {
+    printf("[PROF] no symbols: %s\n", err.c_str());
+  }
+  smile::print_profile(prof, syms, mem, static_cast<int>(profile_loops));
+  const std::string folded = std::string(profile_folded);
+  if (!folded.empty()) {
+    if (smile::write_folded_stacks(folded, prof, syms, &err)) {
+      printf("[PROF] collapsed stacks -> %s\n", folded.c_str());
+    } else {
+      printf("[PROF] %s\n", err.c_str());
+    }
+  }
+}
+
+static CheckpointRun checkpoint_run(const smile::DebuggerState& dbg) {
+  CheckpointRun run;
+  for (int t = 0; t < 2; ++t) run.threads[t] = dbg.threads[t];
+  run.current_thread = dbg.current_thread;
+  run.cycle = static_cast<uint64_t>(dbg.cycle);
+  return run;
+}
+
+// -checkpoint_at=<cycles|pc:ADDR>: run to the trigger, step on to a quiescent instruction
+// boundary (nothing in flight), write the checkpoint; returns the cycles used.
+static int run_to_checkpoint(smile::DebuggerState& dbg, const smem::Dram& dram,
+                             const std::string& at, const std::string& path, int max_cycles) {
+  const bool at_pc = at.rfind("pc:", 0) == 0;
+  uint64_t target = 0;
+  try {
+    target = std::stoull(at_pc ? at.substr(3) : at, nullptr, 0);
+  } catch (...) {
+    assert_always(false, "-checkpoint_at must be a cycle count or pc:ADDR");
+  }
+  Tile1& tile = dbg.tile;
+  const int start = dbg.cycle;
+  auto left = [&] { return max_cycles - (dbg.cycle - start); };
+  auto step = [&] { // one cycle; false once the run cannot continue
+    if (dbg.program_exited || left() <= 0) return false;
+    const int before = dbg.cycle;
+    smile::auto_run(dbg, 1);
+    return dbg.cycle != before;
+  };
+  bool reached = true;
+  if (at_pc) {
+    while (reached && !(tile.pc() == static_cast<uint32_t>(target) && tile.quiescent())) reached = step();
+  } else {
+    if (target > static_cast<uint64_t>(dbg.cycle)) {
+      smile::auto_run(dbg, static_cast<int>(std::min<uint64_t>(target - dbg.cycle, static_cast<uint64_t>(std::max(left(), 0)))));
+    }
+    reached = static_cast<uint64_t>(dbg.cycle) >= target;
+    while (reached && !tile.quiescent()) reached = step();
+  }
+  if (!reached || dbg.program_exited) {
+    printf("[CKPT] -checkpoint_at=%s not reached; no checkpoint written\n", at.c_str());
+    return dbg.cycle - start;
+  }
+  std::string err;
+  CheckpointInfo info;
+  if (!save_checkpoint(path, tile, dram, checkpoint_run(dbg), &err, &info)) {
+    printf("[CKPT] save failed: %s\n", err.c_str());
+  } else {
+    printf("[CKPT] wrote %s cycle=%d pc=0x%08x pages=%llu bytes=%llu\n", path.c_str(), dbg.cycle, tile.pc(),
+           (unsigned long long)info.pages, (unsigned long long)info.file_bytes);
+  }
+  return dbg.cycle - start;
+}
+
+// One cell of a selfcheck/sweep matrix: an injected suite or a flat program
+struct MatrixCase {
+  std::string accel;
+  std::string suite; // used when prog is empty
+  std::string prog;
+  int latency = 0;
+  int steps = 0;
+};
+
+// Fixed-size so a forked worker can hand it back through a pipe
+struct CaseResult {
+  bool     pass = false;
+  uint64_t cycles = 0;
+  uint64_t insts = 0;
+  uint32_t exit_code = 0;
+  double   wall_s = 0.0;
+  char     err[160] = {};
+};
+
+static void case_fail(CaseResult* r, const std::string& msg) {
+  r->pass = false;
+  snprintf(r->err, sizeof(r->err), "%s", msg.c_str());
+}
+
+// Build a private Tile1/Dram/accelerator set, run one case, and report (no printing)
+static void run_case(const MatrixCase& c, CaseResult* r) {
+  const auto t0 = std::chrono::steady_clock::now();
   Tile1 tile("tile1");
   smem::Dram dram("dram", 0);
+  assert_always(dram_mb > 0, "-dram_mb must be positive");
+  dram.set_size(static_cast<uint64_t>(dram_mb) << 20);
   smem::DramMemoryPort dram_port(dram);
-  smem::MemCtrlTimedPort memctrl(&dram_port, mem_lat);
+  smem::MemCtrlTimedPort memctrl(&dram_port, c.latency);
   tile.attach_memory(&memctrl);
 
   std::string err;
-  std::unique_ptr<AccelPort> accel_ptr = make_accel_for_flag(accel_flag, memctrl, err);
-  if (!err.empty()) {
-    printf("[SELF] FAIL accel=%s suite=%s lat=%d steps=%d err=%s\n",
-      accel_flag.c_str(), suite_flag.c_str(), mem_lat, steps_override, err.c_str());
-    return 1;
-  }
-  tile.attach_accelerator(accel_ptr.get());
+  std::unique_ptr<AccelPort> accel_ptr = make_accel_for_flag(c.accel, memctrl, err);
+  if (!err.empty()) return case_fail(r, err);
+  std::unique_ptr<AccelQueue> accel_q;
+  tile.attach_accelerator(decouple_accel(accel_ptr.get(), &accel_q));
 
   std::string mem_model_flag = to_lower_copy(std::string(mem_model));
   if (ideal_mem || mem_model_flag == "ideal") {
     tile.set_mem_model(Tile1::MemModel::Ideal);
+    tile.set_block_exec(block_exec);
   } else if (mem_model_flag == "timed") {
     tile.set_mem_model(Tile1::MemModel::Timed);
+    configure_timed(tile, memctrl);
   } else {
-    printf("[SELF] FAIL accel=%s suite=%s lat=%d steps=%d err=bad mem_model\n",
-      accel_flag.c_str(), suite_flag.c_str(), mem_lat, steps_override);
-    return 1;
+    return case_fail(r, "bad mem_model");
   }
+  configure_harts(tile);
+  configure_jit(tile);
+  std::unique_ptr<BranchPredictor> bp = make_branch_predictor();
+  tile.attach_branch_predictor(bp.get());
 
   dram.s_req.wireToZero();
   dram.s_resp.sendToBitBucket();
@@ -248,46 +671,160 @@ static int run_one_case(const std::string& accel_flag,
   Sim::reset();
 
   SuiteMeta suite_meta;
-  if (!inject_suite_program(dram_port, tile,
-                            static_cast<uint32_t>(load_addr),
-                            static_cast<uint32_t>(start_pc),
-                            suite_flag, suite_meta, err)) {
-    printf("[SELF] FAIL accel=%s suite=%s lat=%d steps=%d err=%s\n",
-      accel_flag.c_str(), suite_flag.c_str(), mem_lat, steps_override, err.c_str());
-    return 1;
+  if (!c.prog.empty()) {
+    if (!load_flat_bin(c.prog, &dram_port, static_cast<uint32_t>(load_addr))) return case_fail(r, "program load failed");
+    if (static_cast<uint32_t>(start_pc) != 0u) tile.set_pc(static_cast<uint32_t>(start_pc));
+  } else if (!inject_suite_program(dram_port, tile,
+                                   static_cast<uint32_t>(load_addr),
+                                   static_cast<uint32_t>(start_pc),
+                                   c.suite, suite_meta, err)) {
+    return case_fail(r, err);
   }
 
   int num_threads = static_cast<int>(sw_threads);
   if (num_threads < 1) num_threads = 1;
   if (num_threads > 2) num_threads = 2;
   smile::DebuggerState dbg(tile, dram_port, num_threads);
-  smile::auto_run(dbg, steps_override);
+  smile::auto_run(dbg, c.steps);
 
-  if (!dbg.program_exited) {
-    printf("[SELF] FAIL accel=%s suite=%s lat=%d steps=%d err=no program exit\n",
-      accel_flag.c_str(), suite_flag.c_str(), mem_lat, steps_override);
-    return 1;
-  }
+  r->cycles    = static_cast<uint64_t>(dbg.cycle);
+  r->insts     = tile.inst_count();
+  r->exit_code = tile.exit_code();
+  r->wall_s    = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  if (!dbg.program_exited) return case_fail(r, "no program exit");
+  char buf[160];
   if (suite_meta.twice) {
     const uint32_t got0 = dram_port.read32(0x00000100u);
     const uint32_t got1 = dram_port.read32(0x00000104u);
     if (got0 != suite_meta.expected_sum || got1 != suite_meta.expected_sum || tile.exit_code() != suite_meta.expected_exit) {
-      printf("[SELF] FAIL accel=%s suite=%s lat=%d steps=%d got0=0x%x got1=0x%x exit=0x%x exp=0x%x\n",
-        accel_flag.c_str(), suite_flag.c_str(), mem_lat, steps_override,
-        got0, got1, tile.exit_code(), suite_meta.expected_sum);
-      return 1;
+      snprintf(buf, sizeof(buf), "got0=0x%x got1=0x%x exit=0x%x exp=0x%x",
+               got0, got1, tile.exit_code(), suite_meta.expected_sum);
+      return case_fail(r, buf);
     }
-  } else {
-    const uint32_t got = tile.exit_code();
-    if (got != suite_meta.expected_exit) {
-      printf("[SELF] FAIL accel=%s suite=%s lat=%d steps=%d got=0x%x exp=0x%x\n",
-        accel_flag.c_str(), suite_flag.c_str(), mem_lat, steps_override, got, suite_meta.expected_exit);
-      return 1;
+  } else if (suite_meta.active && tile.exit_code() != suite_meta.expected_exit) {
+    snprintf(buf, sizeof(buf), "got=0x%x exp=0x%x", tile.exit_code(), suite_meta.expected_exit);
+    return case_fail(r, buf);
+  }
+  r->pass = true;
+}
+
+// Run every case in its own forked worker, at most `jobs` at a time.  Cascade's Sim is
+// process-global, so processes (not threads) are what keep instances isolated; a worker
+// that dies (e.g. assert_always) only fails its own case.
+static std::vector<CaseResult> run_matrix(const std::vector<MatrixCase>& cases, int jobs) {
+  std::vector<CaseResult> results(cases.size());
+  std::map<pid_t, std::pair<size_t, int>> running; // pid -> (case index, pipe read end)
+  size_t next = 0;
+  fflush(stdout);
+  while (next < cases.size() || !running.empty()) {
+    while (next < cases.size() && static_cast<int>(running.size()) < jobs) {
+      int fds[2];
+      assert_always(pipe(fds) == 0, "pipe() failed");
+      const pid_t pid = fork();
+      assert_always(pid >= 0, "fork() failed");
+      if (pid == 0) { // worker: quiet stdout, run, hand the result back
+        close(fds[0]);
+        if (FILE* null_out = freopen("/dev/null", "w", stdout)) (void)null_out;
+        CaseResult r;
+        run_case(cases[next], &r);
+        const ssize_t n = write(fds[1], &r, sizeof(r));
+        _exit(n == static_cast<ssize_t>(sizeof(r)) ? 0 : 1);
+      }
+      close(fds[1]);
+      running[pid] = {next++, fds[0]};
     }
+    int status = 0;
+    const pid_t pid = waitpid(-1, &status, 0);
+    auto it = running.find(pid);
+    if (it == running.end()) continue;
+    CaseResult& r = results[it->second.first];
+    if (read(it->second.second, &r, sizeof(r)) != static_cast<ssize_t>(sizeof(r))) {
+      r = CaseResult{};
+      case_fail(&r, WIFSIGNALED(status) ? "worker killed by signal " + std::to_string(WTERMSIG(status))
+                                        : "worker exited without a result");
+    }
+    close(it->second.second);
+    running.erase(it);
   }
-  printf("[SELF] PASS accel=%s suite=%s lat=%d steps=%d\n",
-    accel_flag.c_str(), suite_flag.c_str(), mem_lat, steps_override);
-  return 0;
+  return results;
+}
+
+static void print_case(const char* tag, const MatrixCase& c, const CaseResult& r) {
+  const std::string what = c.prog.empty() ? "suite=" + c.suite : "prog=" + c.prog;
+  const double kips = r.wall_s > 0.0 ? static_cast<double>(r.insts) / r.wall_s / 1e3 : 0.0;
+  printf("[%s] %s accel=%s %s lat=%d steps=%d cycles=%llu inst=%llu wall=%.3fs kips=%.1f%s%s\n",
+         tag, r.pass ? "PASS" : "FAIL", c.accel.c_str(), what.c_str(), c.latency, c.steps,
+         (unsigned long long)r.cycles, (unsigned long long)r.insts, r.wall_s, kips,
+         r.pass ? "" : " err=", r.pass ? "" : r.err);
+}
+
+// -report=<file>: .csv gets CSV, anything else JSON
+static bool write_report(const std::string& path, const std::vector<MatrixCase>& cases,
+                         const std::vector<CaseResult>& results) {
+  FILE* f = fopen(path.c_str(), "w");
+  if (!f) return false;
+  const bool csv = path.size() >= 4 && to_lower_copy(path.substr(path.size() - 4)) == ".csv";
+  auto json_str = [](const std::string& in) { // escape for a JSON string literal
+    std::string out;
+    for (char ch : in) {
+      if (ch == '"' || ch == '\\') out += '\\';
+      if (static_cast<unsigned char>(ch) >= 0x20) out += ch;
+    }
+    return out;
+  };
+  if (csv) fprintf(f, "accel,suite,prog,latency,steps,pass,exit_code,cycles,insts,wall_s,kips,err\n");
+  else     fprintf(f, "[\n");
+  for (size_t i = 0; i < cases.size(); ++i) {
+    const MatrixCase& c = cases[i];
+    const CaseResult& r = results[i];
+    const double kips = r.wall_s > 0.0 ? static_cast<double>(r.insts) / r.wall_s / 1e3 : 0.0;
+    if (csv) {
+      fprintf(f, "%s,%s,%s,%d,%d,%d,%u,%llu,%llu,%.6f,%.1f,\"%s\"\n",
+              c.accel.c_str(), c.suite.c_str(), c.prog.c_str(), c.latency, c.steps, r.pass ? 1 : 0,
+              r.exit_code, (unsigned long long)r.cycles, (unsigned long long)r.insts, r.wall_s, kips, r.err);
+    } else {
+      fprintf(f, "  {\"accel\": \"%s\", \"suite\": \"%s\", \"prog\": \"%s\", \"latency\": %d, \"steps\": %d, "
+                 "\"pass\": %s, \"exit_code\": %u, \"cycles\": %llu, \"insts\": %llu, \"wall_s\": %.6f, "
+                 "\"kips\": %.1f, \"err\": \"%s\"}%s\n",
+              json_str(c.accel).c_str(), json_str(c.suite).c_str(), json_str(c.prog).c_str(), c.latency, c.steps,
+              r.pass ? "true" : "false", r.exit_code, (unsigned long long)r.cycles, (unsigned long long)r.insts,
+              r.wall_s, kips, json_str(r.err).c_str(), i + 1 < cases.size() ? "," : "");
+    }
+  }
+  if (!csv) fprintf(f, "]\n");
+  fclose(f);
+  return true;
+}
+
+static std::vector<std::string> split_list(const std::string& text) { // "a,b,,c" -> {a,b,c}
+  std::vector<std::string> out;
+  std::stringstream ss(text);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) out.push_back(item);
+  }
+  return out;
+}
+
+// Run a matrix, print one line per case plus a summary, write -report; returns failures
+static int run_and_report(const char* tag, const std::vector<MatrixCase>& cases) {
+  int workers = static_cast<int>(jobs);
+  if (workers <= 0) workers = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+  if (workers < 1) workers = 1;
+  const auto t0 = std::chrono::steady_clock::now();
+  const std::vector<CaseResult> results = run_matrix(cases, workers);
+  const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  int failures = 0;
+  for (size_t i = 0; i < cases.size(); ++i) {
+    print_case(tag, cases[i], results[i]);
+    failures += results[i].pass ? 0 : 1;
+  }
+  const std::string report_path = std::string(report);
+  if (!report_path.empty() && !write_report(report_path, cases, results)) {
+    printf("[%s] cannot write report %s\n", tag, report_path.c_str());
+  }
+  printf("[%s] jobs=%d wall=%.3fs\n", tag, workers, wall);
+  return failures;
 }
 
 int main(int argc, char* argv[]) {
@@ -299,24 +836,15 @@ int main(int argc, char* argv[]) {
   Sim::parseDumps(argc, argv);
 
   if (selfcheck) {
-    struct SelfCase {
-      const char* accel;
-      const char* suite;
-      int latency;
-      int steps;
+    const std::vector<MatrixCase> cases = {
+      {"array_sum",    "proto_accel_sum",             "", 0,  200},
+      {"array_sum_mc", "proto_accel_sum",             "", 0,  400},
+      {"array_sum_mc", "proto_accel_sum",             "", 5,  600},
+      {"array_sum_mc", "proto_accel_sum_twice",       "", 5, 1000},
+      {"array_sum_mc", "proto_accel_sum_badarg",      "", 5,  300},
+      {"array_sum_mc", "proto_accel_sum_unsupported", "", 5,  300},
     };
-    const std::vector<SelfCase> cases = {
-      {"array_sum",    "proto_accel_sum",          0,  200},
-      {"array_sum_mc", "proto_accel_sum",          0,  400},
-      {"array_sum_mc", "proto_accel_sum",          5,  600},
-      {"array_sum_mc", "proto_accel_sum_twice",    5, 1000},
-      {"array_sum_mc", "proto_accel_sum_badarg",   5,  300},
-      {"array_sum_mc", "proto_accel_sum_unsupported", 5, 300},
-    };
-    int failures = 0;
-    for (const auto& c : cases) {
-      failures += run_one_case(c.accel, c.suite, c.latency, c.steps);
-    }
+    const int failures = run_and_report("SELF", cases);
     const int total = static_cast<int>(cases.size());
     if (failures == 0) {
       printf("[SELF] PASS %d/%d\n", total, total);
@@ -326,11 +854,35 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  if (!std::string(replay).empty()) return run_replay(std::string(replay)); // memory-only run, no Tile1
+
+  if (!std::string(sweep_progs).empty()) { // user-supplied matrix: progs x accels x latencies
+    assert_always(steps > 0, "-sweep_progs needs -steps>0 (per-case cycle budget)");
+    std::vector<std::string> accels = split_list(std::string(sweep_accel));
+    std::vector<std::string> lats   = split_list(std::string(sweep_lat));
+    if (accels.empty()) accels.push_back(std::string(accel));
+    if (lats.empty())   lats.push_back(std::to_string(static_cast<int>(mem_latency)));
+    std::vector<MatrixCase> cases;
+    for (const std::string& p : split_list(std::string(sweep_progs))) {
+      for (const std::string& a : accels) {
+        for (const std::string& l : lats) {
+          cases.push_back(MatrixCase{a, "", p, std::atoi(l.c_str()), static_cast<int>(steps)});
+        }
+      }
+    }
+    const int failures = run_and_report("SWEEP", cases);
+    printf("[SWEEP] %s %d/%d\n", failures == 0 ? "PASS" : "FAIL",
+           static_cast<int>(cases.size()) - failures, static_cast<int>(cases.size()));
+    return failures == 0 ? 0 : 1;
+  }
+
   // **************
   // Step 2: Create components
   // **************
   Tile1 tile("tile1");
   smem::Dram dram("dram", 0);
+  assert_always(dram_mb > 0, "-dram_mb must be positive");
+  dram.set_size(static_cast<uint64_t>(dram_mb) << 20);
   smem::DramMemoryPort dram_port(dram);
   smem::MemCtrlTimedPort memctrl(&dram_port, (int)mem_latency);
   tile.attach_memory(&memctrl);
@@ -350,16 +902,30 @@ int main(int argc, char* argv[]) {
   } else {
     assert_always(false, "accel must be 'none', 'demo_add', 'array_sum', or 'array_sum_mc'");
   }
-  tile.attach_accelerator(accel_ptr.get());
+  std::unique_ptr<AccelQueue> accel_q;
+  tile.attach_accelerator(decouple_accel(accel_ptr.get(), &accel_q));
   
   std::string mem_model_flag = std::string(mem_model);
   std::transform(mem_model_flag.begin(), mem_model_flag.end(), mem_model_flag.begin(), [](unsigned char c) { 
     return static_cast<char>(std::tolower(c)); });
   if (ideal_mem || mem_model_flag == "ideal") {
     tile.set_mem_model(Tile1::MemModel::Ideal);
+    tile.set_block_exec(block_exec);
   } else {
     assert_always(mem_model_flag == "timed", "mem_model must be 'timed' or 'ideal'");
     tile.set_mem_model(Tile1::MemModel::Timed);
+    configure_timed(tile, memctrl);
+  }
+  configure_harts(tile);
+  configure_jit(tile);
+  std::unique_ptr<BranchPredictor> bp = make_branch_predictor();
+  tile.attach_branch_predictor(bp.get());
+  const bool sampled = sample_period > 0; // sampled mode flips the model itself (ideal fast-forward, timed windows)
+  if (sampled) {
+    assert_always(tile.mem_model() == Tile1::MemModel::Timed, "-sample_period needs -mem_model=timed");
+    assert_always(steps > 0, "-sample_period needs -steps>0 (auto-run)");
+    assert_always(sample_warmup >= 0 && sample_window > 0, "-sample_warmup must be >=0 and -sample_window >0");
+    tile.set_block_exec(block_exec); // used during fast-forward
   }
   dram.s_req.wireToZero();
   dram.s_resp.sendToBitBucket();
@@ -391,8 +957,11 @@ int main(int argc, char* argv[]) {
   std::string suite_name;
   uint32_t suite_expected_exit = 0;
   uint32_t suite_expected_sum  = 0;
-  if (!prog_path.empty()) {
-    uint32_t nbytes = 0;
+  const std::string restore_path = std::string(restore);
+  uint32_t nbytes = 0; // program size, when it came from -prog
+  if (!restore_path.empty()) {
+    // state (memory, PC, registers, thread contexts) comes from the checkpoint in Step 6
+  } else if (!prog_path.empty()) {
     bool ok = load_flat_bin(prog_path, &dram_port, static_cast<uint32_t>(load_addr), &nbytes);
     assert_always(ok, "Program load failed");
     if (static_cast<uint32_t>(start_pc) != 0u) {
@@ -424,11 +993,68 @@ int main(int argc, char* argv[]) {
   if (num_threads < 1) num_threads = 1;
   if (num_threads > 2) num_threads = 2;
   smile::DebuggerState dbg(tile, dram_port, num_threads); 
-  if (max_cycles > 0) {
-    smile::auto_run(dbg, max_cycles);
+  if (!restore_path.empty()) {
+    CheckpointRun run;
+    CheckpointInfo info;
+    std::string err;
+    if (!restore_checkpoint(restore_path, tile, dram, &run, &err, &info)) {
+      printf("[CKPT] restore failed: %s\n", err.c_str());
+      return 1;
+    }
+    for (int t = 0; t < 2; ++t) dbg.threads[t] = run.threads[t];
+    dbg.current_thread = run.current_thread;
+    dbg.cycle = static_cast<int>(run.cycle);
+    dbg.mem_direct.reset(); // DRAM pages were replaced
+    printf("[CKPT] restored %s cycle=%llu pc=0x%08x pages=%llu\n", restore_path.c_str(),
+           (unsigned long long)run.cycle, tile.pc(), (unsigned long long)info.pages);
+  }
+  PcProfile prof;
+  if (profile) {
+    prof.configure(static_cast<uint32_t>(load_addr), nbytes ? nbytes : static_cast<uint32_t>(profile_bytes));
+    tile.attach_profiler(&prof);
+  }
+  smem::MemTraceWriter trace_writer;
+  const std::string trace_path = std::string(trace_out);
+  if (!trace_path.empty()) {
+    std::string err;
+    assert_always(trace_writer.open(trace_path, &err), "-trace_out: cannot open trace file");
+    tile.attach_trace_writer(&trace_writer);
+  }
+  CpiSeries cpi_series;
+  if (cpi_interval > 0) {
+    std::string err;
+    if (!cpi_series.open(std::string(cpi_csv), static_cast<uint64_t>(cpi_interval), tile, &err)) {
+      printf("[CPI] %s\n", err.c_str());
+      return 1;
+    }
+    tile.attach_cpi_series(&cpi_series);
+  }
+  int ckpt_cycles = 0; // cycles spent reaching -checkpoint_at (part of the -steps budget)
+  const std::string ckpt_at = std::string(checkpoint_at);
+  if (!ckpt_at.empty()) {
+    assert_always(max_cycles > 0 && !sampled, "-checkpoint_at needs -steps>0 and no -sample_period");
+    ckpt_cycles = run_to_checkpoint(dbg, dram, ckpt_at, std::string(checkpoint), max_cycles);
+  }
+  const auto run_t0 = std::chrono::steady_clock::now();
+  if (max_cycles > 0 && sampled) {
+    smile::SampleConfig cfg;
+    cfg.period = static_cast<uint64_t>(sample_period);
+    cfg.warmup = static_cast<uint64_t>(sample_warmup);
+    cfg.window = static_cast<uint64_t>(sample_window);
+    const smile::SampleReport rep = smile::run_sampled(dbg, max_cycles, cfg);
+    smile::print_sample_report(cfg, rep); // [STATS] cycles below mix ideal and timed cycles
+  } else if (max_cycles > 0) {
+    smile::auto_run(dbg, max_cycles - ckpt_cycles);
   } else {
     smile::run_debugger(dbg, ignore_bpfile);
   }
+  const double run_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - run_t0).count();
+  if (cpi_series.is_open()) {
+    cpi_series.finish(tile);
+    tile.attach_cpi_series(nullptr);
+    printf("[CPI] %llu rows of %d cycles -> %s\n", (unsigned long long)cpi_series.rows(),
+           static_cast<int>(cpi_interval), std::string(cpi_csv).c_str());
+  }
 
   // **************
   // Step 7A: Sim stop on exit() via ecall 93
@@ -454,16 +1080,11 @@ int main(int argc, char* argv[]) {
       assert_always(ctx.regs[0] == 0, "x0 must remain zero");
     }
     printf("[EXIT] Program exited with code %u\n", tile.exit_code());
-    printf("[STATS] cycles=%llu inst=%llu alu=%llu add=%llu mul=%llu loads=%llu stores=%llu branches=%llu taken=%llu\n",
-           (unsigned long long)dbg.cycle,
-           (unsigned long long)tile.inst_count(),
-           (unsigned long long)tile.arith_count(),
-           (unsigned long long)tile.add_count(),
-           (unsigned long long)tile.mul_count(),
-           (unsigned long long)tile.load_count(),
-           (unsigned long long)tile.store_count(),
-           (unsigned long long)tile.branch_count(),
-           (unsigned long long)tile.branch_taken_count());
+    print_stats(dbg, tile, dram);
+    if (const smem::DramTiming* dt = memctrl.dram_timing()) dt->print_stats(memctrl.cycles());
+    if (trace_writer.is_open()) report_trace(trace_writer);
+    if (profile) report_profile(prof, dram_port, prog_path);
+    if (bench) report_bench(tile, run_wall);
     return 0;
   }
 
@@ -475,16 +1096,11 @@ int main(int argc, char* argv[]) {
   // Step 7B (non-exit): Print stats even if the program did not call exit(93)
   // (e.g., smurf stops via breakpoint/trap and is validated by postmortem checks).
   // **************
-  printf("[STATS] cycles=%llu inst=%llu alu=%llu add=%llu mul=%llu loads=%llu stores=%llu branches=%llu taken=%llu\n",
-         (unsigned long long)dbg.cycle,
-         (unsigned long long)tile.inst_count(),
-         (unsigned long long)tile.arith_count(),
-         (unsigned long long)tile.add_count(),
-         (unsigned long long)tile.mul_count(),
-         (unsigned long long)tile.load_count(),
-         (unsigned long long)tile.store_count(),
-         (unsigned long long)tile.branch_count(),
-         (unsigned long long)tile.branch_taken_count());
+  print_stats(dbg, tile, dram);
+  if (const smem::DramTiming* dt = memctrl.dram_timing()) dt->print_stats(memctrl.cycles());
+  if (trace_writer.is_open()) report_trace(trace_writer);
+  if (profile) report_profile(prof, dram_port, prog_path);
+  if (bench) report_bench(tile, run_wall);
 
   // **************
   // Step 7C: Sim stop NOT on exit(): post-mortem sanity check
@@ -0,0 +1,249 @@
+// **********************************************************************
+// smile/src/util/Checkpoint.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+/*
+File layout (all integers little-endian):
+  "SMILECK1" | u32 version
+  core:   pc, x0..x31, mstatus, mtvec, mepc, mcause, priv, trap_pending, pending_trap,
+          pc_override_pending, pc_override_value, halted, exited, exit_code (u32 each),
+          9 x u64 counters, u64 cycles, 3 x u64 stall cycles (fetch, dmem, accel),
+          10 x u64 CPI stack cycles (Tile1::CpiSlot order),
+          31 x u64 counter CSR offsets, 29 x u32 mhpmevent selectors,
+          u32 ncsrs, ncsrs x (u32 addr, u32 value)
+  run:    2 x (u32 pc, 32 x u32 regs, u32 active), i32 current_thread, u64 cycle
+  dram:   u64 size, u64 page_bytes, u64 npages,
+          npages x (u64 page_idx, u32 clen, clen bytes)   clen == page_bytes => stored raw
+*/
+#include "Checkpoint.hpp"
+#include "smem/Dram.hpp"
+
+#include <zlib.h>
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char     kMagic[8] = {'S', 'M', 'I', 'L', 'E', 'C', 'K', '1'};
+constexpr uint32_t kVersion  = 4; // 2: counter CSR state, 3: SIMD counter, 4: CPI stack
+
+bool fail(std::string* err, const std::string& msg) {
+  if (err) *err = msg;
+  return false;
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t v) {
+  for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+void put64(std::vector<uint8_t>& out, uint64_t v) {
+  for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+// Bounds-checked little-endian reader over the mapped file
+struct Cursor {
+  const uint8_t* p;
+  const uint8_t* end;
+  bool ok = true;
+  uint32_t get32() {
+    if (end - p < 4) { ok = false; return 0; }
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    p += 4;
+    return v;
+  }
+  uint64_t get64() {
+    const uint64_t lo = get32();
+    const uint64_t hi = get32();
+    return lo | (hi << 32);
+  }
+  const uint8_t* take(uint64_t n) {
+    if (static_cast<uint64_t>(end - p) < n) { ok = false; return nullptr; }
+    const uint8_t* at = p;
+    p += n;
+    return at;
+  }
+};
+
+bool all_zero(const uint8_t* p, uint64_t n) {
+  return p[0] == 0 && std::memcmp(p, p + 1, n - 1) == 0;
+}
+
+// Read-only mapping of a whole file, unmapped on scope exit
+struct MappedFile {
+  int fd = -1;
+  void* base = MAP_FAILED;
+  size_t size = 0;
+  ~MappedFile() {
+    if (base != MAP_FAILED) munmap(base, size);
+    if (fd >= 0) close(fd);
+  }
+};
+
+} // namespace
+
+bool save_checkpoint(const std::string& path, const Tile1& tile, const smem::Dram& dram,
+                     const CheckpointRun& run, std::string* err, CheckpointInfo* info) {
+  if (!tile.quiescent()) return fail(err, "tile has a request in flight");
+  const Tile1::ArchState s = tile.save_arch_state();
+
+  std::vector<uint8_t> out(kMagic, kMagic + sizeof(kMagic));
+  put32(out, kVersion);
+  // core
+  put32(out, s.pc);
+  for (uint32_t r : s.regs) put32(out, r);
+  put32(out, s.mstatus);
+  put32(out, s.mtvec);
+  put32(out, s.mepc);
+  put32(out, s.mcause);
+  put32(out, static_cast<uint32_t>(s.priv));
+  put32(out, s.trap_pending);
+  put32(out, static_cast<uint32_t>(s.pending_trap));
+  put32(out, s.pc_override_pending);
+  put32(out, s.pc_override_value);
+  put32(out, s.halted);
+  put32(out, s.exited);
+  put32(out, s.exit_code);
+  for (uint64_t c : s.counters) put64(out, c);
+  put64(out, s.cycles);
+  for (uint64_t c : s.stalls) put64(out, c);
+  for (uint64_t c : s.cpi) put64(out, c);
+  for (uint64_t o : s.counter_offset) put64(out, o);
+  for (uint32_t e : s.hpm_event) put32(out, e);
+  put32(out, static_cast<uint32_t>(s.csrs.size()));
+  for (const auto& kv : s.csrs) { put32(out, kv.first); put32(out, kv.second); }
+  // run
+  for (const ThreadContext& t : run.threads) {
+    put32(out, t.pc);
+    for (uint32_t r : t.regs) put32(out, r);
+    put32(out, t.active);
+  }
+  put32(out, static_cast<uint32_t>(run.current_thread));
+  put64(out, run.cycle);
+  // dram: only pages that were ever written and are not all zero (absent pages read zero)
+  const uint64_t page_bytes = smem::Dram::kPageBytes;
+  const uint64_t npages_total = dram.get_size() / page_bytes;
+  put64(out, dram.get_size());
+  put64(out, page_bytes);
+  const size_t npages_at = out.size();
+  put64(out, 0); // patched below
+  uint64_t npages = 0;
+  std::vector<uint8_t> zbuf(compressBound(page_bytes));
+  for (uint64_t idx = 0; idx < npages_total; ++idx) {
+    const uint8_t* page = dram.page_data(idx);
+    if (!page || all_zero(page, page_bytes)) continue;
+    uLongf clen = static_cast<uLongf>(zbuf.size());
+    const bool packed = compress2(zbuf.data(), &clen, page, page_bytes, Z_BEST_SPEED) == Z_OK && clen < page_bytes;
+    put64(out, idx);
+    if (packed) {
+      put32(out, static_cast<uint32_t>(clen));
+      out.insert(out.end(), zbuf.data(), zbuf.data() + clen);
+    } else {
+      put32(out, static_cast<uint32_t>(page_bytes));
+      out.insert(out.end(), page, page + page_bytes);
+    }
+    ++npages;
+  }
+  for (int i = 0; i < 8; ++i) out[npages_at + i] = static_cast<uint8_t>(npages >> (8 * i));
+
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  if (!f) return fail(err, "cannot open " + path + " for writing");
+  f.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+  if (!f) return fail(err, "write to " + path + " failed");
+  if (info) {
+    info->pages = npages;
+    info->file_bytes = out.size();
+  }
+  return true;
+}
+
+bool restore_checkpoint(const std::string& path, Tile1& tile, smem::Dram& dram,
+                        CheckpointRun* run, std::string* err, CheckpointInfo* info) {
+  MappedFile m;
+  m.fd = open(path.c_str(), O_RDONLY);
+  if (m.fd < 0) return fail(err, "cannot open " + path);
+  struct stat st;
+  if (fstat(m.fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(kMagic) + 4)) return fail(err, path + " is too short");
+  m.size = static_cast<size_t>(st.st_size);
+  m.base = mmap(nullptr, m.size, PROT_READ, MAP_PRIVATE, m.fd, 0);
+  if (m.base == MAP_FAILED) return fail(err, "cannot mmap " + path);
+
+  Cursor c{static_cast<const uint8_t*>(m.base), static_cast<const uint8_t*>(m.base) + m.size};
+  if (std::memcmp(c.take(sizeof(kMagic)), kMagic, sizeof(kMagic)) != 0) return fail(err, path + " is not a smile checkpoint");
+  if (c.get32() != kVersion) return fail(err, path + ": unsupported checkpoint version");
+
+  // core
+  Tile1::ArchState s;
+  s.pc = c.get32();
+  for (uint32_t& r : s.regs) r = c.get32();
+  s.mstatus = c.get32();
+  s.mtvec   = c.get32();
+  s.mepc    = c.get32();
+  s.mcause  = c.get32();
+  s.priv                = static_cast<Tile1::PrivMode>(c.get32());
+  s.trap_pending        = c.get32() != 0;
+  s.pending_trap        = static_cast<Tile1::TrapCause>(c.get32());
+  s.pc_override_pending = c.get32() != 0;
+  s.pc_override_value   = c.get32();
+  s.halted    = c.get32() != 0;
+  s.exited    = c.get32() != 0;
+  s.exit_code = c.get32();
+  for (uint64_t& cnt : s.counters) cnt = c.get64();
+  s.cycles = c.get64();
+  for (uint64_t& cnt : s.stalls) cnt = c.get64();
+  for (uint64_t& cnt : s.cpi) cnt = c.get64();
+  for (uint64_t& o : s.counter_offset) o = c.get64();
+  for (uint32_t& e : s.hpm_event) e = c.get32();
+  const uint32_t ncsrs = c.get32();
+  for (uint32_t i = 0; i < ncsrs && c.ok; ++i) {
+    const uint32_t addr = c.get32();
+    s.csrs.emplace_back(addr, c.get32());
+  }
+  // run
+  CheckpointRun r;
+  for (ThreadContext& t : r.threads) {
+    t.pc = c.get32();
+    for (uint32_t& reg : t.regs) reg = c.get32();
+    t.active = c.get32() != 0;
+  }
+  r.current_thread = static_cast<int32_t>(c.get32());
+  r.cycle = c.get64();
+  // dram
+  const uint64_t size       = c.get64();
+  const uint64_t page_bytes = c.get64();
+  const uint64_t npages     = c.get64();
+  if (!c.ok) return fail(err, path + " is truncated");
+  if (page_bytes != smem::Dram::kPageBytes || size == 0 || size % page_bytes != 0) {
+    return fail(err, path + ": DRAM geometry does not match this build");
+  }
+  dram.set_size(size);
+  for (uint64_t i = 0; i < npages; ++i) {
+    const uint64_t idx  = c.get64();
+    const uint32_t clen = c.get32();
+    const uint8_t* src  = c.take(clen);
+    if (!c.ok || idx >= size / page_bytes) return fail(err, path + ": bad DRAM page record");
+    uint8_t* dst = dram.page_for_write(idx);
+    if (clen == page_bytes) {
+      std::memcpy(dst, src, page_bytes);
+    } else {
+      uLongf dlen = static_cast<uLongf>(page_bytes);
+      if (uncompress(dst, &dlen, src, clen) != Z_OK || dlen != page_bytes) {
+        return fail(err, path + ": corrupt DRAM page");
+      }
+    }
+  }
+
+  tile.load_arch_state(s);
+  if (run) *run = r;
+  if (info) {
+    info->pages = npages;
+    info->file_bytes = m.size;
+  }
+  return true;
+}
@@ -0,0 +1,37 @@
+// **********************************************************************
+// smile/src/util/Checkpoint.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Tile1.hpp"
+
+namespace smem { class Dram; }
+
+/*
+On-disk checkpoint of a Tile1 run: Tile1::ArchState, the driver's thread contexts
+and cycle count, and the non-zero DRAM pages (each zlib-compressed on its own).
+- Take it at a quiescent point (Tile1::quiescent()); in-flight requests are not saved.
+- Restore mmaps the file and inflates each page straight into Dram's page table;
+  the DRAM window is resized to the checkpoint's, dropping whatever was there.
+- Both return false (and set *err) on I/O or format problems.
+*/
+struct CheckpointRun {        // driver-side state saved alongside the tile
+  ThreadContext threads[2];
+  int32_t  current_thread = 0;
+  uint64_t cycle          = 0;
+};
+
+struct CheckpointInfo {       // what went into / came out of the file
+  uint64_t pages      = 0;    // DRAM pages stored
+  uint64_t file_bytes = 0;
+};
+
+bool save_checkpoint(const std::string& path, const Tile1& tile, const smem::Dram& dram,
+                     const CheckpointRun& run, std::string* err = nullptr, CheckpointInfo* info = nullptr);
+bool restore_checkpoint(const std::string& path, Tile1& tile, smem::Dram& dram,
+                        CheckpointRun* run, std::string* err = nullptr, CheckpointInfo* info = nullptr);
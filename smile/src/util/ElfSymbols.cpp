@@ -0,0 +1,90 @@
+// **********************************************************************
+// smile/src/util/ElfSymbols.cpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+
+#include "ElfSymbols.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+constexpr uint32_t kShtSymtab = 2;
+constexpr uint8_t  kSttFunc   = 2;
+
+bool fail(std::string* err, const std::string& msg) {
+  if (err) *err = msg;
+  return false;
+}
+
+uint16_t get16(const std::vector<uint8_t>& b, size_t at) {
+  return static_cast<uint16_t>(b[at] | (b[at + 1] << 8));
+}
+uint32_t get32(const std::vector<uint8_t>& b, size_t at) {
+  return static_cast<uint32_t>(b[at]) | (static_cast<uint32_t>(b[at + 1]) << 8) |
+         (static_cast<uint32_t>(b[at + 2]) << 16) | (static_cast<uint32_t>(b[at + 3]) << 24);
+}
+
+} // namespace
+
+bool load_elf_symbols(const std::string& path, std::vector<ElfSymbol>* out, std::string* err) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) return fail(err, "cannot open " + path);
+  const std::vector<uint8_t> b((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+  if (b.size() < 52 || std::memcmp(b.data(), "\x7f" "ELF", 4) != 0) return fail(err, path + " is not an ELF file");
+  if (b[4] != 1 || b[5] != 1) return fail(err, path + " is not 32-bit little-endian");
+
+  const uint32_t shoff     = get32(b, 0x20);
+  const uint16_t shentsize = get16(b, 0x2e);
+  const uint16_t shnum     = get16(b, 0x30);
+  if (shentsize < 40 || static_cast<uint64_t>(shoff) + static_cast<uint64_t>(shnum) * shentsize > b.size()) {
+    return fail(err, path + ": bad section header table");
+  }
+  auto section = [&](uint32_t idx) { return static_cast<size_t>(shoff) + static_cast<size_t>(idx) * shentsize; };
+
+  out->clear();
+  bool have_symtab = false;
+  for (uint32_t s = 0; s < shnum; ++s) {
+    const size_t sh = section(s);
+    if (get32(b, sh + 4) != kShtSymtab) continue;
+    const uint32_t off  = get32(b, sh + 16);
+    const uint32_t size = get32(b, sh + 20);
+    const uint32_t link = get32(b, sh + 24); // string table section
+    if (link >= shnum || static_cast<uint64_t>(off) + size > b.size()) return fail(err, path + ": bad symbol table");
+    const size_t   strsh  = section(link);
+    const uint32_t stroff = get32(b, strsh + 16);
+    const uint32_t strsz  = get32(b, strsh + 20);
+    if (static_cast<uint64_t>(stroff) + strsz > b.size()) return fail(err, path + ": bad string table");
+    have_symtab = true;
+    for (uint32_t e = off; e + 16 <= off + size; e += 16) {
+      const uint32_t name  = get32(b, e);
+      const uint32_t value = get32(b, e + 4);
+      const uint32_t sz    = get32(b, e + 8);
+      const uint8_t  info  = b[e + 12];
+      if ((info & 0xf) != kSttFunc || name >= strsz) continue;
+      const char* str = reinterpret_cast<const char*>(b.data() + stroff + name);
+      out->push_back(ElfSymbol{value, sz, std::string(str, strnlen(str, strsz - name))});
+    }
+  }
+  if (!have_symtab) return fail(err, path + " has no symbol table (stripped?)");
+
+  std::sort(out->begin(), out->end(), [](const ElfSymbol& a, const ElfSymbol& b) { return a.addr < b.addr; });
+  out->erase(std::unique(out->begin(), out->end(), [](const ElfSymbol& a, const ElfSymbol& b) { return a.addr == b.addr; }),
+             out->end());
+  for (size_t i = 0; i < out->size(); ++i) {
+    ElfSymbol& s = (*out)[i];
+    if (s.size == 0 && i + 1 < out->size()) s.size = (*out)[i + 1].addr - s.addr;
+  }
+  return true;
+}
+
+const ElfSymbol* find_elf_symbol(const std::vector<ElfSymbol>& syms, uint32_t addr) {
+  auto it = std::upper_bound(syms.begin(), syms.end(), addr,
+                             [](uint32_t a, const ElfSymbol& s) { return a < s.addr; });
+  if (it == syms.begin()) return nullptr;
+  --it;
+  return (addr - it->addr < it->size) ? &*it : nullptr;
+}
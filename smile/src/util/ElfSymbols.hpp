@@ -0,0 +1,27 @@
+// **********************************************************************
+// smile/src/util/ElfSymbols.hpp
+// **********************************************************************
+// Sebastian Claudiusz Magierowski Oct 16 2026
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ElfSymbol {
+  uint32_t    addr = 0;
+  uint32_t    size = 0; // bytes; zero-sized functions are stretched to the next symbol
+  std::string name;
+};
+
+/*
+Read the function symbols (STT_FUNC) of a 32-bit little-endian ELF, i.e. the
+.elf that smile_progs leaves next to each flat .bin.
+- Returned sorted by address, duplicates (aliases) dropped.
+- Returns false (and sets *err) if the file is missing or not an ELF32 LE with a symbol table.
+*/
+bool load_elf_symbols(const std::string& path, std::vector<ElfSymbol>* out, std::string* err = nullptr);
+
+// Symbol containing addr, or nullptr
+const ElfSymbol* find_elf_symbol(const std::vector<ElfSymbol>& syms, uint32_t addr);
@@ -5,7 +5,9 @@
 
 #include "FlatBinLoader.hpp"
 #include "smem/MemoryPort.hpp"
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
@@ -25,6 +27,17 @@ bool load_flat_bin(const std::string& path, smem::MemoryPort* mem, uint32_t base
   uint32_t addr = base_addr;
   size_t i = 0;
 
+  // Fast path: copy whole words straight into direct regions the port grants
+  // (MemoryPort::get_direct); the word loop below finishes whatever is left.
+  smem::DirectRegion region;
+  while (i + 4 <= buf.size() && mem->get_direct(addr, &region, true) && region.host && region.covers(addr, 4u)) {
+    const size_t room = static_cast<size_t>(region.hi - addr) + 1u;
+    const size_t n = std::min(room, buf.size() - i) & ~static_cast<size_t>(3u);
+    std::memcpy(region.host + (addr - region.lo), buf.data() + i, n);
+    i += n;
+    addr += static_cast<uint32_t>(n);
+  }
+
   // Pack 4B chunks into one 32b littl-endian word (lowest byte in LSB), then writes to mem
   for (; i + 4 <= buf.size(); i += 4, addr += 4) {
     uint32_t w =  (uint32_t)buf[i]
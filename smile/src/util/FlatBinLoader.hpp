@@ -11,7 +11,8 @@
 namespace smem { class MemoryPort; }
 
 /*
-Load a flat little-endian binary into memory via MemoryPort::write32().
+Load a flat little-endian binary into memory via MemoryPort::write32(), copying whole
+chunks instead wherever the port grants a direct region (MemoryPort::get_direct).
 - Pads the tail with zeros to a full 32-bit word (so no byte writes needed).
 - Returns true on success; optionally writes the number of file bytes loaded.
 */